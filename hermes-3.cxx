@@ -29,6 +29,7 @@
 #include "include/amjuel_hyd_ionisation.hxx"
 #include "include/amjuel_hyd_recombination.hxx"
 #include "include/anomalous_diffusion.hxx"
+#include "include/balance_diagnostics.hxx"
 #include "include/classical_diffusion.hxx"
 #include "include/binormal_stpm.hxx"
 #include "include/collisions.hxx"
@@ -57,6 +58,8 @@
 #include "include/quasineutral.hxx"
 #include "include/recycling.hxx"
 #include "include/relax_potential.hxx"
+#include "include/restart_interpolation.hxx"
+#include "include/running_statistics.hxx"
 #include "include/scale_timederivs.hxx"
 #include "include/set_temperature.hxx"
 #include "include/sheath_boundary.hxx"
@@ -77,8 +80,13 @@
 #include <bout/boundary_factory.hxx>
 #include <bout/boundary_op.hxx>
 #include <bout/field_factory.hxx>
+#include <bout/options_netcdf.hxx>
 
+#include <algorithm>
+
+#include "include/async_writer.hxx"
 #include "include/loadmetric.hxx"
+#include "include/output_precision.hxx"
 
 class DecayLengthBoundary : public BoundaryOp {
 public:
@@ -245,15 +253,114 @@ int Hermes::init(bool restarting) {
   // Preconditioner
   setPrecon((preconfunc)&Hermes::precon);
 
+  // Steady-state convergence monitoring
+  steady_state_tolerance =
+      options["steady_state_tolerance"]
+          .doc("Stop when all residuals fall by this factor. <= 0 means off")
+          .withDefault(-1.0);
+  ser = options["ser"]
+            .doc("Increase scale_timederivs as residuals fall (switched evolution "
+                 "relaxation)?")
+            .withDefault<bool>(false);
+  ser_max = options["ser_max"].doc("Maximum SER pseudo-time factor").withDefault(1e4);
+  pseudo_time_factor = 1.0;
+  last_residual = -1.0;
+  if (ser and !scheduler->hasComponentType("scale_timederivs")) {
+    throw BoutException("ser = true requires a scale_timederivs component");
+  }
+
+  lazy_diagnostics =
+      options["lazy_diagnostics"]
+          .doc("Only calculate diagnostics when the model is evaluated for output?")
+          .withDefault<bool>(false);
+  output_step = false;
+
+  output_relative_error =
+      options["output_relative_error"]
+          .doc("Round time-dependent output fields to this relative error. 0 means "
+               "full precision. Restart files are always full precision.")
+          .withDefault(0.0);
+
+  if (options["async_output"]
+          .doc("Write output files in a background thread? Requires [output] "
+               "enabled = false")
+          .withDefault<bool>(false)) {
+    if (Options::root()["output"]["enabled"].withDefault<bool>(true)) {
+      throw BoutException("async_output requires BOUT++ output to be disabled: "
+                          "Set enabled = false in the [output] section");
+    }
+    const auto max_queue = options["async_output_queue"]
+                               .doc("Maximum number of outputs waiting to be written")
+                               .withDefault<int>(2);
+    const auto datadir = Options::root()["datadir"].withDefault<std::string>("data");
+    async_writer = std::make_unique<AsyncWriter>(
+        fmt::format("{}/BOUT.dmp.{}.nc", datadir, BoutComm::rank()),
+        Options::root()["append"].withDefault<bool>(false),
+        static_cast<std::size_t>(std::max(max_queue, 1)));
+  }
+
+  // Start from restart files on a different mesh
+  const auto interpolate_from = options["restart_interpolate_from"]
+                                    .doc("Directory containing restart files to "
+                                         "interpolate onto this mesh. Ignored if restarting")
+                                    .withDefault<std::string>("");
+  if (!interpolate_from.empty() and !restarting) {
+    Options interpolated = interpolateRestart(interpolate_from, mesh);
+    // Components which save their own state, e.g. potential, read it here.
+    // Only fields are used: Time stamps in the old files are not valid
+    scheduler->loadState(interpolatedState(interpolated));
+    solver->readEvolvingVariablesFromOptions(interpolated);
+  }
+  if (restarting) {
+    // Restore internal state saved by restartVars. The restart file is
+    // read here, so this does not depend on when BOUT++ calls restartVars
+    const auto datadir = Options::root()["datadir"].withDefault<std::string>("data");
+    const auto restartdir = Options::root()["restartdir"].withDefault<std::string>(datadir);
+    loadState(bout::OptionsNetCDF(
+                  fmt::format("{}/BOUT.restart.{}.nc", restartdir, BoutComm::rank()))
+                  .read());
+  }
+
   return 0;
 }
 
+void Hermes::loadState(const Options& restart) {
+  scheduler->loadState(restart);
+
+  if (!(restart.isSection("state") and restart["state"].isSection("hermes"))) {
+    return; // Older restart file
+  }
+  const Options& hermes_state = restart["state"]["hermes"];
+  if (hermes_state.isSet("pseudo_time_factor")) {
+    pseudo_time_factor = hermes_state["pseudo_time_factor"].as<BoutReal>();
+    last_residual = hermes_state["last_residual"].as<BoutReal>();
+  }
+  if (hermes_state.isSection("initial_residual")) {
+    for (const auto& kv : hermes_state["initial_residual"].getChildren()) {
+      initial_residuals[kv.first] = kv.second.as<BoutReal>();
+    }
+  }
+  if (hermes_state.isSet("last_timestep")) {
+    last_timestep = hermes_state["last_timestep"].as<BoutReal>();
+    output_info.write("Last internal timestep before restart: {:e}. Set "
+                      "solver:start_timestep to start at this timestep\n",
+                      last_timestep);
+  }
+}
+
 int Hermes::rhs(BoutReal time) {
   // Need to reset the state, since fields may be modified in transform steps
   state = Options();
   
   set(state["time"], time);
   state["units"] = units; 
+  if (ser) {
+    set(state["pseudo_time_factor"], pseudo_time_factor);
+  }
+  if (lazy_diagnostics) {
+    // Components only calculate diagnostics if this is true
+    set(state["output_step"], output_step);
+  }
 
   // Call all the components
   scheduler->transform(state);
@@ -275,9 +382,88 @@ int Hermes::precon(BoutReal t, BoutReal gamma, BoutReal UNUSED(delta)) {
   return 0;
 }
 
+void Hermes::updateResiduals() {
+  // Time derivatives from the last call to rhs.
+  // Divide by the scaling to get the residual of the steady-state equations
+  Options ddts;
+  scheduler->timeDerivs(ddts);
+
+  BoutReal total_residual_sq = 0.0;
+  BoutReal max_relative = 0.0;
+  bool have_residuals = false;
+  std::string message;
+  for (const auto& kv : ddts.getChildren()) {
+    Field3D residual = getNonFinal<Field3D>(kv.second);
+    if (!residual.isAllocated()) {
+      continue; // Model not evaluated yet
+    }
+    if (state.isSet("scale_timederivs")) {
+      residual /= getNonFinal<Field3D>(state["scale_timederivs"]);
+    }
+    const BoutReal norm = sqrt(mean(SQ(residual), true, "RGN_NOBNDRY"));
+
+    residual_norms[kv.first] = norm;
+    total_residual_sq += SQ(norm);
+    have_residuals = true;
+
+    // Residual relative to the first output
+    auto initial = initial_residuals.emplace(kv.first, norm).first->second;
+    if (initial > 0.0) {
+      max_relative = std::max(max_relative, norm / initial);
+    }
+    message += fmt::format(" {}: {:e}", kv.first, norm);
+  }
+  if (!have_residuals) {
+    return;
+  }
+  output_info.write("Residuals:{}\n", message);
+
+  const BoutReal total_residual = sqrt(total_residual_sq);
+  if (ser and (last_residual > 0.0) and (total_residual > 0.0)) {
+    // Switched evolution relaxation: Pseudo-timestep grows as the residual falls
+    pseudo_time_factor = std::min(
+        ser_max, std::max(1.0, pseudo_time_factor * last_residual / total_residual));
+    output_info.write("Pseudo-time factor: {:e}\n", pseudo_time_factor);
+  }
+  last_residual = total_residual;
+
+  if ((steady_state_tolerance > 0.0) and (max_relative < steady_state_tolerance)) {
+    output_progress.write("Converged to steady state: Residuals reduced by {:e}\n",
+                          max_relative);
+    steady_state_converged = true;
+  }
+}
+
+int Hermes::outputMonitor(BoutReal UNUSED(simtime), int UNUSED(iter), int UNUSED(NOUT)) {
+  // Residuals were calculated in outputVars, before being written
+  return steady_state_converged ? 1 : 0; // Stop the simulation if converged
+}
+
+int Hermes::timestepMonitor(BoutReal simtime, BoutReal dt) {
+  last_timestep = dt;
+  // The last evaluation may be from a solver iteration, so the accepted
+  // state is passed to components in the next evaluation at simtime
+  scheduler->timestepAccepted(simtime);
+  return 0;
+}
+
 void Hermes::outputVars(Options& options) {
   AUTO_TRACE();
 
+  // State from the solver's last evaluation, restored after output
+  Options solver_state;
+  if (lazy_diagnostics) {
+    // Diagnostics were skipped in the internal timesteps. Evaluate the
+    // model again, at the output time, so that they are calculated.
+    const BoutReal time = options.isSet("t_array") ? options["t_array"].as<BoutReal>()
+                          : state.isSet("time")    ? getNonFinal<BoutReal>(state["time"])
+                                                   : 0.0;
+    solver_state = std::move(state);
+    output_step = true;
+    rhs(time);
+    output_step = false;
+  }
+
   // Save the Hermes version in the output dump files
   options["HERMES_REVISION"].force(hermes::version::revision);
 
@@ -322,12 +508,69 @@ void Hermes::outputVars(Options& options) {
       {"standard_name", "length normalisation"},
       {"long_name", "Gyro-radius length normalisation"}
     });
+
+  if (ser or (steady_state_tolerance > 0.0)) {
+    // Calculate residuals now, so that they are written with this output
+    updateResiduals();
+  }
+  for (const auto& kv : residual_norms.getChildren()) {
+    set_with_attrs(options[std::string("residual_") + kv.first], kv.second.as<BoutReal>(),
+                   {{"time_dimension", "t"},
+                    {"long_name", kv.first + " RMS steady-state residual"},
+                    {"source", "hermes"}});
+  }
+  if (ser) {
+    set_with_attrs(options["pseudo_time_factor"], pseudo_time_factor,
+                   {{"time_dimension", "t"},
+                    {"long_name", "SER factor applied to scale_timederivs"},
+                    {"source", "hermes"}});
+  }
   scheduler->outputVars(options);
+
+  // Reduce the precision of output fields so that they compress better.
+  // Precision can be set for each variable with "precision" or
+  // "relative_error" attributes.
+  reduceOutputPrecision(options, output_relative_error);
+
+  if (async_writer) {
+    // Copy and write in the background, rather than by BOUT++
+    async_writer->push(options);
+  }
+
+  if (lazy_diagnostics) {
+    // Used in precon and timestepMonitor, so should not be the output state
+    state = std::move(solver_state);
+  }
 }
 
 void Hermes::restartVars(Options& options) {
   AUTO_TRACE();
 
+  if (async_writer) {
+    // The restart file is written after this returns. Only one file
+    // can be written at a time, so finish writing previous outputs.
+    async_writer->wait();
+  }
+
+  // Internal state needed to continue exactly
+  Options& hermes_state = options["state"]["hermes"];
+  if (ser) {
+    set_with_attrs(hermes_state["pseudo_time_factor"], pseudo_time_factor,
+                   {{"long_name", "SER pseudo-time factor"}, {"source", "hermes"}});
+    set_with_attrs(hermes_state["last_residual"], last_residual,
+                   {{"long_name", "Total residual at the last output"},
+                    {"source", "hermes"}});
+  }
+  for (const auto& kv : initial_residuals) {
+    set_with_attrs(hermes_state["initial_residual"][kv.first], kv.second,
+                   {{"long_name", kv.first + " residual at the first output"},
+                    {"source", "hermes"}});
+  }
+  if (last_timestep > 0.0) {
+    set_with_attrs(hermes_state["last_timestep"], last_timestep,
+                   {{"long_name", "Last internal timestep"}, {"source", "hermes"}});
+  }
+
   set_with_attrs(options["Tnorm"], Tnorm, {
       {"units", "eV"},
       {"conversion", 1}, // Already in SI units
@@ -365,6 +608,7 @@ void Hermes::restartVars(Options& options) {
       {"long_name", "Gyro-radius length normalisation"}
     });
   scheduler->restartVars(options);
+  scheduler->saveState(options);
 }
 
 // Standard main() function
@@ -26,6 +26,10 @@ class Hermes;
 
 #include <bout/physicsmodel.hxx>
 
+#include <map>
+#include <string>
+
+#include "include/async_writer.hxx"
 #include "include/component_scheduler.hxx"
 
 class Hermes : public PhysicsModel {
@@ -36,12 +40,22 @@ protected:
   int rhs(BoutReal t) override;
   int precon(BoutReal t, BoutReal gamma, BoutReal delta);
 
+  /// Monitor convergence to steady state. Returns non-zero
+  /// to stop the simulation once converged.
+  int outputMonitor(BoutReal simtime, int iter, int NOUT) override;
+
+  /// Record the internal timestep, so that it can be saved in restart
+  /// files, and tell the components that a step has been accepted.
+  /// Only called if solver:monitor_timestep = true
+  int timestepMonitor(BoutReal simtime, BoutReal dt) override;
+
   /// Add variables to be written to the output file
   ///
   /// Adds units and then calls each component in turn
   void outputVars(Options& options) override;
 
-  /// Add variables to restart file
+  /// Add variables to restart file, including the internal state
+  /// of Hermes and the components in the "state" section
   void restartVars(Options& options) override;
 private:
   /// Organises and schedules model components
@@ -57,6 +71,36 @@ private:
   BoutReal Tnorm, Nnorm, Bnorm;
   /// Derived normalisation constants
   BoutReal Cs0, Omega_ci, rho_s0;
+
+  /// Steady-state convergence
+  BoutReal steady_state_tolerance; ///< Stop when residuals fall by this factor. <= 0 -> off
+  bool ser; ///< Switched evolution relaxation of the pseudo-time factor?
+  BoutReal ser_max; ///< Maximum pseudo-time factor
+  BoutReal pseudo_time_factor; ///< Passed to scale_timederivs if ser is true
+  BoutReal last_residual; ///< Total residual at previous output. < 0 if not set
+  std::map<std::string, BoutReal> initial_residuals; ///< Residual norms at first output
+  Options residual_norms; ///< Residual norms at the last output, for writing
+  bool steady_state_converged{false}; ///< Residuals below steady_state_tolerance?
+
+  /// Calculate the residuals from the last call to rhs, and update
+  /// the SER pseudo-time factor. Called before the residuals are written.
+  void updateResiduals();
+
+  /// Restore internal state of Hermes and the components, saved
+  /// by restartVars. Called in init when restarting
+  void loadState(const Options& restart);
+
+  /// Only calculate diagnostics when evaluating the model for output?
+  bool lazy_diagnostics;
+  bool output_step; ///< Is the model being evaluated for output?
+
+  /// Default relative error of time-dependent output fields. 0 -> full precision
+  BoutReal output_relative_error;
+
+  /// Writes the output file in a background thread. nullptr if not used
+  std::unique_ptr<AsyncWriter> async_writer;
+
+  BoutReal last_timestep{-1.0}; ///< Last internal timestep. < 0 if not known
 };
 
 
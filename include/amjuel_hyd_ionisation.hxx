@@ -37,7 +37,7 @@ struct AmjuelHydIonisationIsotope : public AmjuelHydIonisation {
     calculate_rates(electron, atom, ion, reaction_rate, momentum_exchange,
                     energy_exchange, energy_loss);
 
-    if (diagnose) {
+    if (diagnose and isOutputStep(state)) {
       S = reaction_rate;
       F = momentum_exchange;
       E = energy_exchange;
@@ -39,7 +39,7 @@ struct AmjuelHydRecombinationIsotope : public AmjuelHydRecombination {
     calculate_rates(electron, atom, ion, reaction_rate, momentum_exchange,
                     energy_exchange, energy_loss);
 
-    if (diagnose) {
+    if (diagnose and isOutputStep(state)) {
       S = -reaction_rate;
       F = -momentum_exchange;
       E = -energy_exchange;
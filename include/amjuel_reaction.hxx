@@ -12,11 +12,15 @@ struct AmjuelReaction : public Component {
     Tnorm = get<BoutReal>(units["eV"]);
     Nnorm = get<BoutReal>(units["inv_meters_cubed"]);
     FreqNorm = 1. / get<BoutReal>(units["seconds"]);
+
+    precon_coupling = alloptions["hermes"]["block_precon"].withDefault<bool>(false);
   }
 
 protected:
   BoutReal Tnorm, Nnorm, FreqNorm; // Normalisations
 
+  bool precon_coupling; ///< Set density couplings for the block preconditioner?
+
   BoutReal clip(BoutReal value, BoutReal min, BoutReal max) {
     if (value < min)
       return min;
@@ -90,18 +94,36 @@ protected:
     const BoutReal to_charge =
         to_ion.isSet("charge") ? get<BoutReal>(to_ion["charge"]) : 0.0;
 
-    reaction_rate = cellAverage(
+    // Reaction rate and electron energy loss (radiation, ionisation potential)
+    // evaluated together, since they have the same inputs
+    auto rates = cellAverageMultiple(
         [&](BoutReal ne, BoutReal n1, BoutReal te) {
-          return ne * n1 * evaluate(rate_coefs, te * Tnorm, ne * Nnorm) * Nnorm
-                 / FreqNorm;
+          const BoutReal nn = ne * n1 * Nnorm / FreqNorm;
+          return std::array<BoutReal, 2>{
+              nn * evaluate(rate_coefs, te * Tnorm, ne * Nnorm),
+              nn * evaluate(radiation_coefs, te * Tnorm, ne * Nnorm) / Tnorm};
         },
         Ne.getRegion("RGN_NOBNDRY"))(Ne, N1, Te);
 
+    reaction_rate = rates[0];
+
     // Particles
     // For ionisation, "from_ion" is the neutral and "to_ion" is the ion
     subtract(from_ion["density_source"], reaction_rate);
     add(to_ion["density_source"], reaction_rate);
 
+    if (precon_coupling) {
+      // Reaction rate is proportional to the density of from_ion
+      const Field3D rate_per_N1 = reaction_rate / floor(N1, 1e-5);
+      const std::string from_name = from_ion.name();
+      addPreconCoupling(from_ion, "density_source", from_name, -rate_per_N1);
+      addPreconCoupling(to_ion, "density_source", from_name, rate_per_N1);
+      if (from_charge != to_charge) {
+        addPreconCoupling(electron, "density_source", from_name,
+                          (to_charge - from_charge) * rate_per_N1);
+      }
+    }
+
     if (from_charge != to_charge) {
       // To ensure quasineutrality, add electron density source
       add(electron["density_source"], (to_charge - from_charge) * reaction_rate);
@@ -152,12 +174,7 @@ protected:
     add(to_ion["energy_source"], energy_exchange);
 
     // Electron energy loss (radiation, ionisation potential)
-    energy_loss = cellAverage(
-        [&](BoutReal ne, BoutReal n1, BoutReal te) {
-          return ne * n1 * evaluate(radiation_coefs, te * Tnorm, ne * Nnorm) * Nnorm
-                 / (Tnorm * FreqNorm);
-        },
-        Ne.getRegion("RGN_NOBNDRY"))(Ne, N1, Te);
+    energy_loss = rates[1];
 
     // Loss is reduced by heating
     energy_loss -= (electron_heating / Tnorm) * reaction_rate;
@@ -0,0 +1,84 @@
+#pragma once
+#ifndef ASYNC_WRITER_H
+#define ASYNC_WRITER_H
+
+#include <bout/options.hxx>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/// Return a copy of \p options in which fields and arrays do not share
+/// data with the original, so that the original can be modified
+/// while the copy is being written.
+Options deepCopy(const Options& options);
+
+/// Writes snapshots of Options to a NetCDF file in a background thread,
+/// so that the simulation can continue while the file is written.
+///
+/// Snapshots are queued by push(). If max_queue snapshots are already
+/// waiting then push() blocks until one has been written.
+///
+/// The NetCDF library is not thread safe, so no other files may be
+/// written while snapshots are being written. Call wait() before
+/// writing other files.
+///
+/// Snapshots are destroyed in the calling thread rather than the
+/// writer thread, because BOUT++ arrays are returned to a store
+/// which is not shared between threads.
+///
+/// An exception thrown while writing is rethrown by the next call
+/// to push() or wait().
+class AsyncWriter {
+public:
+  /// @param filename   The file to write
+  /// @param append     Append to an existing file?
+  /// @param max_queue  Maximum number of snapshots waiting to be written
+  AsyncWriter(std::string filename, bool append, std::size_t max_queue);
+
+  /// Waits until any remaining snapshots are written, then stops the
+  /// writer thread. An exception from the writer thread can't be
+  /// rethrown here, so is printed to output_error. Call wait() first
+  /// to handle errors.
+  ~AsyncWriter();
+
+  AsyncWriter(const AsyncWriter&) = delete;
+  AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+  /// Queue a copy of \p options to be written.
+  /// Variables with a "time_dimension" attribute are appended
+  /// along the "t" dimension.
+  void push(const Options& options);
+
+  /// Wait until all queued snapshots have been written
+  void wait();
+
+private:
+  void run(); ///< Writer thread
+
+  /// Destroy snapshots which have been written. Must hold the lock
+  void removeWritten();
+
+  /// Rethrow an exception from the writer thread. Must hold the lock
+  void checkError();
+
+  std::string filename;
+  bool append;
+  std::size_t max_queue;
+
+  std::deque<Options> queue; ///< Snapshots. The first `written` have been written
+  std::size_t written{0};    ///< Number of snapshots at the front which are done
+  bool stop{false};          ///< Set to stop the writer thread
+  std::exception_ptr error;  ///< Exception thrown in the writer thread
+
+  std::mutex mutex;
+  std::condition_variable changed; ///< Notified when the queue changes
+
+  std::thread thread; ///< Started last, after the other members
+};
+
+#endif // ASYNC_WRITER_H
@@ -0,0 +1,86 @@
+#pragma once
+#ifndef BALANCE_DIAGNOSTICS_H
+#define BALANCE_DIAGNOSTICS_H
+
+#include "component.hxx"
+#include "wall_boundary.hxx"
+
+#include <string>
+#include <vector>
+
+/// Integrated particle and power balance diagnostics
+///
+/// Calculates volume integrals of particle and energy sources, and
+/// flows through the target and wall boundaries, for each species.
+/// Only scalar time series are saved, rather than 3D fields.
+///
+/// This should be after all components which set sources and flows,
+/// for example at the end of the list of components:
+///
+///     [hermes]
+///     components = ..., recycling, balance
+///
+///     [balance]
+///     type = balance_diagnostics
+///     species = d+, e   # Default is all species
+///
+/// Outputs, in particles per second and Watts. <region> is one of
+/// lower_target, upper_target, sol, pfr
+///  - S<species>_int, E<species>_int  Volume integral of density_source
+///                                    and energy_source
+///  - S<species>_<region>_int, E<species>_<region>_int
+///                                    Integral of the sources in the cells
+///                                    next to the boundary. These include
+///                                    sheath, recycling and wall sources.
+///  - F<species>_<target>             Particle flow into the target, from
+///                                    the density and velocity at the sheath
+///  - Q<species>_<target>             Energy flow into the target, if
+///                                    energy_flow_ylow is set. The sheath
+///                                    components add their heat flows.
+///  - F<species>_<wall>, Q<species>_<wall>
+///                                    Particle and energy flows into the SOL
+///                                    and PFR walls, if particle_flow_xlow
+///                                    and energy_flow_xlow are set.
+///
+/// The integrals are calculated in every evaluation of the model,
+/// unless [hermes] lazy_diagnostics = true. The sums over processors
+/// are only done when the outputs are written.
+struct BalanceDiagnostics : public Component {
+  /// Inputs
+  ///  - <name>
+  ///    - species   Comma-separated list of species. Default is all species
+  BalanceDiagnostics(std::string name, Options& alloptions, Solver*);
+
+  /// Inputs
+  ///  - species
+  ///    - <species>
+  ///      - density_source  [Optional]
+  ///      - energy_source   [Optional]
+  ///      - density, velocity  [Optional] Used to calculate target flows
+  ///      - energy_flow_ylow  [Optional] Used to calculate target energy flows
+  ///      - particle_flow_xlow, energy_flow_xlow  [Optional] Radial flows
+  void transform(Options& state) override;
+
+  void outputVars(Options& state) override;
+
+private:
+  std::vector<std::string> species_list; ///< Species to integrate. Empty means all
+
+  WallBoundary wall; ///< Target and wall boundary cells
+  Field2D cell_volume; ///< J * dx * dy * dz
+
+  /// A quantity integrated over all processors
+  struct Integral {
+    std::string name;      ///< Output variable name
+    std::string long_name; ///< Description
+    bool energy;           ///< Power (W) rather than particles (s^-1)?
+    BoutReal value;        ///< Normalised value on this processor
+  };
+  std::vector<Integral> integrals;
+};
+
+namespace {
+RegisterComponent<BalanceDiagnostics> registercomponentbalancediagnostics("balance_diagnostics");
+}
+
+#endif // BALANCE_DIAGNOSTICS_H
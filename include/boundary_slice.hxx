@@ -0,0 +1,79 @@
+#pragma once
+#ifndef BOUNDARY_SLICE_H
+#define BOUNDARY_SLICE_H
+
+#include <bout/field3d.hxx>
+
+#include <string>
+#include <vector>
+
+/// Values of a field in the y planes either side of the sheath (Y)
+/// boundaries, in field-aligned coordinates.
+///
+/// Sheath boundary conditions only use the last two cells in the
+/// domain and the first guard cell at each target. Rather than
+/// shifting whole fields with toFieldAligned and fromFieldAligned,
+/// only the planes y = ystart-1 ... ystart+1 and y = yend-1 ... yend+1
+/// at target boundaries are shifted, and stored in a compact array.
+///
+/// Values are indexed with the same Ind3D indices as a Field3D,
+/// but only cells in these planes can be accessed.
+///
+/// Example
+///
+///     const Field3D N = getNoBoundary<Field3D>(species["density"]);
+///     BoundarySlice Nslice(N);
+///     ...
+///     Nslice[i.ym()] = Nslice[i];  // Set guard cell in aligned coordinates
+///     ...
+///     setBoundary(species["density"], Nslice.scatter(N));
+///
+class BoundarySlice {
+public:
+  /// A slice with all values set to \p value
+  explicit BoundarySlice(BoutReal value = 0.0);
+
+  /// Copy the boundary planes of \p f, shifting them to
+  /// field-aligned coordinates if \p f is not already field aligned
+  explicit BoundarySlice(const Field3D& f);
+
+  BoutReal& operator[](const Ind3D& i) { return data[offset(i)]; }
+  const BoutReal& operator[](const Ind3D& i) const { return data[offset(i)]; }
+
+  /// Position of cell \p i in the slice. All slices on the same mesh
+  /// have the same layout, so a position can be used to index several
+  /// slices without repeating the index calculation.
+  int position(const Ind3D& i) const { return offset(i); }
+
+  BoutReal& operator[](int pos) { return data[pos]; }
+  const BoutReal& operator[](int pos) const { return data[pos]; }
+
+  /// Return a copy of \p f with the boundary planes replaced by the
+  /// values in this slice, shifted back to the y direction of \p f
+  Field3D scatter(const Field3D& f) const;
+
+  /// Name of the Region<Ind2D> containing the boundary planes on \p mesh.
+  /// The region is created the first time this is called.
+  static std::string region(Mesh* mesh);
+
+private:
+  BoundarySlice(Mesh* mesh, BoutReal value);
+
+  Mesh* localmesh;
+  int nz;          ///< Number of z points
+  int ystart;      ///< First cell in the domain
+  int upper_first; ///< First y index stored for the upper boundary
+  int nplanes;     ///< Number of y planes stored
+
+  std::vector<BoutReal> data; ///< Values, ordered (x, plane, z)
+
+  /// Index into data of the first z point in plane (x, y)
+  int offset(int x, int y) const {
+    const int plane = (y <= ystart + 1) ? y - ystart + 1 : 3 + y - upper_first;
+    ASSERT2(plane >= 0 and plane < nplanes);
+    return (x * nplanes + plane) * nz;
+  }
+  int offset(const Ind3D& i) const { return offset(i.x(), i.y()) + i.z(); }
+};
+
+#endif // BOUNDARY_SLICE_H
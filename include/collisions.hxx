@@ -4,6 +4,11 @@
 
 #include <bout/field3d.hxx>
 
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
 #include "component.hxx"
 
 /// Calculates the collision rate of each species
@@ -37,6 +42,13 @@ struct Collisions : public Component {
   ///
   ///   - frictional_heating    Include R dot v heating term as energy source? (includes Ohmic heating)
   ///
+  /// Pairwise collision frequencies are only kept if they are needed:
+  ///
+  ///   - diagnose        Save all pairwise frequencies for output?
+  ///   - pairwise_rates  Comma-separated list of pairs "species1:species2"
+  ///                     whose frequencies are put into the state as
+  ///                     species1["collision_frequencies"][species2]
+  ///
   Collisions(std::string name, Options& alloptions, Solver*);
 
   void transform(Options &state) override;
@@ -57,12 +69,45 @@ private:
   /// Include frictional heating term?
   bool frictional_heating;
 
-  /// Calculated collision rates saved for post-processing and use by other components
-  /// Saved in options, the BOUT++ dictionary-like object
+  /// Calculated collision rates saved for post-processing
+  /// Saved in options, the BOUT++ dictionary-like object.
+  /// Only filled if diagnose is true
   Options collision_rates;
 
   /// Save more diagnostics?
   bool diagnose;
+  /// Store collision rates in this evaluation? False if diagnose is
+  /// false, or this is not an output step (see isOutputStep)
+  bool diagnose_now{false};
+
+  /// Set energy exchange couplings for the scheduler block preconditioner?
+  bool precon_coupling;
+
+  /// Pairs (species1, species2) whose collision frequency nu_12
+  /// is set in the state for use by other components
+  std::set<std::pair<std::string, std::string>> pairwise_rates;
+
+  /// Store nu_12, the frequency of collisions of species1 with species2,
+  /// if it is needed for diagnostics or by other components
+  void storeRate(Options& species1, const Options& species2, const Field3D& nu_12);
+
+  /// Is the frequency of collisions of species1 with species2 needed?
+  bool needRate(const Options& species1, const Options& species2) const;
+
+  /// Collision frequency, momentum and energy exchange of one species,
+  /// summed over all collision pairs. Fields are unallocated until used.
+  struct CollisionSources {
+    Field3D collision_frequency;
+    Field3D momentum_source;
+    Field3D energy_source;
+    /// Derivative of energy_source with respect to the temperature
+    /// of each species. Only calculated if precon_coupling is true
+    std::map<std::string, Field3D> energy_coupling;
+  };
+
+  /// Sources for each species, accumulated by collide() and then
+  /// added to the species state at the end of transform()
+  std::map<std::string, CollisionSources> sources;
 
   /// Update collision frequencies, momentum and energy exchange
   /// nu_12    normalised frequency
@@ -9,9 +9,25 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 class Solver; // Time integrator
 
+/// An evolving variable whose time derivative is modified by
+/// a species source (e.g. "density_source" or "energy_source").
+/// Used by the scheduler to precondition local couplings between species.
+///
+/// The source is assumed to depend on a species quantity:
+///  - "density_source" depends on "density"
+///  - "energy_source"  depends on "temperature"
+struct PreconVariable {
+  std::string species;  ///< Species name e.g. "d+"
+  std::string source;   ///< The source which appears in the time derivative
+  Field3D* ddt;         ///< Time derivative, modified in place
+  Field3D dsource;      ///< Change in time derivative per unit source
+  Field3D dquantity;    ///< Change in quantity per unit change in the variable
+};
+
 /// Interface for a component of a simulation model
 /// 
 /// The constructor of derived types should have signature
@@ -34,8 +50,34 @@ struct Component {
   /// Add extra fields to restart files
   virtual void restartVars(Options &UNUSED(state)) { }
 
+  /// Save internal state which is not evolved by the solver
+  /// (e.g. controller integrals) to restart files, so that restarted
+  /// simulations continue as if they had not stopped.
+  /// Values should be saved in the section restart["state"][name].
+  virtual void saveState(Options &UNUSED(restart)) { }
+
+  /// Restore internal state saved by saveState(). Called once
+  /// when restarting, before the first evaluation.
+  virtual void loadState(const Options &UNUSED(restart)) { }
+
   /// Preconditioning
   virtual void precon(const Options &UNUSED(state), BoutReal UNUSED(gamma)) { }
+
+  /// Called after finally(), when the model is evaluated with the
+  /// solution of an internal timestep accepted by the solver. Only
+  /// called for explicit one-step solvers (see
+  /// ComponentScheduler::timestepAccepted), and if
+  /// solver:monitor_timestep = true
+  virtual void timestepAccepted(const Options &UNUSED(state)) { }
+
+  /// Add the time derivatives of evolving variables, keyed by
+  /// variable name. Used to monitor convergence to steady state
+  virtual void timeDerivs(Options &UNUSED(ddts)) { }
+
+  /// Add evolving variables which are coupled to other species
+  /// through sources. Used by the scheduler block preconditioner.
+  virtual void preconVariables(const Options &UNUSED(state),
+                               std::vector<PreconVariable> &UNUSED(variables)) { }
   
   /// Create a Component
   ///
@@ -155,6 +197,15 @@ bool isSetFinalNoBoundary(const Options& option, const std::string& location = "
   isSetFinalNoBoundary(option)
 #endif
 
+/// Should diagnostics be calculated in this evaluation of the model?
+///
+/// If the [hermes] option lazy_diagnostics is true then "output_step"
+/// is set to false in the state, except when the model is evaluated
+/// for writing output. Components can then skip calculating fields
+/// which are only used in outputVars().
+/// Returns true if "output_step" is not set.
+bool isOutputStep(const Options& state);
+
 #if CHECKLEVEL >= 1
 /// A wrapper around get<>() which captures debugging information
 ///
@@ -313,6 +364,20 @@ Options& subtract(Options& option, T value) {
   }
 }
 
+/// Add a local coupling between species, used by the scheduler
+/// block preconditioner.
+///
+/// @param species      The species whose source depends on another species
+/// @param source       The source, e.g. "density_source" or "energy_source"
+/// @param other        Name of the species whose quantity the source depends on
+/// @param coefficient  Derivative of the source with respect to the quantity
+///                     (density for density_source, temperature for energy_source)
+template<typename T>
+Options& addPreconCoupling(Options& species, const std::string& source,
+                           const std::string& other, T coefficient) {
+  return add(species["precon_coupling"][source][other], coefficient);
+}
+
 template<typename T>
 void set_with_attrs(Options& option, T value, std::initializer_list<std::pair<std::string, Options::AttributeType>> attrs) {
   option.force(value);
@@ -24,6 +24,16 @@ public:
   ///  @param scheduler_options  Configuration of the scheduler
   ///                            Should contain "components", a comma-separated
   ///                            list of component names
+  ///     - block_precon = false  Precondition local couplings between species?
+  ///     - slow_components = ""  Comma-separated names of components which
+  ///                             are only re-evaluated every slow_timestep
+  ///     - slow_timestep = 0     Time between evaluations of slow components
+  ///                             [normalised time units]
+  ///                             Note: Between evaluations the slow components'
+  ///                             changes to the state are frozen, so the RHS is
+  ///                             not smooth in time and depends on the
+  ///                             evaluation history. This can slow or break
+  ///                             convergence of implicit solvers (CVODE, JFNK).
   ///
   ///  @param component_options  Configuration of the components.
   ///     - <name>
@@ -43,21 +53,84 @@ public:
   /// Run the scheduler, modifying the state.
   /// This calls all components' transform() methods, then
   /// all component's finally() methods.
+  ///
+  /// Slow components are only evaluated if the time has advanced by
+  /// at least slow_timestep since their last evaluation. Otherwise the
+  /// changes which they made to the state in their last transform()
+  /// are applied again: Increments to sources, flows and couplings are
+  /// added, and other changed values are set. The finally() methods of
+  /// all components are called every time.
+  /// Slow components are always evaluated if "output_step" is set
+  /// to true in the state.
   void transform(Options &state);
 
   /// Add metadata, extra outputs. This would typically
   /// be called only for writing to disk, rather than every internal
   /// timestep.
+  ///
+  /// If transform() was called with "output_step" set to true, the
+  /// components' internal state (see saveState) and the slow component
+  /// state are then restored to what they were before that call.
   void outputVars(Options &state);
 
   /// Add variables to restart files
   void restartVars(Options &state);
 
+  /// Save components' internal state to restart files
+  void saveState(Options &restart);
+
+  /// Restore components' internal state from restart files
+  void loadState(const Options &restart);
+
+  /// Collect the time derivatives of all evolving variables
+  void timeDerivs(Options &ddts);
+
+  /// Record that an internal timestep ending at \p time has been
+  /// accepted by the solver. Components' timestepAccepted() methods
+  /// are called in the next transform() if it is at this time, since
+  /// the last state may be from a solver iteration rather than the
+  /// accepted solution. Otherwise the step is skipped, so this only
+  /// works with solvers which evaluate the accepted solution at the
+  /// start of the next step (explicit one-step methods).
+  void timestepAccepted(BoutReal time);
+
   /// Preconditioning
+  /// This calls all components' precon() methods, then
+  /// if enabled inverts the local couplings between species
   void precon(const Options &state, BoutReal gamma);
+
+  /// Is there a component of the given type?
+  bool hasComponentType(const std::string &type) const;
 private:
   /// The components to be executed in order
   std::vector<std::unique_ptr<Component>> components;
+  /// The type of each component. Same order as components
+  std::vector<std::string> types;
+
+  /// Is each component slow? Same order as components
+  std::vector<bool> slow;
+  /// Changes to the state made by each slow component in its last transform()
+  std::vector<Options> slow_changes;
+  BoutReal slow_timestep; ///< Time between evaluations of slow components
+  BoutReal slow_last_time; ///< Time of the last evaluation of slow components
+  bool slow_evaluated; ///< Have slow components been evaluated?
+
+  bool block_precon; ///< Precondition couplings between species?
+
+  bool accepted_pending{false}; ///< Call timestepAccepted in transform at accepted_time?
+  BoutReal accepted_time{0.0}; ///< Time of the last accepted timestep
+
+  /// State before the first transform() with output_step set, restored in outputVars
+  bool output_state_saved{false};
+  Options output_state;
+  std::vector<Options> output_slow_changes;
+  BoutReal output_slow_last_time{0.0};
+  bool output_slow_evaluated{false};
+
+  /// In each cell, solve (I - gamma * J) x = ddt for the variables
+  /// coupled by each source. J is assembled from the couplings
+  /// added to the state with addPreconCoupling
+  void blockPrecon(const Options &state, BoutReal gamma);
 };
 
 #endif // COMPONENT_SCHEDULER_H
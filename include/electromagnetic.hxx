@@ -3,8 +3,10 @@
 #define ELECTROMAGNETIC_H
 
 #include "component.hxx"
+#include "laplacian_coefficient.hxx"
 
 class Laplacian;
+class LaplaceXY;
 
 /// Electromagnetic potential A||
 ///
@@ -34,6 +36,13 @@ struct Electromagnetic : public Component {
   /// - units
   /// - <name>
   ///   - diagnose   Saves Ajpar and alpha_em time-dependent values
+  ///   - coefficient_tolerance  0 to only update the Apar solver coefficient
+  ///                            if alpha_em changes. Default < 0, always
+  ///                            update since alpha_em usually changes.
+  ///   - apar_warm_start  Use the previous Apar as initial guess? Default true
+  ///   - split_n0         Solve the n=0 part of Apar with LaplaceXY? Default false
+  ///   - laplacian        Options for the X-Z Apar solver e.g. maxits
+  ///   - laplacexy        Options for the n=0 solver, if split_n0
   ///
   Electromagnetic(std::string name, Options &options, Solver *solver);
 
@@ -63,6 +72,13 @@ private:
   BoutReal beta_em; // Normalisation coefficient mu_0 e T n / B^2
 
   std::unique_ptr<Laplacian> aparSolver; // Laplacian solver in X-Z
+  LaplacianCoefficient<Field3D> aparCoefA; ///< Last coefficient set in aparSolver
+
+  bool apar_warm_start; ///< Use the previous Apar as initial guess?
+
+  bool split_n0; ///< Split Apar into n=0 and n!=0 components
+  LaplaceXY* laplacexy; ///< Laplacian solver in X-Y (n=0)
+  LaplacianCoefficient<Field2D> aparCoefA_n0; ///< Last coefficient set in laplacexy
 
   bool diagnose; ///< Output additional diagnostics?
 };
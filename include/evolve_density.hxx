@@ -57,6 +57,14 @@ struct EvolveDensity : public Component {
   void finally(const Options &state) override;
 
   void outputVars(Options &state) override;
+
+  /// Time derivatives for convergence monitoring
+  void timeDerivs(Options &ddts) override;
+
+  /// Add density to the scheduler block preconditioner,
+  /// coupled to other species through density_source
+  void preconVariables(const Options& state,
+                       std::vector<PreconVariable>& variables) override;
 private:
   std::string name;     ///< Short name of species e.g "e"
 
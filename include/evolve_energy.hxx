@@ -69,10 +69,18 @@ struct EvolveEnergy : public Component {
 
   void outputVars(Options& state) override;
 
+  /// Time derivatives for convergence monitoring
+  void timeDerivs(Options& ddts) override;
+
   /// Preconditioner
   ///
   void precon(const Options& UNUSED(state), BoutReal gamma) override;
 
+  /// Add energy to the scheduler block preconditioner,
+  /// coupled to other species through energy_source
+  void preconVariables(const Options& state,
+                       std::vector<PreconVariable>& variables) override;
+
 private:
   std::string name; ///< Short name of the species e.g. h+
 
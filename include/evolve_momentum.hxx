@@ -6,6 +6,17 @@
 
 /// Evolve parallel momentum
 struct EvolveMomentum : public Component {
+  /// Options
+  ///
+  /// - <name>
+  ///   - bndry_flux           Allow flows through radial boundaries? Default is true
+  ///   - density_floor        Minimum density floor. Default 1e-5 normalised units.
+  ///   - diagnose             Output additional diagnostic fields?
+  ///   - hyper_z              Hyper-diffusion in Z
+  ///   - poloidal_flows       Include poloidal ExB flows? Default is true
+  ///   - precondition         Enable preconditioner? Default is false. Note: solver
+  ///   may not use it even if enabled.
+  ///
   EvolveMomentum(std::string name, Options &options, Solver *solver);
 
   /// This sets in the state
@@ -31,6 +42,22 @@ struct EvolveMomentum : public Component {
   void finally(const Options &state) override;
 
   void outputVars(Options &state) override;
+
+  /// Time derivatives for convergence monitoring
+  void timeDerivs(Options &ddts) override;
+
+  /// Precondition the parallel diffusion of momentum: Numerical
+  /// dissipation, sound wave coupling to the pressure gradient and
+  /// parallel viscosity (if species parallel_viscosity is set).
+  ///
+  /// Inputs
+  /// - species
+  ///   - <name>
+  ///     - density
+  ///     - AA
+  ///     - temperature (only needed if fastest_wave not set)
+  ///     - parallel_viscosity (optional)
+  void precon(const Options &state, BoutReal gamma) override;
 private:
   std::string name;     ///< Short name of species e.g "e"
 
@@ -51,6 +78,7 @@ private:
   BoutReal hyper_z;  ///< Hyper-diffusion
 
   bool diagnose; ///< Output additional diagnostics?
+  bool enable_precon; ///< Enable preconditioner?
   bool fix_momentum_boundary_flux; ///< Fix momentum flux to boundary condition?
   Field3D flow_xlow, flow_ylow; ///< Momentum flow diagnostics
 };
@@ -2,10 +2,28 @@
 #ifndef FIXED_FRACTION_RADIATION_H
 #define FIXED_FRACTION_RADIATION_H
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include <bout/constants.hxx>
 #include "component.hxx"
+#include "integrate.hxx"
 
 namespace {
+  /// Evaluate a polynomial using Horner's scheme
+  ///
+  /// @param coefs  Coefficients in order of increasing power
+  /// @param x      The value at which to evaluate the polynomial
+  template <std::size_t N>
+  BoutReal hornerPolynomial(const std::array<BoutReal, N>& coefs, BoutReal x) {
+    BoutReal result = coefs[N - 1];
+    for (std::size_t i = N - 1; i > 0; --i) {
+      result = result * x + coefs[i - 1];
+    }
+    return result;
+  }
+
   /// Carbon in coronal equilibrium
   /// From I.H.Hutchinson Nucl. Fusion 34 (10) 1337 - 1348 (1994)
   ///
@@ -13,7 +31,10 @@ namespace {
   /// Output: Radiation cooling curve [Wm^3]
   ///         (multiply by Ne * Ni to get W/m^3)
   struct HutchinsonCarbon {
-    BoutReal curve(BoutReal Te) {
+    static constexpr BoutReal Tmin = 1.0; ///< Lower bound of lookup table [eV]
+    static constexpr BoutReal Tmax = 2000; ///< Upper bound of lookup table [eV]
+
+    BoutReal curve(BoutReal Te) const {
       if (Te < 0.0) {
         return 0.0;
       }
@@ -26,123 +47,169 @@ namespace {
   /// Chose N = 1E20m-3 and tau = 0.5ms based on Moulton, 2021 (DOI: 10.1088/1741-4326/abe4b2)
   /// Those values are applicable in the ITER scrape-off layer but may not be valid in other conditions.
   /// The fits are 10 coefficient polynomials fitted in log-log space like the AMJUEL database in EIRENE
+  /// Between Tmin and Tmax the polynomial in log(Te) is evaluated; outside this range
+  /// the curve is constant.
 
   /// Argon
-  struct Argon_adas{
-    BoutReal curve(BoutReal Te) {
-      BoutReal logT = log(Te);
-      BoutReal log_out = 0;
-
-      if (Te >= 1.5 and Te <= 1500) {
-        log_out = log_out
-        -8.45410692e+01 * pow(logT, 0)
-        +1.57727040e+01 * pow(logT, 1)
-        -1.54264860e+01 * pow(logT, 2)
-        +1.49409902e+01 * pow(logT, 3)
-        -1.04815113e+01 * pow(logT, 4)
-        +5.00924595e+00 * pow(logT, 5)
-        -1.60029106e+00 * pow(logT, 6)
-        +3.29455609e-01 * pow(logT, 7)
-        -4.14036827e-02 * pow(logT, 8)
-        +2.87063206e-03 * pow(logT, 9)
-        -8.38888002e-05 * pow(logT, 10);
-        return exp(log_out);
-
-    } else if (Te < 1.5) {
-        return 1.95353412e-35;   
-    } else {
+  struct Argon_adas {
+    static constexpr BoutReal Tmin = 1.5; ///< Lower bound of the fit [eV]
+    static constexpr BoutReal Tmax = 1500; ///< Upper bound of the fit [eV]
+
+    BoutReal curve(BoutReal Te) const {
+      if (Te >= Tmin and Te <= Tmax) {
+        static constexpr std::array<BoutReal, 11> coefs = {
+          -8.45410692e+01,
+          1.57727040e+01,
+          -1.54264860e+01,
+          1.49409902e+01,
+          -1.04815113e+01,
+          5.00924595e+00,
+          -1.60029106e+00,
+          3.29455609e-01,
+          -4.14036827e-02,
+          2.87063206e-03,
+          -8.38888002e-05};
+        return exp(hornerPolynomial(coefs, log(Te)));
+
+      } else if (Te < Tmin) {
+        return 1.95353412e-35;
+      } else {
         return 1.22649600e-32;
-    }
+      }
     }
   };
 
   /// Neon
-  struct Neon_adas{
-    BoutReal curve(BoutReal Te) {
-      BoutReal logT = log(Te);
-      BoutReal log_out = 0;
-
-      if (Te >= 2 and Te <= 1000) {
-        log_out = log_out
-        -8.21475117e+01 * pow(logT, 0)
-        +1.28929854e+01 * pow(logT, 1)
-        -4.74266289e+01 * pow(logT, 2)
-        +7.45222324e+01 * pow(logT, 3)
-        -5.75710722e+01 * pow(logT, 4)
-        +2.57375965e+01 * pow(logT, 5)
-        -7.12758563e+00 * pow(logT, 6)
-        +1.24287546e+00 * pow(logT, 7)
-        -1.32943407e-01 * pow(logT, 8)
-        +7.97368445e-03 * pow(logT, 9)
-        -2.05487897e-04 * pow(logT, 10);
-        return exp(log_out);
-
-    } else if (Te < 2) {
-        return 6.35304113e-36;   
-    } else {
+  struct Neon_adas {
+    static constexpr BoutReal Tmin = 2; ///< Lower bound of the fit [eV]
+    static constexpr BoutReal Tmax = 1000; ///< Upper bound of the fit [eV]
+
+    BoutReal curve(BoutReal Te) const {
+      if (Te >= Tmin and Te <= Tmax) {
+        static constexpr std::array<BoutReal, 11> coefs = {
+          -8.21475117e+01,
+          1.28929854e+01,
+          -4.74266289e+01,
+          7.45222324e+01,
+          -5.75710722e+01,
+          2.57375965e+01,
+          -7.12758563e+00,
+          1.24287546e+00,
+          -1.32943407e-01,
+          7.97368445e-03,
+          -2.05487897e-04};
+        return exp(hornerPolynomial(coefs, log(Te)));
+
+      } else if (Te < Tmin) {
+        return 6.35304113e-36;
+      } else {
         return 1.17894628e-32;
-    }
+      }
     }
   };
 
 
   /// Nitrogen
-  struct Nitrogen_adas{
-    BoutReal curve(BoutReal Te) {
-      BoutReal logT = log(Te);
-      BoutReal log_out = 0;
-
-      if (Te >= 2 and Te <= 500) {
-        log_out = log_out
-        -5.01649969e+01 * pow(logT, 0)
-        -1.35749724e+02 * pow(logT, 1)
-        +2.73509608e+02 * pow(logT, 2)
-        -2.92109992e+02 * pow(logT, 3)
-        +1.90120639e+02 * pow(logT, 4)
-        -7.95164871e+01 * pow(logT, 5)
-        +2.17762218e+01 * pow(logT, 6)
-        -3.88334992e+00 * pow(logT, 7)
-        +4.34730098e-01 * pow(logT, 8)
-        -2.77683605e-02 * pow(logT, 9)
-        +7.72720422e-04 * pow(logT, 10);
-        return exp(log_out);
-
-    } else if (Te < 2) {
-        return 4.34835380e-34;   
-    } else {
+  struct Nitrogen_adas {
+    static constexpr BoutReal Tmin = 2; ///< Lower bound of the fit [eV]
+    static constexpr BoutReal Tmax = 500; ///< Upper bound of the fit [eV]
+
+    BoutReal curve(BoutReal Te) const {
+      if (Te >= Tmin and Te <= Tmax) {
+        static constexpr std::array<BoutReal, 11> coefs = {
+          -5.01649969e+01,
+          -1.35749724e+02,
+          2.73509608e+02,
+          -2.92109992e+02,
+          1.90120639e+02,
+          -7.95164871e+01,
+          2.17762218e+01,
+          -3.88334992e+00,
+          4.34730098e-01,
+          -2.77683605e-02,
+          7.72720422e-04};
+        return exp(hornerPolynomial(coefs, log(Te)));
+
+      } else if (Te < Tmin) {
+        return 4.34835380e-34;
+      } else {
         return 8.11096182e-33;
-    }
+      }
     }
   };
 
 
   /// Carbon
-  struct Carbon_adas{
-    BoutReal curve(BoutReal Te) {
-      BoutReal logT = log(Te);
-      BoutReal log_out = 0;
-
-      if (Te >= 1 and Te <= 500) {
-        log_out = log_out
-        -7.87837896e+01 * pow(logT, 0)
-        +1.55326376e+00 * pow(logT, 1)
-        +1.65898194e+01 * pow(logT, 2)
-        -3.23804546e+01 * pow(logT, 3)
-        +3.12784663e+01 * pow(logT, 4)
-        -1.74826039e+01 * pow(logT, 5)
-        +5.91393245e+00 * pow(logT, 6)
-        -1.22974105e+00 * pow(logT, 7)
-        +1.54004499e-01 * pow(logT, 8)
-        -1.06797106e-02 * pow(logT, 9)
-        +3.15657594e-04 * pow(logT, 10);
-        return exp(log_out);
-
-    } else if (Te < 1) {
-        return 6.00623928e-35;   
-    } else {
+  struct Carbon_adas {
+    static constexpr BoutReal Tmin = 1; ///< Lower bound of the fit [eV]
+    static constexpr BoutReal Tmax = 500; ///< Upper bound of the fit [eV]
+
+    BoutReal curve(BoutReal Te) const {
+      if (Te >= Tmin and Te <= Tmax) {
+        static constexpr std::array<BoutReal, 11> coefs = {
+          -7.87837896e+01,
+          1.55326376e+00,
+          1.65898194e+01,
+          -3.23804546e+01,
+          3.12784663e+01,
+          -1.74826039e+01,
+          5.91393245e+00,
+          -1.22974105e+00,
+          1.54004499e-01,
+          -1.06797106e-02,
+          3.15657594e-04};
+        return exp(hornerPolynomial(coefs, log(Te)));
+
+      } else if (Te < Tmin) {
+        return 6.00623928e-35;
+      } else {
         return 4.53057707e-33;
+      }
     }
+  };
+
+  /// Cooling curve tabulated on a uniform grid in log(Te)
+  ///
+  /// Between CoolingCurve::Tmin and CoolingCurve::Tmax the curve is
+  /// linearly interpolated in log(Te). Outside this range the
+  /// CoolingCurve is evaluated directly.
+  template <typename CoolingCurve>
+  class CoolingCurveTable {
+  public:
+    CoolingCurveTable() = default;
+
+    /// @param cooling   The curve to tabulate
+    /// @param npoints   Number of points in the table (at least 2)
+    CoolingCurveTable(const CoolingCurve& cooling, int npoints)
+        : cooling(cooling), logTmin(log(CoolingCurve::Tmin)) {
+      ASSERT0(npoints >= 2);
+      dlogT = (log(CoolingCurve::Tmax) - logTmin) / (npoints - 1);
+      inv_dlogT = 1. / dlogT;
+
+      values.resize(npoints);
+      for (int i = 0; i < npoints; i++) {
+        values[i] = cooling.curve(exp(logTmin + i * dlogT));
+      }
+      // Ensure that the end points match the curve exactly
+      values.front() = cooling.curve(CoolingCurve::Tmin);
+      values.back() = cooling.curve(CoolingCurve::Tmax);
+    }
+
+    BoutReal curve(BoutReal Te) const {
+      if (Te >= CoolingCurve::Tmin and Te <= CoolingCurve::Tmax) {
+        const BoutReal x = (log(Te) - logTmin) * inv_dlogT;
+        // Clamp so that rounding at Tmax doesn't read beyond the table
+        const int ind = std::min(static_cast<int>(x), static_cast<int>(values.size()) - 2);
+        const BoutReal w = x - ind;
+        return (1. - w) * values[ind] + w * values[ind + 1];
+      }
+      return cooling.curve(Te);
     }
+
+  private:
+    CoolingCurve cooling;
+    BoutReal logTmin, dlogT, inv_dlogT;
+    std::vector<BoutReal> values; ///< Curve values at uniform log(Te) intervals
   };
 }
 
@@ -153,6 +220,9 @@ struct FixedFractionRadiation : public Component {
   /// Inputs
   /// - <name>
   ///   - fraction
+  ///   - diagnose
+  ///   - lookup_table
+  ///   - table_points
   FixedFractionRadiation(std::string name, Options &alloptions, Solver *UNUSED(solver)) : name(name) {
     auto& options = alloptions[name];
 
@@ -164,6 +234,17 @@ struct FixedFractionRadiation : public Component {
       .doc("Output radiation diagnostic?")
       .withDefault<bool>(false);
 
+    lookup_table = options["lookup_table"]
+      .doc("Interpolate the cooling curve from a table in log(Te)?")
+      .withDefault<bool>(false);
+
+    if (lookup_table) {
+      table = CoolingCurveTable<CoolingCurve>(
+          cooling, options["table_points"]
+                       .doc("Number of points in the cooling curve lookup table")
+                       .withDefault(2000));
+    }
+
     // Get the units
     auto& units = alloptions["units"];
     Tnorm = get<BoutReal>(units["eV"]);
@@ -190,19 +271,24 @@ struct FixedFractionRadiation : public Component {
     const Field3D Ne = GET_NOBOUNDARY(Field3D, electrons["density"]);
     const Field3D Te = GET_NOBOUNDARY(Field3D, electrons["temperature"]);
 
-    radiation = cellAverage(
-                            [&](BoutReal ne, BoutReal te) {
-                              if (ne < 0.0 or te < 0.0) {
-                                return 0.0;
-                              }
-                              // Fixed fraction ions
-                              const BoutReal ni = fraction * ne;
-                              // cooling in Wm^3 so normalise.
-                              // Note factor of qe due to Watts rather than eV
-                              return ne * ni * cooling.curve(te * Tnorm) * Nnorm /
-                                (SI::qe * Tnorm * FreqNorm);
-                            },
-                            Ne.getRegion("RGN_NOBNDRY"))(Ne, Te);
+    // cooling in Wm^3 so normalise.
+    // Note factor of qe due to Watts rather than eV
+    const BoutReal norm = fraction * Nnorm / (SI::qe * Tnorm * FreqNorm);
+
+    // Integrate the radiation over each cell using the given curve
+    auto radiationFrom = [&](const auto& curve) {
+      return cellAverage(
+                         [&](BoutReal ne, BoutReal te) {
+                           if (ne < 0.0 or te < 0.0) {
+                             return 0.0;
+                           }
+                           // Fixed fraction ions: ni = fraction * ne
+                           return ne * ne * curve.curve(te * Tnorm) * norm;
+                         },
+                         Ne.getRegion("RGN_NOBNDRY"))(Ne, Te);
+    };
+
+    radiation = lookup_table ? radiationFrom(table) : radiationFrom(cooling);
 
     // Remove radiation from the electron energy source
     subtract(electrons["energy_source"], radiation);
@@ -226,6 +312,9 @@ struct FixedFractionRadiation : public Component {
   CoolingCurve cooling; ///< The cooling curve L(T) -> Wm^3
   BoutReal fraction; ///< Fixed fraction
 
+  bool lookup_table; ///< Interpolate cooling curve from table?
+  CoolingCurveTable<CoolingCurve> table; ///< Tabulated cooling curve
+
   bool diagnose; ///< Output radiation diagnostic?
   Field3D radiation; ///< For output diagnostic
 
@@ -19,6 +19,10 @@ struct NeutralFullVelocity : public Component {
   /// (e.g. time derivatives)
   void finally(const Options &state) override;
 
+  /// Time derivatives of Nn, Pn and the components of Vn,
+  /// for steady state monitoring
+  void timeDerivs(Options &ddts) override;
+
   /// Add extra fields for output, or set attributes e.g docstrings
   void outputVars(Options &state) override;
 private:
@@ -131,7 +131,7 @@ struct HydrogenChargeExchangeIsotope : public HydrogenChargeExchange {
                     state["species"][{Isotope1, '+'}],              // e.g. "h+"
                     R, atom_mom, ion_mom, atom_energy, ion_energy); // Transfer channels
 
-    if (diagnose) {
+    if (diagnose and isOutputStep(state)) {
       // Calculate diagnostics to be written to dump file
       if (Isotope1 == Isotope2) {
         // Simpler case of same isotopes
@@ -3,7 +3,10 @@
 #ifndef INTEGRATE_H
 #define INTEGRATE_H
 
+#include <array>
 #include <functional>
+#include <tuple>
+#include <utility>
 
 #include <bout/field3d.hxx>
 #include <bout/coordinates.hxx>
@@ -85,4 +88,65 @@ auto cellAverage(Function func, const RegionType &region) {
   };
 }
 
+/// Used to convert a parameter pack of field types into BoutReals
+template <typename T>
+using AsBoutReal = BoutReal;
+
+/// Like cellAverage, but the function returns several values as a
+/// std::array<BoutReal, N>, and the result is a std::array<Field3D, N>.
+///
+/// This evaluates the cell edge values and Jacobian weights once, so
+/// is cheaper than several calls to cellAverage with the same inputs.
+///
+/// Example
+///   Field3D Ne = ..., Te = ...;
+///
+///   auto result = cellAverageMultiple(
+///          [](BoutReal Ne, BoutReal Te) {
+///            return std::array<BoutReal, 2>{Ne * Te, Ne * Ne};
+///          },
+///          Ne.getRegion("RGN_NOBNDRY"))(Ne, Te);
+///
+///   Field3D NeTe = result[0];
+///   Field3D NeSq = result[1];
+///
+template <typename CellEdges = hermes::Limiter, typename Function, typename RegionType>
+auto cellAverageMultiple(Function func, const RegionType &region) {
+  // Note: Capture by value or func and region go out of scope
+  return [=](const auto &... args) {
+    using ResultValues = decltype(func(std::declval<AsBoutReal<decltype(args)>>()...));
+    constexpr std::size_t N = std::tuple_size<ResultValues>::value;
+
+    // Use the first argument to set the result mesh etc.
+    std::array<Field3D, N> result;
+    for (auto& field : result) {
+      field = emptyFrom(firstArg(args...));
+      field.allocate();
+    }
+
+    // Get the coordinate Jacobian
+    auto J = result[0].getCoordinates()->J;
+    BOUT_FOR(i, region) {
+      // Offset indices
+      auto yp = i.yp();
+      auto ym = i.ym();
+      auto Ji = J[i];
+
+      // Integrate in Y using Simpson's rule
+      // Using limiter to calculate cell edge values
+      const ResultValues centre = func((args[i])...);
+      const ResultValues left = func(cellLeft<CellEdges>(args[i], args[ym], args[yp])...);
+      const ResultValues right = func(cellRight<CellEdges>(args[i], args[ym], args[yp])...);
+
+      const BoutReal weight_left = (Ji + J[ym]) / (12. * Ji);
+      const BoutReal weight_right = (Ji + J[yp]) / (12. * Ji);
+
+      for (std::size_t k = 0; k < N; ++k) {
+        result[k][i] = 4. / 6 * centre[k] + weight_left * left[k] + weight_right * right[k];
+      }
+    }
+    return result;
+  };
+}
+
 #endif // INTEGRATE_H
@@ -45,6 +45,7 @@ struct IonViscosity : public Component {
   /// - species
   ///   - <name>
   ///     - momentum_source
+  ///     - parallel_viscosity
   ///
   void transform(Options &state) override;
 
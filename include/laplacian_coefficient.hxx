@@ -0,0 +1,89 @@
+#pragma once
+#ifndef LAPLACIAN_COEFFICIENT_H
+#define LAPLACIAN_COEFFICIENT_H
+
+#include <bout/boutcomm.hxx>
+#include <bout/field2d.hxx>
+#include <bout/field3d.hxx>
+
+#include <mpi.h>
+
+/// Keeps the last coefficient given to a Laplacian solver, to detect changes
+///
+/// Setting a coefficient causes some Laplacian implementations (e.g. PETSc)
+/// to rebuild their matrix and preconditioner on the next solve, even if the
+/// values have not changed. This is used to only set coefficients which have
+/// changed, or changed by more than a given tolerance, so that the setup is
+/// reused (lagged) otherwise.
+///
+/// A positive tolerance lags the coefficient itself, and so changes the
+/// equation which is solved. It should only be used where the solution does
+/// not need to be exact, e.g. in preconditioners.
+///
+/// Example
+///
+///     LaplacianCoefficient<Field3D> coefA{tolerance};
+///     ...
+///     if (coefA.update(alpha)) {
+///       solver->setCoefA(coefA.value());
+///     }
+///
+template <typename T>
+class LaplacianCoefficient {
+public:
+  /// @param tolerance  Change in coefficient, relative to its maximum magnitude,
+  ///                   below which the previous coefficient is kept.
+  ///                   Positive values change the solution, so should only
+  ///                   be used in preconditioners.
+  ///                   Zero means the coefficient is updated if any value
+  ///                   has changed. Negative means the coefficient is always
+  ///                   updated, without comparing or copying it.
+  explicit LaplacianCoefficient(BoutReal tolerance = 0.0) : tolerance(tolerance) {}
+
+  /// Compare coef with the last value. If it has changed by more than the
+  /// tolerance then store it and return true.
+  ///
+  /// Note: If tolerance >= 0 this uses global reductions, so must be called
+  ///       on all processors. The result is the same on all processors.
+  bool update(const T& coef) {
+    if (tolerance < 0.0) {
+      last = coef; // Not compared, so no copy needed
+      return true;
+    }
+    if (!last.isAllocated()) {
+      last = copy(coef);
+      return true;
+    }
+    if ((tolerance == 0.0) ? changed(coef)
+                           : (max(abs(coef - last), true, "RGN_ALL")
+                              > tolerance * max(abs(last), true, "RGN_ALL"))) {
+      last = copy(coef);
+      return true;
+    }
+    return false;
+  }
+
+  /// The last coefficient stored by update
+  const T& value() const { return last; }
+
+private:
+  BoutReal tolerance; ///< Relative tolerance
+  T last;             ///< Last coefficient value
+
+  /// Is any value of coef different from the last value, on any processor?
+  /// Boundary cells are included, since they are used in the boundary rows.
+  bool changed(const T& coef) const {
+    int local_changed = 0;
+    for (const auto& i : coef.getRegion("RGN_ALL")) {
+      if (coef[i] != last[i]) {
+        local_changed = 1;
+        break;
+      }
+    }
+    int any_changed = 0;
+    MPI_Allreduce(&local_changed, &any_changed, 1, MPI_INT, MPI_MAX, BoutComm::get());
+    return any_changed != 0;
+  }
+};
+
+#endif // LAPLACIAN_COEFFICIENT_H
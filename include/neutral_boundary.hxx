@@ -3,14 +3,7 @@
 #define NEUTRAL_BOUNDARY_H
 
 #include "component.hxx"
-
-namespace {
-Ind3D indexAt(const Field3D& f, int x, int y, int z) {
-  int ny = f.getNy();
-  int nz = f.getNz();
-  return Ind3D{(x * ny + y) * nz + z, ny, nz};
-}
-}; // namespace
+#include "wall_boundary.hxx"
 
 /// Per-species boundary condition for neutral particles at
 /// sheath (Y) boundaries.
@@ -61,6 +54,8 @@ private:
   bool upper_y; ///< Boundary condition at upper y?
   bool sol; ///< Boundary condition at sol?
   bool pfr; ///< Boundary condition at pfr?
+
+  WallBoundary wall; ///< Target and wall boundary cells and geometry
 };
 
 namespace {
@@ -9,6 +9,7 @@
 #include <bout/invert_laplace.hxx>
 
 #include "component.hxx"
+#include "laplacian_coefficient.hxx"
 
 /// Evolve density, parallel momentum and pressure
 /// for a neutral gas species with cross-field diffusion
@@ -29,6 +30,9 @@ struct NeutralMixed : public Component {
   /// Add extra fields for output, or set attributes e.g docstrings
   void outputVars(Options &state) override;
 
+  /// Time derivatives for convergence monitoring
+  void timeDerivs(Options &ddts) override;
+
   /// Preconditioner
   void precon(const Options &state, BoutReal gamma) override;
 private:
@@ -55,6 +59,7 @@ private:
 
   bool precondition {true}; ///< Enable preconditioner?
   std::unique_ptr<Laplacian> inv; ///< Laplacian inversion used for preconditioning
+  LaplacianCoefficient<Field3D> precon_coefD; ///< Last coefficient set in inv
 
   Field3D density_source, pressure_source; ///< External input source
   Field3D Sn, Sp, Snv; ///< Particle, pressure and momentum source
@@ -0,0 +1,31 @@
+#pragma once
+#ifndef OUTPUT_PRECISION_H
+#define OUTPUT_PRECISION_H
+
+#include <bout/options.hxx>
+
+/// Round \p value to the nearest number with \p bits bits of mantissa.
+/// The remaining bits of the mantissa are zero, so that the output
+/// files compress well (e.g. with nccopy -d or h5repack).
+/// The relative error is at most 2^-(bits+1).
+BoutReal roundMantissa(BoutReal value, int bits);
+
+/// The number of mantissa bits needed to keep the relative
+/// rounding error below \p relative_error
+int mantissaBits(BoutReal relative_error);
+
+/// Reduce the precision of time-dependent Field2D and Field3D values
+/// in the output \p options. Values which are shared with the
+/// simulation are copied before being rounded.
+///
+/// The precision of each variable is set by its attributes:
+///  - precision = "float32"  Round to single precision (23 bits)
+///    precision = "float64"  Keep full precision
+///  - relative_error         Maximum relative error. 0 means full precision
+///
+/// Variables with neither attribute use \p default_relative_error,
+/// which is then recorded in their "relative_error" attribute.
+/// Only variables with a "time_dimension" attribute are modified.
+void reduceOutputPrecision(Options& options, BoutReal default_relative_error);
+
+#endif // OUTPUT_PRECISION_H
@@ -3,6 +3,7 @@
 #define POLARISATION_DRIFT_H
 
 #include "component.hxx"
+#include "laplacian_coefficient.hxx"
 
 class Laplacian;
 
@@ -59,6 +60,7 @@ struct PolarisationDrift : public Component {
   void outputVars(Options &state) override;
 private:
   std::unique_ptr<Laplacian> phiSolver; // Laplacian solver in X-Z
+  LaplacianCoefficient<Field3D> phiCoefC; ///< Last coefficient set in phiSolver
 
   Field2D Bsq; // Cached SQ(coord->Bxy)
   
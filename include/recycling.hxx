@@ -3,6 +3,7 @@
 #define RECYCLING_H
 
 #include "component.hxx"
+#include "wall_boundary.hxx"
 
 /// Convert fluxes of species at boundaries
 ///
@@ -57,6 +58,7 @@ private:
 
   Field3D density_source, energy_source; ///< Recycling particle and energy sources for all locations
   Field2D is_pump; ///< 1 = pump, 0 = no pump. Works only in SOL/PFR
+  WallBoundary wall; ///< Target and wall boundary cells and geometry
 
   // Recycling particle and energy sources for the different sources of recycling
   // Note that SOL, PFR and pump are not applicable to 1D
@@ -55,6 +55,9 @@ struct RelaxPotential : public Component {
   void finally(const Options& state) override;
 
   void outputVars(Options& state) override;
+
+  /// Time derivatives for convergence monitoring
+  void timeDerivs(Options& ddts) override;
 private:
   Field3D Vort; // Evolving vorticity
 
@@ -0,0 +1,63 @@
+#pragma once
+#ifndef RESTART_INTERPOLATION_H
+#define RESTART_INTERPOLATION_H
+
+#include <bout/options.hxx>
+
+#include <string>
+#include <vector>
+
+class Mesh;
+
+/// Linear interpolation weights in one dimension:
+///   value = (1 - weight) * f[lower] + weight * f[upper]
+struct InterpolationWeights {
+  int lower;
+  int upper;
+  BoutReal weight;
+};
+
+/// Map cell \p index on one grid onto another grid, with
+/// piecewise-linear scaling between boundaries.
+///
+/// Both grids are divided into the same number of segments, for
+/// example by separatrices and X-points. Cells in each segment are
+/// interpolated only from cells in the corresponding segment on the
+/// other grid, so that values are not mixed across boundaries.
+///
+/// @param index       Cell index on the new grid
+/// @param new_bounds  Segment boundaries on the new grid, starting with 0
+///                    and ending with the number of cells
+/// @param old_bounds  Segment boundaries on the old grid. Must be the same size
+InterpolationWeights interpolationWeights(int index, const std::vector<int>& new_bounds,
+                                          const std::vector<int>& old_bounds);
+
+/// Read restart files BOUT.restart.*.nc in directory \p path, written on a
+/// mesh with a different resolution and/or processor layout, and
+/// interpolate all 3D variables onto \p mesh.
+///
+/// In X the grid is divided at the boundary guard cells and the
+/// separatrices (ixseps1, ixseps2). In Y it is divided at the X-points
+/// and the upper target (jyseps*, ny_inner), so both meshes must have the
+/// same topology. Z is periodic. Interpolation in Y is at fixed Z index,
+/// so if nz > 1 this throws unless the parallel transform is the identity.
+///
+/// Each processor only reads the restart files which overlap its cells,
+/// but stores the old fields on the whole grid, so this is intended for
+/// axisymmetric or small simulations, e.g. mesh sequencing to steady state.
+///
+/// Scalar values in the restart files (e.g. the time "tt") are copied
+/// from the first file.
+///
+/// @returns  Interpolated Field3D variables, and scalars
+Options interpolateRestart(const std::string& path, Mesh* mesh);
+
+/// Select the variables from interpolateRestart() which can be used to
+/// set components' internal state (see Component::loadState).
+///
+/// Only Field3D variables are kept. Scalars are dropped, since time
+/// stamps (e.g. of the last feedback controller update) are times in the
+/// old run, and the new run starts from time zero.
+Options interpolatedState(const Options& interpolated);
+
+#endif // RESTART_INTERPOLATION_H
@@ -0,0 +1,160 @@
+#pragma once
+#ifndef RUNNING_STATISTICS_H
+#define RUNNING_STATISTICS_H
+
+#include "component.hxx"
+
+#include <bout/field2d.hxx>
+#include <bout/field3d.hxx>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+/// Streaming moments of a field, updated one sample at a time
+/// using Welford's algorithm, extended to third and fourth moments
+/// (Pebay 2008). Samples are not stored.
+///
+/// @tparam T  Field2D or Field3D
+template <typename T>
+class Moments {
+public:
+  /// @param order  Highest moment to calculate, between 1 (mean) and 4 (kurtosis)
+  explicit Moments(int order = 2) : order(order) {}
+
+  /// Add a sample
+  void add(const T& x) {
+    if (count == 0) {
+      mean_ = copy(x);
+      m2 = zeroFrom(x);
+      m3 = zeroFrom(x);
+      m4 = zeroFrom(x);
+      count = 1;
+      return;
+    }
+    const BoutReal n1 = count;
+    ++count;
+    const BoutReal n = count;
+
+    const T delta = x - mean_;
+    const T delta_n = delta / n;
+    const T term1 = delta * delta_n * n1;
+
+    if (order >= 4) {
+      m4 += term1 * SQ(delta_n) * (n * n - 3 * n + 3) + 6 * SQ(delta_n) * m2
+            - 4 * delta_n * m3;
+    }
+    if (order >= 3) {
+      m3 += term1 * delta_n * (n - 2) - 3 * delta_n * m2;
+    }
+    if (order >= 2) {
+      m2 += term1;
+    }
+    mean_ += delta_n;
+  }
+
+  /// Remove all samples
+  void reset() { count = 0; }
+
+  /// Number of samples
+  int samples() const { return count; }
+
+  const T& mean() const { return mean_; }
+
+  /// Unbiased sample variance. Zero if fewer than two samples
+  T variance() const { return (count > 1) ? T(m2 / (count - 1)) : zeroFrom(mean_); }
+
+  /// Sample skewness. Zero where the variance is zero
+  T skewness() const {
+    T result = zeroFrom(mean_);
+    BOUT_FOR(i, result.getRegion("RGN_ALL")) {
+      if (m2[i] > 0.0) {
+        result[i] = std::sqrt(static_cast<BoutReal>(count)) * m3[i] / std::pow(m2[i], 1.5);
+      }
+    }
+    return result;
+  }
+
+  /// Sample excess kurtosis. Zero where the variance is zero
+  T kurtosis() const {
+    T result = zeroFrom(mean_);
+    BOUT_FOR(i, result.getRegion("RGN_ALL")) {
+      if (m2[i] > 0.0) {
+        result[i] = count * m4[i] / SQ(m2[i]) - 3.0;
+      }
+    }
+    return result;
+  }
+
+private:
+  int order;
+  int count{0};
+  T mean_;      ///< Mean
+  T m2, m3, m4; ///< Sums of powers of differences from the mean
+};
+
+/// Accumulates statistics of state variables over time, and writes
+/// them at each output instead of the variables themselves.
+///
+///     [hermes]
+///     components = ..., stats
+///
+///     [solver]
+///     type = rk4               # Explicit: euler, rk4, rk3ssp or rkgeneric
+///     monitor_timestep = true  # Required
+///
+///     [stats]
+///     type = running_statistics
+///     variables = species:e:density, fields:phi
+///     moments = 2            # 1 = mean, 2 = variance, 3 = skewness, 4 = kurtosis
+///     sample_interval = 0.1  # Time between samples [normalised]. Required
+///     z_average = true       # Average over Z before sampling
+///
+/// The names of the outputs are the variable path, with "species:"
+/// removed and ":" replaced by "_", followed by _mean, _var, _skew
+/// or _kurt e.g. "e_density_mean", "fields_phi_var".
+///
+/// Samples are only taken from states accepted by the solver: One sample
+/// is taken in each interval of length sample_interval, by the first
+/// accepted timestep at or after a multiple of sample_interval which
+/// the model is evaluated at (see ComponentScheduler::timestepAccepted).
+/// The statistics are those of samples since the last output, unless
+/// reset_on_output = false. If there are no samples the moments are NaN.
+struct RunningStatistics : public Component {
+  RunningStatistics(std::string name, Options& alloptions, Solver*);
+
+  /// Does nothing: Samples are only taken in timestepAccepted
+  void transform(Options& UNUSED(state)) override {}
+
+  /// Sample the variables if the time has passed the next sample time
+  void timestepAccepted(const Options& state) override;
+
+  /// Save statistics, then reset if reset_on_output is true
+  void outputVars(Options& state) override;
+
+private:
+  struct Variable {
+    std::vector<std::string> path; ///< Path in the state e.g. {"species", "e", "density"}
+    std::string label;             ///< Prefix for output names
+    Moments<Field3D> moments3d;    ///< Used if not reducing in Z
+    Moments<Field2D> moments2d;    ///< Used if z_average or z_index >= 0
+  };
+  std::vector<Variable> variables;
+
+  int moments;              ///< Highest moment
+  BoutReal sample_interval; ///< Time between samples
+  long last_sample;         ///< Index of the last sample time, in units of sample_interval
+  bool sampled{false};      ///< Has a sample been taken?
+  bool z_average;           ///< Average over Z?
+  int z_index;              ///< Sample only this Z index. < 0 means all
+  bool reset_on_output;     ///< Reset statistics after each output?
+
+  /// Sample \p value, reducing in Z if needed
+  void sample(Variable& var, const Field3D& value);
+};
+
+namespace {
+RegisterComponent<RunningStatistics> registercomponentrunningstatistics("running_statistics");
+}
+
+#endif // RUNNING_STATISTICS_H
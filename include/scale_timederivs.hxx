@@ -13,6 +13,10 @@
 struct ScaleTimeDerivs : public Component {
   ScaleTimeDerivs(std::string, Options&, Solver*) {}
 
+  /// Optional inputs
+  ///
+  /// - pseudo_time_factor   Multiplies the scaling
+  ///
   /// Sets in the state
   ///
   /// - scale_timederivs
@@ -27,6 +31,11 @@ struct ScaleTimeDerivs : public Component {
     Field3D dt = dl2 / pow(floor(Te, 1e-5), 5./2);
     scaling = dt / max(dt, true); // Saved for output
 
+    if (state.isSet("pseudo_time_factor")) {
+      // Set by Hermes when using switched evolution relaxation (SER)
+      scaling *= get<BoutReal>(state["pseudo_time_factor"]);
+    }
+
     state["scale_timederivs"] = scaling;
   }
 
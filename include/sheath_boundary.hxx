@@ -3,6 +3,7 @@
 #define SHEATH_BOUNDARY_H
 
 #include "component.hxx"
+#include "wall_boundary.hxx"
 
 /// Boundary condition at the wall in Y
 ///
@@ -16,8 +17,12 @@
 ///   - The approximation used here is for ions having similar
 ///     gyro-orbit sizes
 ///   - No boundary condition is applied to neutral species
-///   - Boundary conditions are applied to field-aligned fields
-///     using to/fromFieldAligned
+///   - Boundary conditions are applied to field-aligned values.
+///     Only the y planes next to the boundaries are shifted,
+///     using BoundarySlice
+///   - All species are gathered first, then the potential and the
+///     boundary conditions for all species are calculated in a single
+///     pass over the boundary cells
 ///
 struct SheathBoundary : public Component {
   /// # Input options
@@ -60,12 +65,14 @@ struct SheathBoundary : public Component {
   ///     - temperature  Sets boundary
   ///     - velocity     Sets boundary
   ///     - energy_source
+  ///     - energy_flow_ylow  Adds the heat flow through the sheath
   ///   - <ions>
   ///     - density      Sets boundary
   ///     - temperature  Sets boundary
   ///     - velocity     Sets boundary
   ///     - momentum     Sets boundary
   ///     - energy_source
+  ///     - energy_flow_ylow  Adds the heat flow through the sheath
   /// - fields
   ///   - phi   Sets boundary
   ///
@@ -87,6 +94,8 @@ private:
   Field3D wall_potential; ///< Voltage at the wall. Normalised units.
 
   bool floor_potential; ///< Apply floor to sheath potential?
+
+  WallBoundary wall; ///< Target boundary cells and geometry
 };
 
 namespace {
@@ -3,6 +3,7 @@
 #define SHEATH_BOUNDARY_INSULATING_H
 
 #include "component.hxx"
+#include "wall_boundary.hxx"
 
 /// Insulating sheath boundary condition at the wall in Y
 ///
@@ -42,12 +43,14 @@ struct SheathBoundaryInsulating : public Component {
   ///     - temperature  Sets boundary
   ///     - velocity     Sets boundary
   ///     - energy_source
+  ///     - energy_flow_ylow  Adds the heat flow through the sheath
   ///   - <ions>
   ///     - density      Sets boundary
   ///     - temperature  Sets boundary
   ///     - velocity     Sets boundary
   ///     - momentum     Sets boundary
   ///     - energy_source
+  ///     - energy_flow_ylow  Adds the heat flow through the sheath
   /// - fields
   ///   - phi   Sets boundary
   ///
@@ -65,6 +68,8 @@ private:
   bool upper_y; // Boundary on upper y?
 
   BoutReal gamma_e; ///< Electron sheath heat transmission
+
+  WallBoundary wall; ///< Target boundary cells and geometry
 };
 
 namespace {
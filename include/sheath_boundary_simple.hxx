@@ -3,6 +3,7 @@
 #define SHEATH_BOUNDARY_SIMPLE_H
 
 #include "component.hxx"
+#include "wall_boundary.hxx"
 
 /// Boundary condition at the wall in Y
 ///
@@ -58,12 +59,14 @@ struct SheathBoundarySimple : public Component {
   ///     - temperature  Sets boundary
   ///     - velocity     Sets boundary
   ///     - energy_source
+  ///     - energy_flow_ylow  Adds the heat flow through the sheath
   ///   - <ions>
   ///     - density      Sets boundary
   ///     - temperature  Sets boundary
   ///     - velocity     Sets boundary
   ///     - momentum     Sets boundary
   ///     - energy_source
+  ///     - energy_flow_ylow  Adds the heat flow through the sheath
   /// - fields
   ///   - phi   Sets boundary
   ///
@@ -87,6 +90,8 @@ private:
   bool always_set_phi; ///< Set phi field?
 
   Field3D wall_potential; ///< Voltage of the wall. Normalised units.
+
+  WallBoundary wall; ///< Target boundary cells and geometry
 };
 
 namespace {
@@ -31,6 +31,12 @@
 /// diagnose = true # Saves heat flux diagnostics
 /// ```
 ///
+/// The SNB model in BOUT++ works in SI units, taking lengths from the
+/// mesh metric. The parallel cell lengths in metres are calculated once
+/// and swapped into the coordinates only for the duration of the SNB
+/// calculation; the normalised values are restored afterwards, even if
+/// the SNB calculation throws.
+///
 /// # Useful references:
 ///
 ///  *  Braginskii equations by R.Fitzpatrick:
@@ -74,6 +80,9 @@ private:
   Field3D Div_Q_SH, Div_Q_SNB; ///< Divergence of heat fluxes
 
   bool diagnose; ///< Output additional diagnostics?
+
+  Field2D dy_SI; ///< Parallel cell lengths in metres
+  BoutReal dy_SI_rho_s0{-1.0}; ///< Length normalisation used to calculate dy_SI
 };
 
 namespace {
@@ -45,9 +45,7 @@ struct UpstreamDensityFeedback : public Component {
                                   .doc("Force source to be positive?")
                                   .withDefault<bool>(true);
 
-    // NOTE: density_error_integral should be set from the restart file here.
-    // There doesn't seem to be a way to get the restart Options,
-    // so for now this is set in restartVars
+    // density_error_integral is set from the restart file in loadState
 
     // Source shape the same as used in EvolveDensity
     density_source_shape =
@@ -121,22 +119,41 @@ struct UpstreamDensityFeedback : public Component {
     }
   }
 
-  void restartVars(Options& state) override {
+  /// Save the state of the PI controller
+  void saveState(Options& restart) override {
     AUTO_TRACE();
 
-    // NOTE: This is a hack because we know that the loaded restart file
-    //       is passed into restartVars in PhysicsModel::postInit
-    // The restart value should be used in init() rather than here
-    static bool first = true;
-    if (first and state.isSet(name + "_density_error_integral")) {
-      first = false;
-      density_error_integral = state[name + "_density_error_integral"].as<BoutReal>();
-    }
-
-    // Save the density error integral
-    set_with_attrs(state[name + "_density_error_integral"], density_error_integral,
+    Options& state = restart["state"][name];
+    set_with_attrs(state["density_error_integral"], density_error_integral,
                    {{"long_name", name + " density error integral"},
                     {"source", "upstream_density_feedback"}});
+    set_with_attrs(state["density_error_lasttime"], density_error_lasttime,
+                   {{"long_name", name + " time of last density error"},
+                    {"source", "upstream_density_feedback"}});
+    set_with_attrs(state["density_error_last"], density_error_last,
+                   {{"long_name", name + " last density error"},
+                    {"source", "upstream_density_feedback"}});
+  }
+
+  /// Restore the state of the PI controller. Older restart files
+  /// only contain the integral, as <name>_density_error_integral
+  void loadState(const Options& restart) override {
+    AUTO_TRACE();
+
+    if (!(restart.isSection("state") and restart["state"].isSection(name))) {
+      if (restart.isSet(name + "_density_error_integral")) {
+        density_error_integral = restart[name + "_density_error_integral"].as<BoutReal>();
+      }
+      return;
+    }
+    const Options& state = restart["state"][name];
+    if (state.isSet("density_error_integral")) {
+      density_error_integral = state["density_error_integral"].as<BoutReal>();
+    }
+    if (state.isSet("density_error_lasttime")) {
+      density_error_lasttime = state["density_error_lasttime"].as<BoutReal>();
+      density_error_last = state["density_error_last"].as<BoutReal>();
+    }
   }
 
 private:
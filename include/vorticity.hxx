@@ -6,6 +6,7 @@
 
 #include "component.hxx"
 
+class InvertParDiv;
 class LaplaceXY;
 class Laplacian;
 
@@ -39,8 +40,13 @@ struct Vorticity : public Component {
   ///     Timescale for phi boundary relaxation [seconds]
   ///   - phi_dissipation: bool, default true
   ///     Parallel dissipation of potential (Recommended)
+  ///   - phi_warm_start: bool, default true
+  ///     Use the previous solution as initial guess for the phi solve?
   ///   - poloidal_flows: bool, default true
   ///     Include poloidal ExB flow?
+  ///   - precondition: bool, default false
+  ///     Precondition the parallel dissipation terms?
+  ///     Note: solver may not use it even if enabled.
   ///   - sheath_boundary: bool, default false
   ///     If phi_boundary_relax is false, set the radial boundary to the sheath potential?
   ///   - split_n0: bool, default false
@@ -82,30 +88,33 @@ struct Vorticity : public Component {
 
   void outputVars(Options &state) override;
 
-  // Save and restore potential phi
-  void restartVars(Options& state) override {
-    AUTO_TRACE();
-
-    // NOTE: This is a hack because we know that the loaded restart file
-    //       is passed into restartVars in PhysicsModel::postInit
-    // The restart value should be used in init() rather than here
-    static bool first = true;
-    if (first and state.isSet("phi")) {
-      first = false;
-      phi = state["phi"].as<Field3D>();
-    }
-
-    // Save the potential
-    set_with_attrs(state["phi"], phi,
-                   {{"long_name", "plasma potential"},
-                    {"source", "vorticity"}});
-  }
+  /// Time derivatives for convergence monitoring
+  void timeDerivs(Options &ddts) override;
+
+  /// Approximately invert the stiff parallel dissipation terms
+  /// (vort_dissipation, phi_dissipation and phi_sheath_dissipation)
+  /// along field lines. The phi solve is approximated locally using
+  /// the largest perpendicular wavenumber resolved on the grid.
+  void precon(const Options &state, BoutReal gamma) override;
+
+  /// Save potential phi, the previous solution used as the
+  /// initial guess, and the time of the last boundary relaxation.
+  /// phi is saved at the top level, as in older restart files
+  void saveState(Options& restart) override;
+
+  /// Restore state saved by saveState()
+  void loadState(const Options& restart) override;
 private:
+  std::string name; ///< Component name, used for the restart state section
+
   Field3D Vort; // Evolving vorticity
 
   Field3D phi; // Electrostatic potential
   std::unique_ptr<Laplacian> phiSolver; // Laplacian solver in X-Z
 
+  bool phi_warm_start; ///< Use the previous solution as initial guess?
+  Field3D phi_plus_pi_last; ///< Previous solution for phi + Pi_hat
+
   Field3D Pi_hat; ///< Contribution from ion pressure, weighted by atomic mass / charge
 
   bool exb_advection; // Include nonlinear ExB advection?
@@ -125,6 +134,9 @@ private:
   bool phi_sheath_dissipation; ///< Dissipation at the sheath if phi < 0
   bool damp_core_vorticity; ///< Damp axisymmetric component of vorticity
 
+  bool enable_precon; ///< Enable preconditioner?
+  std::unique_ptr<InvertParDiv> parallel_inv; ///< Field-line inversion for precon
+
   bool phi_boundary_relax; ///< Relax boundary to zero-gradient
   BoutReal phi_boundary_timescale; ///< Relaxation timescale [normalised]
   BoutReal phi_boundary_last_update; ///< Time when last updated
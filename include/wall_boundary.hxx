@@ -0,0 +1,65 @@
+#pragma once
+#ifndef WALL_BOUNDARY_H
+#define WALL_BOUNDARY_H
+
+#include <bout/field2d.hxx>
+#include <bout/region.hxx>
+
+#include <vector>
+
+class Mesh;
+
+/// A cell next to a target or wall boundary
+struct WallCell {
+  Ind3D i;     ///< Last cell in the domain
+  Ind3D guard; ///< Guard cell on the other side of the boundary
+  Ind3D inner; ///< Next cell into the domain, away from the boundary
+
+  /// +1 if the boundary is in the positive coordinate direction
+  /// from cell i, -1 if in the negative direction
+  int direction;
+
+  /// Area of the boundary face.
+  /// A flux through the face multiplied by area * inv_volume is the
+  /// rate of change in cell i.
+  BoutReal area;
+  BoutReal inv_volume; ///< 1 / volume of cell i
+
+  bool pump; ///< Is there a neutral pump on this boundary?
+};
+
+/// Cells next to the target (Y) and wall (X) boundaries on this
+/// processor, with the geometric factors needed to calculate fluxes
+/// through the boundaries.
+///
+/// This is created once when a component is created, so that the
+/// boundary cells and metric factors are not recalculated each time
+/// the component is used:
+///
+///     WallBoundary wall(mesh);
+///     ...
+///     for (const auto& cell : wall.lower_target) {
+///       energy_source[cell.i] -= heat_flux * cell.area * cell.inv_volume;
+///     }
+///
+/// At target boundaries the area is (J / sqrt(g_22)) averaged between
+/// cell i and the guard cell, and the volume is J * dy. At SOL and PFR
+/// walls the area is the poloidal and toroidal length of the cell face
+/// in metres, and the volume is J * dx * dy * dz.
+struct WallBoundary {
+  WallBoundary() = default;
+
+  /// Boundary cells with no neutral pumps
+  explicit WallBoundary(Mesh* mesh);
+
+  /// @param is_pump  Cells with is_pump = 1 on SOL or PFR walls are
+  ///                 marked as having a neutral pump
+  WallBoundary(Mesh* mesh, const Field2D& is_pump);
+
+  std::vector<WallCell> lower_target; ///< Lower Y sheath boundary
+  std::vector<WallCell> upper_target; ///< Upper Y sheath boundary
+  std::vector<WallCell> sol;          ///< Outer X (SOL) wall, including Y guard cells
+  std::vector<WallCell> pfr;          ///< Inner X wall, if not periodic in Y (PFR)
+};
+
+#endif // WALL_BOUNDARY_H
@@ -141,14 +141,20 @@ void OpenADAS::calculate_rates(Options& electron, Options& from_ion, Options& to
   const BoutReal to_charge =
       to_ion.isSet("charge") ? get<BoutReal>(to_ion["charge"]) : 0.0;
 
-  Field3D reaction_rate = cellAverage(
+  // Reaction rate and electron energy loss (radiation, ionisation potential)
+  // evaluated together, since they have the same inputs
+  auto rates = cellAverageMultiple(
       [&](BoutReal ne, BoutReal n1, BoutReal te) {
         // Note: densities can be (slightly) negative
-        return floor(ne, 0.0) * floor(n1, 0.0) *
-          rate_coef.evaluate(te * Tnorm, ne * Nnorm) * Nnorm / FreqNorm;
+        const BoutReal nn = floor(ne, 0.0) * floor(n1, 0.0) * Nnorm / FreqNorm;
+        return std::array<BoutReal, 2>{
+            nn * rate_coef.evaluate(te * Tnorm, ne * Nnorm),
+            nn * radiation_coef.evaluate(te * Tnorm, ne * Nnorm) / Tnorm};
       },
       Ne.getRegion("RGN_NOBNDRY"))(Ne, N1, Te);
 
+  Field3D reaction_rate = rates[0];
+
   // Particles
   subtract(from_ion["density_source"], reaction_rate);
   add(to_ion["density_source"], reaction_rate);
@@ -170,13 +176,7 @@ void OpenADAS::calculate_rates(Options& electron, Options& from_ion, Options& to
   add(to_ion["energy_source"], energy_exchange);
 
   // Electron energy loss (radiation, ionisation potential)
-  Field3D energy_loss = cellAverage(
-      [&](BoutReal ne, BoutReal n1, BoutReal te) {
-        return floor(ne, 0.0) * floor(n1, 0.0) *
-          radiation_coef.evaluate(te * Tnorm, ne * Nnorm) * Nnorm
-          / (Tnorm * FreqNorm);
-      },
-      Ne.getRegion("RGN_NOBNDRY"))(Ne, N1, Te);
+  Field3D energy_loss = rates[1];
 
   // Loss is reduced by heating
   energy_loss -= (electron_heating / Tnorm) * reaction_rate;
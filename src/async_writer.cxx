@@ -0,0 +1,151 @@
+#include "../include/async_writer.hxx"
+
+#include <bout/array.hxx>
+#include <bout/field2d.hxx>
+#include <bout/field3d.hxx>
+#include <bout/fieldperp.hxx>
+#include <bout/options_netcdf.hxx>
+#include <bout/output.hxx>
+#include <bout/utils.hxx>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+/// Copy the value of \p option if it shares data with other objects
+void copyValue(Options& option) {
+  auto& value = option.value;
+  if (bout::utils::holds_alternative<Field3D>(value)) {
+    value = copy(bout::utils::get<Field3D>(value));
+  } else if (bout::utils::holds_alternative<Field2D>(value)) {
+    value = copy(bout::utils::get<Field2D>(value));
+  } else if (bout::utils::holds_alternative<FieldPerp>(value)) {
+    value = copy(bout::utils::get<FieldPerp>(value));
+  } else if (bout::utils::holds_alternative<Array<BoutReal>>(value)) {
+    auto array = bout::utils::get<Array<BoutReal>>(value);
+    array.ensureUnique();
+    value = array;
+  } else if (bout::utils::holds_alternative<Matrix<BoutReal>>(value)) {
+    auto matrix = bout::utils::get<Matrix<BoutReal>>(value);
+    matrix.ensureUnique();
+    value = matrix;
+  } else if (bout::utils::holds_alternative<Tensor<BoutReal>>(value)) {
+    auto tensor = bout::utils::get<Tensor<BoutReal>>(value);
+    tensor.ensureUnique();
+    value = tensor;
+  }
+}
+
+void deepCopyValues(Options& options) {
+  for (const auto& kv : options.getChildren()) {
+    Options& child = options[kv.first];
+    if (child.isSection()) {
+      deepCopyValues(child);
+    } else if (child.isSet()) {
+      copyValue(child);
+    }
+  }
+}
+} // namespace
+
+Options deepCopy(const Options& options) {
+  Options result = options;
+  deepCopyValues(result);
+  return result;
+}
+
+AsyncWriter::AsyncWriter(std::string filename, bool append, std::size_t max_queue)
+    : filename(std::move(filename)), append(append), max_queue(std::max(max_queue, std::size_t{1})),
+      thread(&AsyncWriter::run, this) {}
+
+AsyncWriter::~AsyncWriter() {
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    // Write the remaining snapshots before stopping the thread
+    changed.wait(lock, [this] { return written == queue.size(); });
+    stop = true;
+    if (error) {
+      // Can't throw from a destructor, so report the error
+      try {
+        std::rethrow_exception(std::exchange(error, nullptr));
+      } catch (const std::exception& e) {
+        output_error.write("Error writing {}: {}\n", filename, e.what());
+      } catch (...) {
+        output_error.write("Unknown error writing {}\n", filename);
+      }
+    }
+  }
+  changed.notify_all();
+  thread.join();
+}
+
+void AsyncWriter::push(const Options& options) {
+  Options snapshot = deepCopy(options);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  // Back-pressure: wait for space in the queue
+  changed.wait(lock, [this] {
+    return error or (queue.size() - written < max_queue);
+  });
+  checkError();
+  removeWritten();
+
+  queue.push_back(std::move(snapshot));
+  lock.unlock();
+  changed.notify_all();
+}
+
+void AsyncWriter::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  changed.wait(lock, [this] { return error or (written == queue.size()); });
+  checkError();
+  removeWritten();
+}
+
+void AsyncWriter::removeWritten() {
+  while (written > 0) {
+    queue.pop_front();
+    --written;
+  }
+}
+
+void AsyncWriter::checkError() {
+  if (error) {
+    std::rethrow_exception(std::exchange(error, nullptr));
+  }
+}
+
+void AsyncWriter::run() {
+  // Replace the file on the first write, unless appending
+  bool first = true;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    changed.wait(lock, [this] { return stop or (written < queue.size()); });
+    if (written == queue.size()) {
+      return; // Stopping, and all snapshots have been written
+    }
+    // Snapshots are only added to the back, and only removed from the
+    // front once written, so this reference stays valid while unlocked
+    const Options& snapshot = queue[written];
+    lock.unlock();
+
+    std::exception_ptr write_error;
+    try {
+      bout::OptionsNetCDF file(filename, (first and !append)
+                                             ? bout::OptionsNetCDF::FileMode::replace
+                                             : bout::OptionsNetCDF::FileMode::append);
+      file.write(snapshot, "t");
+      first = false;
+    } catch (...) {
+      write_error = std::current_exception();
+    }
+
+    lock.lock();
+    if (write_error) {
+      error = write_error;
+    }
+    ++written;
+    changed.notify_all();
+  }
+}
@@ -0,0 +1,178 @@
+#include "../include/balance_diagnostics.hxx"
+
+#include <bout/constants.hxx>
+#include <bout/coordinates.hxx>
+#include <bout/mesh.hxx>
+#include <bout/utils.hxx> // for trim, strsplit
+
+using bout::globals::mesh;
+
+BalanceDiagnostics::BalanceDiagnostics(std::string name, Options& alloptions, Solver*) {
+  AUTO_TRACE();
+
+  Options& options = alloptions[name];
+
+  for (const auto& species : strsplit(options["species"]
+                                          .doc("Comma-separated list of species. "
+                                               "Default is all species")
+                                          .withDefault<std::string>(""),
+                                      ',')) {
+    const std::string species_name = trim(species, " \t\r()");
+    if (!species_name.empty()) {
+      species_list.push_back(species_name);
+    }
+  }
+
+  wall = WallBoundary(mesh);
+
+  Coordinates* coord = mesh->getCoordinates();
+  cell_volume = coord->J * coord->dx * coord->dy * coord->dz;
+}
+
+void BalanceDiagnostics::transform(Options& state) {
+  AUTO_TRACE();
+
+  if (!isOutputStep(state)) {
+    return; // Only needed for output
+  }
+
+  integrals.clear();
+
+  std::vector<std::string> names = species_list;
+  if (names.empty()) {
+    for (const auto& kv : state["species"].getChildren()) {
+      names.push_back(kv.first);
+    }
+  }
+
+  Coordinates* coord = mesh->getCoordinates();
+
+  const std::vector<std::pair<std::string, const std::vector<WallCell>*>> targets = {
+      {"lower_target", &wall.lower_target}, {"upper_target", &wall.upper_target}};
+  const std::vector<std::pair<std::string, const std::vector<WallCell>*>> walls = {
+      {"sol", &wall.sol}, {"pfr", &wall.pfr}};
+
+  // SOL and PFR cell lists include the Y guard cells
+  auto inDomain = [](const WallCell& cell) {
+    return (cell.i.y() >= mesh->ystart) and (cell.i.y() <= mesh->yend);
+  };
+
+  for (const auto& species_name : names) {
+    const Options& species = state["species"][species_name];
+
+    // Volume integral of a source, and integrals over cells next to boundaries
+    auto integrateSource = [&](const std::string& source, const std::string& prefix,
+                               bool energy, const std::string& description) {
+      if (!species.isSet(source)) {
+        return;
+      }
+      const Field3D S = getNonFinal<Field3D>(species[source]);
+
+      BoutReal total = 0.0;
+      BOUT_FOR_SERIAL(i, S.getRegion("RGN_NOBNDRY")) { total += S[i] * cell_volume[i]; }
+      integrals.push_back({prefix + species_name + "_int",
+                           description + " of " + species_name, energy, total});
+
+      for (const auto& regions : {targets, walls}) {
+        for (const auto& region : regions) {
+          BoutReal sum = 0.0;
+          for (const auto& cell : *region.second) {
+            if (inDomain(cell)) {
+              sum += S[cell.i] * cell_volume[cell.i];
+            }
+          }
+          integrals.push_back({prefix + species_name + "_" + region.first + "_int",
+                               description + " of " + species_name + " next to "
+                                   + region.first,
+                               energy, sum});
+        }
+      }
+    };
+
+    integrateSource("density_source", "S", false, "Integrated particle source");
+    integrateSource("energy_source", "E", true, "Integrated energy source");
+
+    // Particle flow into the targets, from the values at the sheath
+    if (species.isSet("density") and species.isSet("velocity")) {
+      const Field3D N = getNonFinal<Field3D>(species["density"]);
+      const Field3D V = getNonFinal<Field3D>(species["velocity"]);
+
+      for (const auto& region : targets) {
+        BoutReal sum = 0.0;
+        for (const auto& cell : *region.second) {
+          const auto& i = cell.i;
+          const auto& ig = cell.guard;
+          sum += cell.direction * 0.5 * (N[i] + N[ig]) * 0.5 * (V[i] + V[ig]) * cell.area
+                 * coord->dx[i] * coord->dz[i];
+        }
+        integrals.push_back({"F" + species_name + "_" + region.first,
+                             "Particle flow of " + species_name + " into "
+                                 + region.first,
+                             false, sum});
+      }
+    }
+
+    // Flows through cell faces into the targets and walls. Flows are
+    // positive in the positive coordinate direction, and stored at the
+    // lower face of each cell
+    auto boundaryFlow = [&](const std::string& flow_name, const auto& regions,
+                            const std::string& prefix, bool energy,
+                            const std::string& description) {
+      if (!species.isSet(flow_name)) {
+        return;
+      }
+      const Field3D flow = getNonFinal<Field3D>(species[flow_name]);
+
+      for (const auto& region : regions) {
+        BoutReal sum = 0.0;
+        for (const auto& cell : *region.second) {
+          if (inDomain(cell)) {
+            sum += cell.direction * flow[(cell.direction > 0) ? cell.guard : cell.i];
+          }
+        }
+        integrals.push_back({prefix + species_name + "_" + region.first,
+                             description + " of " + species_name + " into "
+                                 + region.first,
+                             energy, sum});
+      }
+    };
+
+    // Heat flow into the targets, set by the sheath components
+    boundaryFlow("energy_flow_ylow", targets, "Q", true, "Energy flow");
+
+    // Radial flows into the walls
+    boundaryFlow("particle_flow_xlow", walls, "F", false, "Particle flow");
+    boundaryFlow("energy_flow_xlow", walls, "Q", true, "Energy flow");
+  }
+}
+
+void BalanceDiagnostics::outputVars(Options& state) {
+  AUTO_TRACE();
+
+  // Normalisations
+  auto Nnorm = get<BoutReal>(state["Nnorm"]);
+  auto Tnorm = get<BoutReal>(state["Tnorm"]);
+  auto Omega_ci = get<BoutReal>(state["Omega_ci"]);
+  auto rho_s0 = get<BoutReal>(state["rho_s0"]);
+
+  const BoutReal volume_norm = rho_s0 * rho_s0 * rho_s0;
+  const BoutReal Pnorm = SI::qe * Tnorm * Nnorm; // Pressure normalisation
+
+  // Sum over all processors. Only done here, rather than in every transform
+  std::vector<BoutReal> local, global(integrals.size());
+  for (const auto& integral : integrals) {
+    local.push_back(integral.value);
+  }
+  MPI_Allreduce(local.data(), global.data(), static_cast<int>(local.size()), MPI_DOUBLE,
+                MPI_SUM, BoutComm::get());
+
+  for (std::size_t i = 0; i < integrals.size(); ++i) {
+    const auto& integral = integrals[i];
+    set_with_attrs(state[integral.name], global[i],
+                   {{"time_dimension", "t"},
+                    {"units", integral.energy ? "W" : "s^-1"},
+                    {"conversion", (integral.energy ? Pnorm : Nnorm) * Omega_ci * volume_norm},
+                    {"long_name", integral.long_name},
+                    {"source", "balance_diagnostics"}});
+  }
+}
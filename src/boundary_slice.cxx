@@ -0,0 +1,86 @@
+#include "../include/boundary_slice.hxx"
+
+#include <bout/mesh.hxx>
+
+#include <algorithm>
+
+BoundarySlice::BoundarySlice(BoutReal value) : BoundarySlice(bout::globals::mesh, value) {}
+
+BoundarySlice::BoundarySlice(Mesh* mesh, BoutReal value)
+    : localmesh(mesh), nz(mesh->LocalNz), ystart(mesh->ystart),
+      // If there are only a few cells in y then the lower and upper
+      // planes overlap. Each plane is only stored once.
+      upper_first(std::max(mesh->yend - 1, mesh->ystart + 2)),
+      nplanes(3 + mesh->yend + 2 - upper_first),
+      data(mesh->LocalNx * nplanes * nz, value) {}
+
+BoundarySlice::BoundarySlice(const Field3D& f) : BoundarySlice(f.getMesh(), 0.0) {
+  const std::string rgn = region(localmesh);
+
+  // Only the planes in the region are shifted
+  const Field3D aligned =
+      (f.getDirectionY() == YDirectionType::Aligned) ? f : toFieldAligned(f, rgn);
+
+  BOUT_FOR_SERIAL(i, localmesh->getRegion2D(rgn)) {
+    const BoutReal* values = &aligned(i, 0);
+    std::copy(values, values + nz, &data[offset(i.x(), i.y())]);
+  }
+}
+
+Field3D BoundarySlice::scatter(const Field3D& f) const {
+  const std::string rgn = region(localmesh);
+  Field3D result = copy(f);
+
+  if (f.getDirectionY() == YDirectionType::Aligned) {
+    BOUT_FOR_SERIAL(i, localmesh->getRegion2D(rgn)) {
+      const BoutReal* values = &data[offset(i.x(), i.y())];
+      std::copy(values, values + nz, &result(i, 0));
+    }
+    return result;
+  }
+
+  // Put values into field-aligned planes, then shift only those planes
+  Field3D aligned{emptyFrom(f)};
+  aligned.setDirectionY(YDirectionType::Aligned);
+  BOUT_FOR_SERIAL(i, localmesh->getRegion2D(rgn)) {
+    const BoutReal* values = &data[offset(i.x(), i.y())];
+    std::copy(values, values + nz, &aligned(i, 0));
+  }
+
+  const Field3D shifted = fromFieldAligned(aligned, rgn);
+  BOUT_FOR_SERIAL(i, localmesh->getRegion2D(rgn)) {
+    const BoutReal* values = &shifted(i, 0);
+    std::copy(values, values + nz, &result(i, 0));
+  }
+  return result;
+}
+
+std::string BoundarySlice::region(Mesh* mesh) {
+  const std::string name = "RGN_SHEATH_SLICE";
+  if (mesh->hasRegion2D(name)) {
+    return name;
+  }
+
+  // Mark the (x, y) planes next to target boundaries
+  const int ny = mesh->LocalNy;
+  std::vector<bool> in_region(mesh->LocalNx * ny, false);
+  for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
+    for (int y = mesh->ystart - 1; y <= mesh->ystart + 1; y++) {
+      in_region[r.ind * ny + y] = true;
+    }
+  }
+  for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
+    for (int y = mesh->yend - 1; y <= mesh->yend + 1; y++) {
+      in_region[r.ind * ny + y] = true;
+    }
+  }
+
+  Region<Ind2D>::RegionIndices indices;
+  for (int ind = 0; ind < static_cast<int>(in_region.size()); ind++) {
+    if (in_region[ind]) {
+      indices.emplace_back(ind, ny, 1);
+    }
+  }
+  mesh->addRegion2D(name, Region<Ind2D>(indices));
+  return name;
+}
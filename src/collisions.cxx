@@ -1,7 +1,9 @@
 #include <iterator>
+#include <map>
 
 #include <bout/constants.hxx>
 #include <bout/output_bout_types.hxx>
+#include <bout/utils.hxx> // for trim, strsplit
 
 #include "../include/collisions.hxx"
 
@@ -11,6 +13,71 @@ BoutReal floor(BoutReal value, BoutReal min) {
     return min;
   return value;
 }
+
+/// Quantities derived from a species' density and temperature which
+/// are used in several collision pairs. These are calculated once per
+/// species in each call to Collisions::transform, and shared between pairs.
+struct CollisionSpecies {
+  /// @param species  The species state
+  /// @param mass     Species mass [kg]
+  /// @param charged  Calculate quantities needed for Coulomb collisions?
+  /// @param Tnorm    Temperature normalisation [eV]
+  /// @param Nnorm    Density normalisation [m^-3]
+  CollisionSpecies(Options& species, BoutReal mass, bool charged, BoutReal Tnorm,
+                   BoutReal Nnorm) {
+    // If temperature isn't set, assume zero. in eV
+    temperature = species.isSet("temperature")
+                      ? GET_NOBOUNDARY(Field3D, species["temperature"]) * Tnorm
+                      : 0.0;
+    density = GET_NOBOUNDARY(Field3D, species["density"]) * Nnorm;
+
+    vth_norm_sq = temperature * (SI::Mp / (mass * Tnorm));
+
+    if (!charged) {
+      return;
+    }
+
+    const BoutReal Z = species.isSet("charge") ? get<BoutReal>(species["charge"]) : 1.0;
+
+    temperature_lim = emptyFrom(density);
+    density_lim = emptyFrom(density);
+    log_temperature = emptyFrom(density);
+    log_density = emptyFrom(density);
+    vsq = emptyFrom(density);
+    NZsq_T = emptyFrom(density);
+
+    BOUT_FOR(i, density.getRegion("RGN_ALL")) {
+      const BoutReal Tlim = floor(temperature[i], 0.1);
+      const BoutReal Nlim = floor(density[i], 1e10);
+      temperature_lim[i] = Tlim;
+      density_lim[i] = Nlim;
+      log_temperature[i] = log(Tlim);
+      log_density[i] = log(Nlim);
+      vsq[i] = 2 * Tlim * SI::qe / mass;
+      NZsq_T[i] = Nlim * SQ(Z) / Tlim;
+    }
+  }
+
+  Field3D temperature; ///< Temperature [eV]. Zero if not set
+  Field3D density;     ///< Density [m^-3]
+  Field3D vth_norm_sq; ///< Normalised thermal speed squared: T / (Tnorm * A)
+
+  // Only calculated for charged species
+  Field3D temperature_lim; ///< Temperature [eV] floored at 0.1eV
+  Field3D density_lim;     ///< Density [m^-3] floored at 1e10
+  Field3D log_temperature; ///< log(temperature_lim)
+  Field3D log_density;     ///< log(density_lim)
+  Field3D vsq;             ///< Thermal speed squared 2 T / m [m^2/s^2]
+  Field3D NZsq_T;          ///< N Z^2 / T, used in the ion-ion Coulomb logarithm
+};
+
+/// Return a reference to the accumulator field, allocating and zeroing if needed
+Field3D& accumulator(Field3D& field, const Field3D& like) {
+  if (!field.isAllocated()) {
+    field = zeroFrom(like);
+  }
+  return field;
+}
 } // namespace
 
 Collisions::Collisions(std::string name, Options& alloptions, Solver*) {
@@ -50,99 +117,183 @@ Collisions::Collisions(std::string name, Options& alloptions, Solver*) {
 
   diagnose =
       options["diagnose"].doc("Output additional diagnostics?").withDefault<bool>(false);
+
+  precon_coupling = alloptions["hermes"]["block_precon"].withDefault<bool>(false);
+
+  for (const auto& pair : strsplit(options["pairwise_rates"]
+                                       .doc("Collision frequencies species1:species2 to "
+                                            "set in the state. Comma separated")
+                                       .withDefault<std::string>(""),
+                                   ',')) {
+    const auto trimmed = trim(pair, " \t\r");
+    if (trimmed.empty()) {
+      continue;
+    }
+    const auto names = strsplit(trimmed, ':');
+    if (names.size() != 2) {
+      throw BoutException("Collisions: Expected pairwise_rates of the form "
+                          "'species1:species2' but got '{}'",
+                          trimmed);
+    }
+    pairwise_rates.emplace(trim(names.front(), " \t\r"), trim(names.back(), " \t\r"));
+  }
+}
+
+void Collisions::storeRate(Options& species1, const Options& species2,
+                           const Field3D& nu_12) {
+  if (diagnose_now) {
+    set(collision_rates[species1.name()][species2.name()], nu_12);
+  }
+  if (pairwise_rates.count({species1.name(), species2.name()}) != 0) {
+    set(species1["collision_frequencies"][species2.name()], nu_12);
+  }
+}
+
+bool Collisions::needRate(const Options& species1, const Options& species2) const {
+  return diagnose_now or (pairwise_rates.count({species1.name(), species2.name()}) != 0);
 }
 
 /// Calculate transfer of momentum and energy between species1 and species2
 /// nu_12    normalised frequency
 ///
-/// Modifies
+/// Accumulates in sources, to be added to the state at the end of transform
 ///   species1 and species2
 ///     - collision_frequency
 ///     - momentum_source   if species1 or species2 velocity is set
 ///     - energy_source     if species1 or species2 temperature is set
 ///                         or velocity is set and frictional_heating
 ///
+/// Contributions from a pair are calculated in a single loop over cells,
+/// so each cell is only updated by one thread and the result doesn't
+/// depend on the number of threads.
+///
 /// Note: A* variables are used for atomic mass numbers;
 ///       mass* variables are species masses in kg
 void Collisions::collide(Options& species1, Options& species2, const Field3D& nu_12, BoutReal momentum_coefficient) {
   AUTO_TRACE();
 
-  add(species1["collision_frequency"], nu_12);
-  set(collision_rates[species1.name()][species2.name()], nu_12);
+  CollisionSources& sources1 = sources[species1.name()];
+
+  accumulator(sources1.collision_frequency, nu_12) += nu_12;
+  storeRate(species1, species2, nu_12);
 
   if (&species1 != &species2) {
     // For collisions between different species
     // m_a n_a \nu_{ab} = m_b n_b \nu_{ba}
 
+    CollisionSources& sources2 = sources[species2.name()];
+
     const BoutReal A1 = get<BoutReal>(species1["AA"]);
     const BoutReal A2 = get<BoutReal>(species2["AA"]);
 
     const Field3D density1 = GET_NOBOUNDARY(Field3D, species1["density"]);
     const Field3D density2 = GET_NOBOUNDARY(Field3D, species2["density"]);
 
-    const Field3D nu = filledFrom(nu_12, [&](auto& i) {
-      return nu_12[i] * (A1 / A2) * density1[i] / floor(density2[i], 1e-5);
-    });
+    // Momentum exchange
+    const bool momentum_exchange = isSetFinalNoBoundary(species1["velocity"])
+                                   or isSetFinalNoBoundary(species2["velocity"]);
 
-    add(species2["collision_frequency"], nu);
-    set(collision_rates[species2.name()][species1.name()], nu);
+    const Field3D velocity1 = (momentum_exchange and species1.isSet("velocity"))
+                                  ? GET_NOBOUNDARY(Field3D, species1["velocity"])
+                                  : 0.0;
+    const Field3D velocity2 = (momentum_exchange and species2.isSet("velocity"))
+                                  ? GET_NOBOUNDARY(Field3D, species2["velocity"])
+                                  : 0.0;
 
-    // Momentum exchange
-    if (isSetFinalNoBoundary(species1["velocity"]) or
-        isSetFinalNoBoundary(species2["velocity"])) {
-
-      const Field3D velocity1 = species1.isSet("velocity")
-                                    ? GET_NOBOUNDARY(Field3D, species1["velocity"])
-                                    : 0.0;
-      const Field3D velocity2 = species2.isSet("velocity")
-                                    ? GET_NOBOUNDARY(Field3D, species2["velocity"])
-                                    : 0.0;
-
-      // F12 is the force on species 1 due to species 2 (normalised)
-      const Field3D F12 = nu_12 * A1 * density1 * (velocity2 - velocity1);
-
-      add(species1["momentum_source"], F12);
-      subtract(species2["momentum_source"], F12);
-
-      if (frictional_heating) {
-        // Heating due to friction and energy transfer
-        //
-        // In the pressure (thermal energy) equation we have a term
-        // that transfers translational kinetic energy to thermal
-        // energy, and an energy transfer between species:
-        //
-        // d/dt(3/2p_1) = ...  - F_12 v_1 + W_12
-        //
-        // The energy transfer term W_12 is chosen to make the
-        // pressure change frame invariant:
-        //
-        // W_12 = (m_1 v_1 + m_2 v_2) / (m_1 + m_2) * F_12
-        //
-        // The sum of these two terms is:
-        //
-        // - F_12 v_1 + W_12 = m_2 (v_2  - v_1) / (m_1 + m_2) * F_12
-        //
-        // Note:
-        //  1) This term is always positive: Collisions don't lead to cooling
-        //  2) In the limit that m_2 << m_1 (e.g. electron-ion collisions),
-        //     the lighter species is heated more than the heavy species.
-        add(species1["energy_source"], (A2 / (A1 + A2)) * (velocity2 - velocity1) * F12);
-        add(species2["energy_source"], (A1 / (A1 + A2)) * (velocity2 - velocity1) * F12);
-      }
+    // Energy exchange
+    const bool energy_exchange =
+        species1.isSet("temperature") or species2.isSet("temperature");
+
+    const Field3D temperature1 =
+        energy_exchange ? GET_NOBOUNDARY(Field3D, species1["temperature"]) : 0.0;
+    const Field3D temperature2 =
+        energy_exchange ? GET_NOBOUNDARY(Field3D, species2["temperature"]) : 0.0;
+
+    const bool heating = momentum_exchange and frictional_heating;
+
+    // Only allocate nu_21 if it is needed after this function
+    const bool keep_nu = needRate(species2, species1);
+    Field3D nu;
+    if (keep_nu) {
+      nu = emptyFrom(nu_12);
     }
+    Field3D& frequency2 = accumulator(sources2.collision_frequency, nu_12);
+
+    // Only allocate sources which will be modified
+    Field3D* momentum1 =
+        momentum_exchange ? &accumulator(sources1.momentum_source, nu_12) : nullptr;
+    Field3D* momentum2 =
+        momentum_exchange ? &accumulator(sources2.momentum_source, nu_12) : nullptr;
+    Field3D* energy1 = (heating or energy_exchange)
+                           ? &accumulator(sources1.energy_source, nu_12)
+                           : nullptr;
+    Field3D* energy2 = (heating or energy_exchange)
+                           ? &accumulator(sources2.energy_source, nu_12)
+                           : nullptr;
+
+    BOUT_FOR(i, nu_12.getRegion("RGN_ALL")) {
+      const BoutReal nu_21 = nu_12[i] * (A1 / A2) * density1[i] / floor(density2[i], 1e-5);
+      if (keep_nu) {
+        nu[i] = nu_21;
+      }
+      frequency2[i] += nu_21;
 
-    // Energy exchange
-    if (species1.isSet("temperature") or species2.isSet("temperature")) {
-      // Q12 is heat transferred to species2 (normalised)
+      if (momentum_exchange) {
+        // F12 is the force on species 1 due to species 2 (normalised)
+        const BoutReal dv = velocity2[i] - velocity1[i];
+        const BoutReal F12 = nu_12[i] * A1 * density1[i] * dv;
+
+        (*momentum1)[i] += F12;
+        (*momentum2)[i] -= F12;
+
+        if (heating) {
+          // Heating due to friction and energy transfer
+          //
+          // In the pressure (thermal energy) equation we have a term
+          // that transfers translational kinetic energy to thermal
+          // energy, and an energy transfer between species:
+          //
+          // d/dt(3/2p_1) = ...  - F_12 v_1 + W_12
+          //
+          // The energy transfer term W_12 is chosen to make the
+          // pressure change frame invariant:
+          //
+          // W_12 = (m_1 v_1 + m_2 v_2) / (m_1 + m_2) * F_12
+          //
+          // The sum of these two terms is:
+          //
+          // - F_12 v_1 + W_12 = m_2 (v_2  - v_1) / (m_1 + m_2) * F_12
+          //
+          // Note:
+          //  1) This term is always positive: Collisions don't lead to cooling
+          //  2) In the limit that m_2 << m_1 (e.g. electron-ion collisions),
+          //     the lighter species is heated more than the heavy species.
+          (*energy1)[i] += (A2 / (A1 + A2)) * dv * F12;
+          (*energy2)[i] += (A1 / (A1 + A2)) * dv * F12;
+        }
+      }
 
-      const Field3D temperature1 = GET_NOBOUNDARY(Field3D, species1["temperature"]);
-      const Field3D temperature2 = GET_NOBOUNDARY(Field3D, species2["temperature"]);
+      if (energy_exchange) {
+        // Q12 is heat transferred to species2 (normalised)
+        const BoutReal Q12 =
+            nu_12[i] * 3. * density1[i] * (A1 / (A1 + A2)) * (temperature2[i] - temperature1[i]);
 
-      const Field3D Q12 =
-          nu_12 * 3. * density1 * (A1 / (A1 + A2)) * (temperature2 - temperature1);
+        (*energy1)[i] += Q12;
+        (*energy2)[i] -= Q12;
+      }
+    }
 
-      add(species1["energy_source"], Q12);
-      subtract(species2["energy_source"], Q12);
+    if (energy_exchange and precon_coupling) {
+      // Derivative of Q12 with respect to temperature
+      const Field3D dQ12 = nu_12 * 3. * density1 * (A1 / (A1 + A2));
+      accumulator(sources1.energy_coupling[species2.name()], nu_12) += dQ12;
+      accumulator(sources1.energy_coupling[species1.name()], nu_12) -= dQ12;
+      accumulator(sources2.energy_coupling[species1.name()], nu_12) += dQ12;
+      accumulator(sources2.energy_coupling[species2.name()], nu_12) -= dQ12;
+    }
+
+    if (keep_nu) {
+      storeRate(species2, species1, nu);
     }
   }
 }
@@ -152,14 +303,37 @@ void Collisions::transform(Options& state) {
 
   Options& allspecies = state["species"];
 
+  sources.clear();
+
+  // Only store rates for output when they will be written
+  diagnose_now = diagnose and isOutputStep(state);
+
+  // Derived quantities for each species, calculated on first use
+  // and then shared between all collision pairs involving that species
+  std::map<std::string, CollisionSpecies> cache;
+  auto speciesData = [&](const std::string& name, BoutReal mass) -> const CollisionSpecies& {
+    auto it = cache.find(name);
+    if (it == cache.end()) {
+      Options& species = allspecies[name];
+      const bool charged = (name == "e")
+                           or (species.isSet("charge")
+                               and (get<BoutReal>(species["charge"]) != 0.0));
+      it = cache.emplace(name, CollisionSpecies(species, mass, charged, Tnorm, Nnorm)).first;
+    }
+    return it->second;
+  };
+
   // Treat electron collisions specially
   // electron-ion and electron-neutral collisions
 
   if (allspecies.isSection("e")) {
     Options& electrons = allspecies["e"];
-    const Field3D Te = GET_NOBOUNDARY(Field3D, electrons["temperature"]) * Tnorm; // eV
-    const Field3D Ne = GET_NOBOUNDARY(Field3D, electrons["density"]) * Nnorm;     // In m^-3
-    
+    const CollisionSpecies& edata = speciesData("e", SI::Me);
+    const Field3D& Ne = edata.density;       // In m^-3
+    const Field3D& logTe = edata.log_temperature;
+    const Field3D& logNe = edata.log_density;
+    const Field3D& vesq = edata.vsq;
+
     for (auto& kv : allspecies.getChildren()) {
       if (kv.first == "e") {
         ////////////////////////////////////
@@ -169,20 +343,17 @@ void Collisions::transform(Options& state) {
           continue;
 
         const Field3D nu_ee = filledFrom(Ne, [&](auto& i) {
-          const BoutReal Telim = floor(Te[i], 0.1);
-          const BoutReal Nelim = floor(Ne[i], 1e10);
-          const BoutReal logTe = log(Telim);
           // From NRL formulary 2019, page 34
           // Coefficient 30.4 from converting cm^-3 to m^-3
           // Note that this breaks when coulomb_log falls below 1
-          const BoutReal coulomb_log = 30.4 - 0.5 * log(Nelim) + (5. / 4) * logTe
-                                       - sqrt(1e-5 + SQ(logTe - 2) / 16.);
+          const BoutReal coulomb_log = 30.4 - 0.5 * logNe[i] + (5. / 4) * logTe[i]
+                                       - sqrt(1e-5 + SQ(logTe[i] - 2) / 16.);
 
-          const BoutReal v1sq = 2 * Telim * SI::qe / SI::Me;
+          const BoutReal vsum = PI * 2 * vesq[i];
 
           // Collision frequency
           const BoutReal nu = SQ(SQ(SI::qe)) * floor(Ne[i], 0.0) * floor(coulomb_log, 1.0)
-                              * 2 / (3 * pow(PI * 2 * v1sq, 1.5) * SQ(SI::e0 * SI::Me));
+                              * 2 / (3 * vsum * sqrt(vsum) * SQ(SI::e0 * SI::Me));
 
           ASSERT2(std::isfinite(nu));
           return nu;
@@ -201,37 +372,45 @@ void Collisions::transform(Options& state) {
         if (!electron_ion)
           continue;
 
-        const Field3D Ti = GET_NOBOUNDARY(Field3D, species["temperature"]) * Tnorm; // eV
-        const Field3D Ni = GET_NOBOUNDARY(Field3D, species["density"]) * Nnorm;     // In m^-3
-
         const BoutReal Zi = get<BoutReal>(species["charge"]);
         const BoutReal Ai = get<BoutReal>(species["AA"]);
         const BoutReal me_mi = SI::Me / (SI::Mp * Ai); // m_e / m_i
 
+        const CollisionSpecies& idata = speciesData(kv.first, SI::Mp * Ai);
+        const Field3D& Ti = idata.temperature; // eV
+        const Field3D& Ni = idata.density;     // In m^-3
+        const Field3D& logTi = idata.log_temperature;
+        const Field3D& logNi = idata.log_density;
+        const Field3D& visq = idata.vsq;
+
+        // Pair constants in the Coulomb logarithm
+        const BoutReal log_Zsq_Ai = log(SQ(Zi) * Ai);
+        const BoutReal log_Zi = log(Zi);
+
         const Field3D nu_ei = filledFrom(Ne, [&](auto& i) {
           // NRL formulary 2019, page 34
+          // Note: When Te >= 0.1 and Ni, Ne >= 1e10 the floored logarithms
+          //       are equal to the logarithms of the unlimited values.
           const BoutReal coulomb_log =
-              ((Te[i] < 0.1) || (Ni[i] < 1e10) || (Ne[i] < 1e10)) ? 10
-              : (Te[i] < Ti[i] * me_mi)
-                  ? 23 - 0.5 * log(Ni[i]) + 1.5 * log(Ti[i]) - log(SQ(Zi) * Ai)
-              : (Te[i] < 10 * SQ(Zi))
+              ((edata.temperature[i] < 0.1) || (Ni[i] < 1e10) || (Ne[i] < 1e10)) ? 10
+              : (edata.temperature[i] < Ti[i] * me_mi)
+                  ? 23 - 0.5 * logNi[i] + 1.5 * logTi[i] - log_Zsq_Ai
+              : (edata.temperature[i] < 10 * SQ(Zi))
                   // Ti m_e/m_i < Te < 10 Z^2
-                  ? 30.0 - 0.5 * log(Ne[i]) - log(Zi) + 1.5 * log(Te[i])
+                  ? 30.0 - 0.5 * logNe[i] - log_Zi + 1.5 * logTe[i]
                   // Ti m_e/m_i < 10 Z^2 < Te
-                  : 31.0 - 0.5 * log(Ne[i]) + log(Te[i]);
+                  : 31.0 - 0.5 * logNe[i] + logTe[i];
 
-          // Calculate v_a^2, v_b^2
-          const BoutReal vesq = 2 * floor(Te[i], 0.1) * SI::qe / SI::Me;
-          const BoutReal visq = 2 * floor(Ti[i], 0.1) * SI::qe / (SI::Mp * Ai);
+          const BoutReal vsum = PI * (vesq[i] + visq[i]);
 
           // Collision frequency
           const BoutReal nu = SQ(SQ(SI::qe) * Zi) * floor(Ni[i], 0.0)
                               * floor(coulomb_log, 1.0) * (1. + me_mi)
-                              / (3 * pow(PI * (vesq + visq), 1.5) * SQ(SI::e0 * SI::Me));
+                              / (3 * vsum * sqrt(vsum) * SQ(SI::e0 * SI::Me));
 #if CHECK >= 2
 	  if (!std::isfinite(nu)) {
-	    throw BoutException("Collisions 195 {}: {} at {}: Ni {}, Ne {}, Clog {}, vesq {}, visq {}, Te {}, Ti {}\n",
-                                kv.first, nu, i, Ni[i], Ne[i], coulomb_log, vesq, visq, Te[i], Ti[i]);
+	    throw BoutException("Collisions {}: {} at {}: Ni {}, Ne {}, Clog {}, vesq {}, visq {}, Te {}, Ti {}\n",
+                                kv.first, nu, i, Ni[i], Ne[i], coulomb_log, vesq[i], visq[i], edata.temperature[i], Ti[i]);
 	  }
 #endif
           return nu;
@@ -268,12 +447,12 @@ void Collisions::transform(Options& state) {
 
         BoutReal a0 = 5e-19; // Cross-section [m^2]
 
-        const Field3D nu_en = filledFrom(Ne, [&](auto& i) {
-          // Electron thermal speed (normalised)
-          const BoutReal vth_e = sqrt((SI::Mp / SI::Me) * Te[i] / Tnorm);
+        // Electron thermal speed squared (normalised)
+        const Field3D& vth_e_sq = edata.vth_norm_sq;
 
+        const Field3D nu_en = filledFrom(Ne, [&](auto& i) {
           // Electron-neutral collision rate
-          return vth_e * Nnorm * Nn[i] * a0 * rho_s0;
+          return sqrt(vth_e_sq[i]) * Nnorm * Nn[i] * a0 * rho_s0;
         });
 
         collide(electrons, species, nu_en, 1.0);
@@ -300,17 +479,11 @@ void Collisions::transform(Options& state) {
 
     Options& species1 = allspecies[kv1->first];
 
-    // If temperature isn't set, assume zero. in eV
-    const Field3D temperature1 =
-        species1.isSet("temperature")
-            ? GET_NOBOUNDARY(Field3D, species1["temperature"]) * Tnorm
-            : 0.0;
-
-    const Field3D density1 = GET_NOBOUNDARY(Field3D, species1["density"]) * Nnorm;
-
     const BoutReal AA1 = get<BoutReal>(species1["AA"]);
     const BoutReal mass1 = AA1 * SI::Mp; // in Kg
 
+    const CollisionSpecies& data1 = speciesData(kv1->first, mass1);
+
     if (species1.isSet("charge") and (get<BoutReal>(species1["charge"]) != 0.0)) {
       // Charged species
       const BoutReal Z1 = get<BoutReal>(species1["charge"]);
@@ -327,17 +500,11 @@ void Collisions::transform(Options& state) {
 
         // Note: Here species1 could be equal to species2
 
-        // If temperature isn't set, assume zero. in eV
-        const Field3D temperature2 =
-            species2.isSet("temperature")
-                ? GET_NOBOUNDARY(Field3D, species2["temperature"]) * Tnorm
-                : 0.0;
-
-        const Field3D density2 = GET_NOBOUNDARY(Field3D, species2["density"]) * Nnorm;
-
         const BoutReal AA2 = get<BoutReal>(species2["AA"]);
         const BoutReal mass2 = AA2 * SI::Mp; // in Kg
 
+        const CollisionSpecies& data2 = speciesData(kv2->first, mass2);
+
         if (species2.isSet("charge") and (get<BoutReal>(species2["charge"]) != 0.0)) {
           //////////////////////////////
           // Both charged species
@@ -348,28 +515,29 @@ void Collisions::transform(Options& state) {
           const BoutReal Z2 = get<BoutReal>(species2["charge"]);
           const BoutReal charge2 = Z2 * SI::qe; // in Coulombs
 
-          // Ion-ion collisions
-          Field3D nu_12 = filledFrom(density1, [&](auto& i) {
-            const BoutReal Tlim1 = floor(temperature1[i], 0.1);
-            const BoutReal Tlim2 = floor(temperature2[i], 0.1);
+          const Field3D& Tlim1 = data1.temperature_lim;
+          const Field3D& Tlim2 = data2.temperature_lim;
+          const Field3D& v1sq = data1.vsq;
+          const Field3D& v2sq = data2.vsq;
 
-            const BoutReal Nlim1 = floor(density1[i], 1e10);
-            const BoutReal Nlim2 = floor(density2[i], 1e10);
+          // Pair constants
+          const BoutReal Z12 = Z1 * Z2 * (AA1 + AA2);
+          const BoutReal coefficient =
+              SQ(charge1 * charge2) * (1. + mass1 / mass2) / (3 * SQ(SI::e0 * mass1));
 
+          // Ion-ion collisions
+          Field3D nu_12 = filledFrom(data1.density, [&](auto& i) {
             // Coulomb logarithm
             BoutReal coulomb_log =
                 29.91
-                - log((Z1 * Z2 * (AA1 + AA2)) / (AA1 * Tlim2 + AA2 * Tlim1)
-                      * sqrt(Nlim1 * SQ(Z1) / Tlim1 + Nlim2 * SQ(Z2) / Tlim2));
+                - log(Z12 / (AA1 * Tlim2[i] + AA2 * Tlim1[i])
+                      * sqrt(data1.NZsq_T[i] + data2.NZsq_T[i]));
 
-            // Calculate v_a^2, v_b^2
-            const BoutReal v1sq = 2 * Tlim1 * SI::qe / mass1;
-            const BoutReal v2sq = 2 * Tlim2 * SI::qe / mass2;
+            const BoutReal vsum = PI * (v1sq[i] + v2sq[i]);
 
             // Collision frequency
-            const BoutReal nu = SQ(charge1 * charge2) * Nlim2 * floor(coulomb_log, 1.0)
-                                * (1. + mass1 / mass2)
-                                / (3 * pow(PI * (v1sq + v2sq), 1.5) * SQ(SI::e0 * mass1));
+            const BoutReal nu = coefficient * data2.density_lim[i] * floor(coulomb_log, 1.0)
+                                / (vsum * sqrt(vsum));
             ASSERT2(std::isfinite(nu));
             return nu;
           });
@@ -381,19 +549,15 @@ void Collisions::transform(Options& state) {
           // species1 charged, species2 neutral
 
           // Scattering of charged species 1
-          // Neutral density
-          Field3D Nn = GET_NOBOUNDARY(Field3D, species2["density"]);
-
           BoutReal a0 = 5e-19; // Cross-section [m^2]
 
-          const Field3D nu_12 = filledFrom(density1, [&](auto& i) {
+          const Field3D nu_12 = filledFrom(data1.density, [&](auto& i) {
             // Relative velocity is sqrt( v1^2 + v2^2 )
-            const BoutReal vrel =
-                sqrt(temperature1[i] / (Tnorm * AA1) + temperature2[i] / (Tnorm * AA2));
+            const BoutReal vrel = sqrt(data1.vth_norm_sq[i] + data2.vth_norm_sq[i]);
 
             // Ion-neutral collision rate
             // Units: density [m^-3], a0 [m^2], rho_s0 [m]
-            return vrel * density2[i] * a0 * rho_s0;
+            return vrel * data2.density[i] * a0 * rho_s0;
           });
 
           collide(species1, species2, nu_12, 1.0);
@@ -413,13 +577,8 @@ void Collisions::transform(Options& state) {
 
         // Note: Here species1 could be equal to species2
 
-        // If temperature isn't set, assume zero
-        const Field3D temperature2 =
-            species2.isSet("temperature")
-                ? GET_NOBOUNDARY(Field3D, species2["temperature"]) * Tnorm
-                : 0.0;
         const BoutReal AA2 = get<BoutReal>(species2["AA"]);
-        const Field3D density2 = GET_NOBOUNDARY(Field3D, species2["density"]) * Nnorm;
+        const CollisionSpecies& data2 = speciesData(kv2->first, AA2 * SI::Mp);
 
         if (species2.isSet("charge")) {
           // species1 neutral, species2 charged
@@ -432,14 +591,13 @@ void Collisions::transform(Options& state) {
           // This is from NRL. The cross-section can vary significantly
           BoutReal a0 = 5e-19; // Cross-section [m^2]
 
-          const Field3D nu_12 = filledFrom(density1, [&](auto& i) {
+          const Field3D nu_12 = filledFrom(data1.density, [&](auto& i) {
             // Relative velocity is sqrt( v1^2 + v2^2 )
-            const BoutReal vrel =
-                sqrt(temperature1[i] / (Tnorm * AA1) + temperature2[i] / (Tnorm * AA2));
+            const BoutReal vrel = sqrt(data1.vth_norm_sq[i] + data2.vth_norm_sq[i]);
 
             // Ion-neutral collision rate
             // Units: density [m^-3], a0 [m^2], rho_s0 [m]
-            return vrel * density2[i] * a0 * rho_s0;
+            return vrel * data2.density[i] * a0 * rho_s0;
           });
 
           collide(species1, species2, nu_12, 1.0);
@@ -460,14 +618,13 @@ void Collisions::transform(Options& state) {
           //
           BoutReal a0 = PI * SQ(2.8e-10); // Cross-section [m^2]
 
-          const Field3D nu_12 = filledFrom(density1, [&](auto& i) {
+          const Field3D nu_12 = filledFrom(data1.density, [&](auto& i) {
             // Relative velocity is sqrt( v1^2 + v2^2 )
-            const BoutReal vrel =
-                sqrt(temperature1[i] / (Tnorm * AA1) + temperature2[i] / (Tnorm * AA2));
+            const BoutReal vrel = sqrt(data1.vth_norm_sq[i] + data2.vth_norm_sq[i]);
 
             // Ion-neutral collision rate
             // Units: density [m^-3], a0 [m^2], rho_s0 [m]
-            return vrel * density2[i] * a0 * rho_s0;
+            return vrel * data2.density[i] * a0 * rho_s0;
           });
 
           collide(species1, species2, nu_12, 1.0);
@@ -475,6 +632,26 @@ void Collisions::transform(Options& state) {
       }
     }
   }
+
+  // Add the accumulated sources to each species
+  for (auto& kv : sources) {
+    Options& species = allspecies[kv.first];
+    const CollisionSources& species_sources = kv.second;
+
+    if (species_sources.collision_frequency.isAllocated()) {
+      add(species["collision_frequency"], species_sources.collision_frequency);
+    }
+    if (species_sources.momentum_source.isAllocated()) {
+      add(species["momentum_source"], species_sources.momentum_source);
+    }
+    if (species_sources.energy_source.isAllocated()) {
+      add(species["energy_source"], species_sources.energy_source);
+    }
+    for (const auto& coupling : species_sources.energy_coupling) {
+      addPreconCoupling(species, "energy_source", coupling.first, coupling.second);
+    }
+  }
+  sources.clear();
 }
 
 void Collisions::outputVars(Options& state) {
@@ -31,3 +31,7 @@ bool isSetFinalNoBoundary(const Options& option, const std::string& location) {
 #endif
   return option.isSet();
 }
+
+bool isOutputStep(const Options& state) {
+  return !state.isSet("output_step") or getNonFinal<bool>(state["output_step"]);
+}
@@ -2,6 +2,208 @@
 
 #include <bout/utils.hxx> // for trim, strsplit
 
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+
+namespace {
+/// Copy an Options tree, including the data of Field3D values, so that
+/// changes made in place to the original fields are not seen in the copy
+void deepCopy(const Options& from, Options& to) {
+  for (const auto& kv : from.getChildren()) {
+    const Options& value = kv.second;
+    if (value.isSection()) {
+      deepCopy(value, to[kv.first]);
+    } else if (value.isSet() and bout::utils::holds_alternative<Field3D>(value.value)
+               and bout::utils::get<Field3D>(value.value).isAllocated()) {
+      to[kv.first] = copy(bout::utils::get<Field3D>(value.value));
+    } else {
+      to[kv.first] = value;
+    }
+  }
+}
+
+/// Store a value which is set by a change. Fields are copied, since
+/// components evaluated later may modify them in place
+void recordSet(const Options& value, Options& change) {
+  if (bout::utils::holds_alternative<Field3D>(value.value)
+      and bout::utils::get<Field3D>(value.value).isAllocated()) {
+    change["set"] = copy(bout::utils::get<Field3D>(value.value));
+  } else {
+    change["set"] = value;
+  }
+}
+
+/// Is a state value accumulated by components (e.g. with add()), so that
+/// a change to it should be replayed as an increment?
+bool isAccumulated(const std::string& name) {
+  auto endsWith = [&](const std::string& suffix) {
+    return (name.size() >= suffix.size())
+           and (name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0);
+  };
+  return endsWith("_source") or endsWith("_flow_xlow") or endsWith("_flow_ylow")
+         or (name == "collision_frequency") or (name == "DivJextra");
+}
+
+/// Record the changes made to an Options tree, so that they can be
+/// applied again later. Changes to accumulated values (sources, flows,
+/// preconditioner couplings) are stored as differences. Changes to other
+/// Field3D values are stored as the new values in the cells which
+/// changed, so that e.g. boundary values are set again. Other values are
+/// stored as they are.
+///
+/// @param before   The tree before the changes. Must not share field data
+///                 with \p after (see deepCopy)
+/// @param after    The tree after the changes
+/// @param changes  Output tree of changes
+/// @param accumulated  Are all values in this section accumulated?
+void recordChanges(const Options& before, const Options& after, Options& changes,
+                   bool accumulated = false) {
+  for (const auto& kv : after.getChildren()) {
+    const Options& value = kv.second;
+    if (value.isSection()) {
+      const bool section_accumulated = accumulated or (kv.first == "precon_coupling");
+      if (before.isSection(kv.first)) {
+        recordChanges(before[kv.first], value, changes[kv.first], section_accumulated);
+      } else {
+        // New section: Every value in it is set
+        recordChanges(Options{}, value, changes[kv.first], section_accumulated);
+      }
+      continue;
+    }
+    if (!value.isSet()) {
+      continue;
+    }
+    if (!before.isSet(kv.first)) {
+      recordSet(value, changes[kv.first]);
+      continue;
+    }
+    const Options& previous = before[kv.first];
+    const bool increment = accumulated or isAccumulated(kv.first);
+    if (bout::utils::holds_alternative<Field3D>(value.value)
+        and bout::utils::holds_alternative<Field3D>(previous.value)) {
+      const Field3D& f_after = bout::utils::get<Field3D>(value.value);
+      const Field3D& f_before = bout::utils::get<Field3D>(previous.value);
+      if (!(f_after.isAllocated() and f_before.isAllocated())) {
+        recordSet(value, changes[kv.first]);
+        continue;
+      }
+      // Cells which have changed value
+      Field3D changed{zeroFrom(f_after)};
+      bool any_changed = false;
+      BOUT_FOR_SERIAL(i, f_after.getRegion("RGN_ALL")) {
+        if (f_after[i] != f_before[i]) {
+          changed[i] = 1.0;
+          any_changed = true;
+        }
+      }
+      if (!any_changed) {
+        continue;
+      }
+      if (increment) {
+        changes[kv.first]["add"] = f_after - f_before;
+      } else {
+        changes[kv.first]["set_cells"] = copy(f_after);
+        changes[kv.first]["changed"] = changed;
+      }
+    } else if (bout::utils::holds_alternative<BoutReal>(value.value)
+               and bout::utils::holds_alternative<BoutReal>(previous.value)) {
+      const BoutReal after_value = bout::utils::get<BoutReal>(value.value);
+      const BoutReal change = after_value - bout::utils::get<BoutReal>(previous.value);
+      if (change == 0.0) {
+        continue;
+      }
+      if (increment) {
+        changes[kv.first]["add"] = change;
+      } else {
+        changes[kv.first]["set"] = after_value;
+      }
+    } else {
+      recordSet(value, changes[kv.first]);
+    }
+  }
+}
+
+/// Apply changes recorded by recordChanges() to an Options tree
+void applyChanges(const Options& changes, Options& state) {
+  for (const auto& kv : changes.getChildren()) {
+    const Options& change = kv.second;
+    if (change.isSet("set")) {
+      const Options& set_value = change["set"];
+      state[kv.first] = set_value;
+      if (bout::utils::holds_alternative<Field3D>(set_value.value)) {
+        // Copy, so that the recorded value is not modified in place
+        state[kv.first].force(copy(bout::utils::get<Field3D>(set_value.value)));
+      }
+    } else if (change.isSet("set_cells")) {
+      const Field3D values = change["set_cells"].as<Field3D>();
+      if (!state.isSet(kv.first)) {
+        set(state[kv.first], values);
+        continue;
+      }
+      // Only set the cells which were changed, keeping the others
+      const Field3D changed = change["changed"].as<Field3D>();
+      Field3D result = copy(getNonFinal<Field3D>(state[kv.first]));
+      BOUT_FOR(i, result.getRegion("RGN_ALL")) {
+        if (changed[i] != 0.0) {
+          result[i] = values[i];
+        }
+      }
+      set(state[kv.first], result);
+    } else if (change.isSet("add")) {
+      const Options& add_value = change["add"];
+      if (bout::utils::holds_alternative<Field3D>(add_value.value)) {
+        add(state[kv.first], bout::utils::get<Field3D>(add_value.value));
+      } else {
+        add(state[kv.first], bout::utils::get<BoutReal>(add_value.value));
+      }
+    } else if (change.isSection()) {
+      applyChanges(change, state[kv.first]);
+    }
+  }
+}
+
+/// Solve a small dense system A x = b in place by Gaussian
+/// elimination with partial pivoting.
+///
+/// @param A  Matrix with n * n elements, row major. Modified.
+/// @param b  Right hand side with n elements. Replaced by the solution.
+void solveDense(std::vector<BoutReal>& A, std::vector<BoutReal>& b) {
+  const std::size_t n = b.size();
+  for (std::size_t k = 0; k < n; ++k) {
+    // Find the pivot
+    std::size_t pivot = k;
+    for (std::size_t r = k + 1; r < n; ++r) {
+      if (std::abs(A[r * n + k]) > std::abs(A[pivot * n + k])) {
+        pivot = r;
+      }
+    }
+    if (pivot != k) {
+      for (std::size_t c = k; c < n; ++c) {
+        std::swap(A[k * n + c], A[pivot * n + c]);
+      }
+      std::swap(b[k], b[pivot]);
+    }
+    // Eliminate below the diagonal
+    for (std::size_t r = k + 1; r < n; ++r) {
+      const BoutReal factor = A[r * n + k] / A[k * n + k];
+      for (std::size_t c = k + 1; c < n; ++c) {
+        A[r * n + c] -= factor * A[k * n + c];
+      }
+      b[r] -= factor * b[k];
+    }
+  }
+  // Back substitution
+  for (std::size_t k = n; k-- > 0;) {
+    for (std::size_t c = k + 1; c < n; ++c) {
+      b[k] -= A[k * n + c] * b[c];
+    }
+    b[k] /= A[k * n + k];
+  }
+}
+} // namespace
+
 ComponentScheduler::ComponentScheduler(Options &scheduler_options,
                                        Options &component_options,
                                        Solver *solver) {
@@ -10,6 +212,26 @@ ComponentScheduler::ComponentScheduler(Options &scheduler_options,
                                     .doc("Components in order of execution")
                                     .as<std::string>();
 
+  block_precon = scheduler_options["block_precon"]
+                     .doc("Precondition local couplings between species?")
+                     .withDefault<bool>(false);
+
+  std::set<std::string> slow_names;
+  for (const auto &name : strsplit(scheduler_options["slow_components"]
+                                       .doc("Components only evaluated every slow_timestep")
+                                       .withDefault<std::string>(""),
+                                   ',')) {
+    auto name_trimmed = trim(name, " \t\r()");
+    if (!name_trimmed.empty()) {
+      slow_names.insert(name_trimmed);
+    }
+  }
+  slow_timestep = scheduler_options["slow_timestep"]
+                      .doc("Time between evaluations of slow components [normalised]")
+                      .withDefault(0.0);
+  slow_last_time = 0.0;
+  slow_evaluated = false;
+
   // For now split on ','. Something like "->" might be better
   for (const auto &name : strsplit(component_names, ',')) {
     // Ignore brackets, to allow these to be used to span lines.
@@ -22,11 +244,11 @@ ComponentScheduler::ComponentScheduler(Options &scheduler_options,
 
     // For each component e.g. "e", several Component types can be created
     // but if types are not specified then the component name is used
-    std::string types = component_options[name_trimmed].isSet("type")
+    std::string type_list = component_options[name_trimmed].isSet("type")
                             ? component_options[name_trimmed]["type"].as<std::string>()
                             : name_trimmed;
 
-    for (const auto &type : strsplit(types, ',')) {
+    for (const auto &type : strsplit(type_list, ',')) {
       auto type_trimmed = trim(type, " \t\r()");
       if (type_trimmed.empty()) {
         continue;
@@ -36,8 +258,11 @@ ComponentScheduler::ComponentScheduler(Options &scheduler_options,
                                              name_trimmed,
                                              component_options,
                                              solver));
+      slow.push_back(slow_names.count(name_trimmed) != 0);
+      types.push_back(type_trimmed);
     }
   }
+  slow_changes.resize(components.size());
 }
 
 std::unique_ptr<ComponentScheduler> ComponentScheduler::create(Options &scheduler_options,
@@ -49,14 +274,65 @@ std::unique_ptr<ComponentScheduler> ComponentScheduler::create(Options &schedule
 
 
 void ComponentScheduler::transform(Options &state) {
+  // Decide whether slow components should be evaluated.
+  // If the time has gone backwards (e.g. a failed step) then re-evaluate.
+  // When lazy diagnostics are enabled, slow components are evaluated
+  // for output so that their diagnostics are calculated.
+  const BoutReal time =
+      state.isSet("time") ? getNonFinal<BoutReal>(state["time"]) : 0.0;
+  const bool output_step = state.isSet("output_step") and isOutputStep(state);
+  if (output_step and !output_state_saved) {
+    // The output time may be behind the solver's internal time. Save
+    // the components' internal state so that this evaluation has no
+    // side effects (e.g. on time integrals) once outputVars is done.
+    output_state = Options();
+    saveState(output_state);
+    output_slow_changes = slow_changes;
+    output_slow_last_time = slow_last_time;
+    output_slow_evaluated = slow_evaluated;
+    output_state_saved = true;
+  }
+  const bool update_slow = !slow_evaluated or (time >= slow_last_time + slow_timestep)
+                           or (time < slow_last_time) or output_step;
+  if (update_slow) {
+    slow_evaluated = true;
+    slow_last_time = time;
+  }
+
   // Run through each component
-  for(auto &component : components) {
-    component->transform(state);
+  for (std::size_t i = 0; i < components.size(); ++i) {
+    if (!slow[i]) {
+      components[i]->transform(state);
+    } else if (update_slow) {
+      // Deep copy, since components may modify fields in place
+      Options before;
+      deepCopy(state, before);
+      components[i]->transform(state);
+      slow_changes[i] = Options();
+      recordChanges(before, state, slow_changes[i]);
+    } else {
+      applyChanges(slow_changes[i], state);
+    }
   }
-  // Enable components to update themselves based on the final state
-  for(auto &component : components) {
+  // Enable components to update themselves based on the final state.
+  // Slow components also run, on the replayed state, so that their time
+  // derivatives are set again even if modified since (e.g. by precon)
+  for (auto &component : components) {
     component->finally(state);
   }
+
+  if (accepted_pending) {
+    // Explicit one-step solvers evaluate the model with the accepted
+    // solution, at its time, at the start of the next step. Any other
+    // evaluation (e.g. CVODE at a predicted time) is not the accepted
+    // solution, so the step is not passed to the components.
+    accepted_pending = false;
+    if (time == accepted_time) {
+      for (auto &component : components) {
+        component->timestepAccepted(state);
+      }
+    }
+  }
 }
 
 void ComponentScheduler::outputVars(Options &state) {
@@ -64,6 +340,15 @@ void ComponentScheduler::outputVars(Options &state) {
   for(auto &component : components) {
     component->outputVars(state);
   }
+  if (output_state_saved) {
+    // Undo changes made by evaluating for output
+    loadState(output_state);
+    slow_changes = std::move(output_slow_changes);
+    slow_last_time = output_slow_last_time;
+    slow_evaluated = output_slow_evaluated;
+    output_state = Options();
+    output_state_saved = false;
+  }
 }
 
 void ComponentScheduler::restartVars(Options &state) {
@@ -73,8 +358,104 @@ void ComponentScheduler::restartVars(Options &state) {
   }
 }
 
+void ComponentScheduler::saveState(Options &restart) {
+  for(auto &component : components) {
+    component->saveState(restart);
+  }
+}
+
+void ComponentScheduler::loadState(const Options &restart) {
+  for(auto &component : components) {
+    component->loadState(restart);
+  }
+}
+
+void ComponentScheduler::timeDerivs(Options &ddts) {
+  for(auto &component : components) {
+    component->timeDerivs(ddts);
+  }
+}
+
+void ComponentScheduler::timestepAccepted(BoutReal time) {
+  // Replaces any step which was not evaluated
+  accepted_pending = true;
+  accepted_time = time;
+}
+
 void ComponentScheduler::precon(const Options &state, BoutReal gamma) {
   for(auto &component : components) {
     component->precon(state, gamma);
   }
+  if (block_precon) {
+    blockPrecon(state, gamma);
+  }
+}
+
+bool ComponentScheduler::hasComponentType(const std::string &type) const {
+  return std::find(types.begin(), types.end(), type) != types.end();
+}
+
+void ComponentScheduler::blockPrecon(const Options &state, BoutReal gamma) {
+  std::vector<PreconVariable> variables;
+  for(auto &component : components) {
+    component->preconVariables(state, variables);
+  }
+  if (variables.empty()) {
+    return;
+  }
+
+  const Field3D scale = state.isSet("scale_timederivs")
+                            ? getNonFinal<Field3D>(state["scale_timederivs"])
+                            : 1.0;
+
+  for (const std::string source : {"density_source", "energy_source"}) {
+    // Variables whose time derivative includes this source
+    std::vector<const PreconVariable*> block;
+    for (const auto &variable : variables) {
+      if (variable.source == source) {
+        block.push_back(&variable);
+      }
+    }
+    const std::size_t n = block.size();
+
+    // Jacobian J[i][j] = d ddt_i / d variable_j
+    std::vector<Field3D> jacobian(n * n);
+    bool coupled = false;
+    for (std::size_t i = 0; i < n; ++i) {
+      const Options &species = state["species"][block[i]->species];
+      if (!species.isSection("precon_coupling")
+          or !species["precon_coupling"].isSection(source)) {
+        continue;
+      }
+      const Options &couplings = species["precon_coupling"][source];
+      for (std::size_t j = 0; j < n; ++j) {
+        if (couplings.isSet(block[j]->species)) {
+          jacobian[i * n + j] = block[i]->dsource
+                                * getNonFinal<Field3D>(couplings[block[j]->species])
+                                * block[j]->dquantity;
+          coupled = true;
+        }
+      }
+    }
+    if (!coupled) {
+      continue;
+    }
+
+    std::vector<BoutReal> matrix(n * n);
+    std::vector<BoutReal> x(n);
+    BOUT_FOR_SERIAL(i, scale.getRegion("RGN_NOBNDRY")) {
+      for (std::size_t r = 0; r < n; ++r) {
+        for (std::size_t c = 0; c < n; ++c) {
+          const Field3D &J = jacobian[r * n + c];
+          matrix[r * n + c] = ((r == c) ? 1.0 : 0.0)
+                              - (J.isAllocated() ? gamma * scale[i] * J[i] : 0.0);
+        }
+        x[r] = (*block[r]->ddt)[i];
+      }
+      solveDense(matrix, x);
+      for (std::size_t r = 0; r < n; ++r) {
+        (*block[r]->ddt)[i] = x[r];
+      }
+    }
+  }
 }
@@ -2,8 +2,22 @@
 
 #include <bout/constants.hxx>
 #include <bout/mesh.hxx>
+#include <bout/invert/laplacexy.hxx>
 #include <bout/invert_laplace.hxx>
 
+#include <vector>
+
+namespace {
+/// A charged species with parallel momentum
+struct ChargedSpecies {
+  Options* species;
+  BoutReal Z;  ///< Charge
+  BoutReal A;  ///< Atomic mass
+  Field3D N;   ///< Density
+  Field3D mom; ///< Parallel momentum, including A|| contribution
+};
+} // namespace
+
 Electromagnetic::Electromagnetic(std::string name, Options &alloptions, Solver*) {
   AUTO_TRACE();
 
@@ -25,6 +39,29 @@ Electromagnetic::Electromagnetic(std::string name, Options &alloptions, Solver*)
   aparSolver->setInnerBoundaryFlags(INVERT_DC_GRAD + INVERT_AC_GRAD);
   aparSolver->setOuterBoundaryFlags(INVERT_DC_GRAD + INVERT_AC_GRAD);
 
+  const BoutReal coefficient_tolerance =
+      options["coefficient_tolerance"]
+          .doc("Compare alpha_em with the last value before updating the Apar "
+               "solver? 0 means update if changed, < 0 always update")
+          .withDefault(-1.0);
+  if (coefficient_tolerance > 0.0) {
+    // Lagging alpha_em would change the Apar which is solved for
+    throw BoutException("Electromagnetic: coefficient_tolerance must be <= 0");
+  }
+  aparCoefA = LaplacianCoefficient<Field3D>(coefficient_tolerance);
+
+  apar_warm_start = options["apar_warm_start"]
+                        .doc("Use the previous Apar as initial guess for the solver?")
+                        .withDefault<bool>(true);
+
+  split_n0 = options["split_n0"]
+                 .doc("Solve the n=0 component of Apar separately with LaplaceXY?")
+                 .withDefault<bool>(false);
+  if (split_n0) {
+    laplacexy = new LaplaceXY(bout::globals::mesh, &options["laplacexy"]);
+    aparCoefA_n0 = LaplacianCoefficient<Field2D>(coefficient_tolerance);
+  }
+
   diagnose = options["diagnose"]
     .doc("Output additional diagnostics?")
     .withDefault<bool>(false);
@@ -35,13 +72,10 @@ void Electromagnetic::transform(Options &state) {
 
   Options& allspecies = state["species"];
 
-  // Sum coefficients over species
-  //
-  // Laplace(A||) - alpha_em * beta_em A|| = - beta_em * Ajpar
-  alpha_em = 0.0;
-  Ajpar = 0.0;
+  // Collect charged species with parallel momentum
+  std::vector<ChargedSpecies> charged;
   for (auto& kv : allspecies.getChildren()) {
-    const Options& species = kv.second;
+    Options& species = allspecies[kv.first]; // Note: need non-const
 
     if (!IS_SET(species["charge"]) or !species.isSet("momentum")) {
       continue; // Not charged, or no parallel flow
@@ -52,44 +86,79 @@ void Electromagnetic::transform(Options &state) {
     }
 
     // Cannot rely on boundary conditions being set
-    const Field3D N = GET_NOBOUNDARY(Field3D, species["density"]);
-    // Non-final because we're going to change momentum
-    const Field3D mom = getNonFinal<Field3D>(species["momentum"]);
-    const BoutReal A = get<BoutReal>(species["AA"]);
-
-    // Coefficient in front of A_||
-    alpha_em += N * (SQ(Z) / A);
+    // Momentum is non-final because we're going to change it
+    charged.push_back({&species, Z, get<BoutReal>(species["AA"]),
+                       GET_NOBOUNDARY(Field3D, species["density"]),
+                       getNonFinal<Field3D>(species["momentum"])});
+  }
 
-    // Right hand side
-    Ajpar += mom * (Z / A);
+  // Sum coefficients over species in a single pass
+  //
+  // Laplace(A||) - alpha_em * beta_em A|| = - beta_em * Ajpar
+  if (charged.empty()) {
+    alpha_em = 0.0;
+    Ajpar = 0.0;
+  } else {
+    alpha_em = emptyFrom(charged.front().N);
+    Ajpar = emptyFrom(charged.front().N);
+    BOUT_FOR(i, alpha_em.getRegion("RGN_ALL")) {
+      BoutReal alpha = 0.0;
+      BoutReal ajpar = 0.0;
+      for (const auto& s : charged) {
+        alpha += s.N[i] * (SQ(s.Z) / s.A); // Coefficient in front of A_||
+        ajpar += s.mom[i] * (s.Z / s.A);   // Right hand side
+      }
+      alpha_em[i] = alpha;
+      Ajpar[i] = ajpar;
+    }
   }
 
   // Invert Helmholtz equation for Apar
-  aparSolver->setCoefA((-beta_em) * alpha_em);
-  Apar = aparSolver->solve((-beta_em) * Ajpar);
+  // If coefficient_tolerance = 0, only set if changed so the solver
+  // setup can be reused
+  if (aparCoefA.update((-beta_em) * alpha_em)) {
+    aparSolver->setCoefA(aparCoefA.value());
+  }
+
+  // Initial guess for iterative solvers
+  const Field3D guess = (apar_warm_start and Apar.isAllocated()) ? Apar : zeroFrom(Ajpar);
+  const Field3D rhs = (-beta_em) * Ajpar;
+
+  if (split_n0) {
+    ////////////////////////////////////////////
+    // Split into axisymmetric and non-axisymmetric components
+    //
+    // The n=0 part uses the axisymmetric coefficient:
+    //   (Laplace - beta_em * DC(alpha_em)) Apar_0 = DC(rhs)
+    // and the remainder is then
+    //   (Laplace - beta_em * alpha_em) Apar_1
+    //       = rhs - DC(rhs) + beta_em * (alpha_em - DC(alpha_em)) * Apar_0
+    const Field2D alpha_em_2d = DC(alpha_em);
+    if (aparCoefA_n0.update((-beta_em) * alpha_em_2d)) {
+      laplacexy->setCoefs(1.0, aparCoefA_n0.value());
+    }
+    const Field2D rhs_2d = DC(rhs);
+    const Field2D guess_2d = DC(guess);
+    const Field2D apar_2d = laplacexy->solve(rhs_2d, guess_2d);
+
+    Apar = apar_2d
+           + aparSolver->solve(rhs - rhs_2d + beta_em * (alpha_em - alpha_em_2d) * apar_2d,
+                               guess - guess_2d);
+  } else {
+    Apar = aparSolver->solve(rhs, guess);
+  }
 
   // Save in the state
   set(state["fields"]["Apar"], Apar);
 
   // Update momentum
-  for (auto& kv : allspecies.getChildren()) {
-    Options& species = allspecies[kv.first]; // Note: need non-const
-
-    if (!species.isSet("charge") or !species.isSet("momentum")) {
-      continue; // Not charged, or no parallel flow
-    }
-    const BoutReal Z = get<BoutReal>(species["charge"]);
-    if (fabs(Z) < 1e-5) {
-      continue; // Not charged
-    }
-    const BoutReal A = get<BoutReal>(species["AA"]);
-    const Field3D N = GET_NOBOUNDARY(Field3D, species["density"]);
+  for (auto& s : charged) {
+    Options& species = *s.species;
 
-    Field3D nv = getNonFinal<Field3D>(species["momentum"]);
-    nv -= Z * N * Apar;
+    Field3D nv = s.mom - s.Z * s.N * Apar;
     // Note: velocity is momentum / (A * N)
     Field3D v = getNonFinal<Field3D>(species["velocity"]);
-    v -= (Z / A) * Apar;
+    v -= (s.Z / s.A) * Apar;
     // Need to update the guard cells
     bout::globals::mesh->communicate(nv, v);
 
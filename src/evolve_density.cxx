@@ -258,7 +258,7 @@ void EvolveDensity::finally(const Options& state) {
   }
 #endif
 
-  if (diagnose) {
+  if (diagnose and isOutputStep(state)) {
     // Save flows if they are set
 
     if (species.isSet("particle_flow_xlow")) {
@@ -270,6 +270,20 @@ void EvolveDensity::finally(const Options& state) {
   }
 }
 
+void EvolveDensity::preconVariables(const Options& UNUSED(state),
+                                    std::vector<PreconVariable>& variables) {
+  if (evolve_log) {
+    // ddt(logN) = ddt(N) / N
+    variables.push_back({name, "density_source", &ddt(logN), 1. / N, N});
+  } else {
+    variables.push_back({name, "density_source", &ddt(N), 1.0, 1.0});
+  }
+}
+
+void EvolveDensity::timeDerivs(Options& ddts) {
+  ddts[std::string("N") + name] = ddt(N);
+}
+
 void EvolveDensity::outputVars(Options& state) {
   // Normalisations
   auto Nnorm = get<BoutReal>(state["Nnorm"]);
@@ -328,7 +328,7 @@ void EvolveEnergy::finally(const Options& state) {
   }
 #endif
 
-  if (diagnose) {
+  if (diagnose and isOutputStep(state)) {
     // Save flows of energy if they are set
 
     if (species.isSet("energy_flow_xlow")) {
@@ -340,6 +340,10 @@ void EvolveEnergy::finally(const Options& state) {
   }
 }
 
+void EvolveEnergy::timeDerivs(Options& ddts) {
+  ddts[std::string("E") + name] = ddt(E);
+}
+
 void EvolveEnergy::outputVars(Options& state) {
   AUTO_TRACE();
   // Normalisations
@@ -440,6 +444,17 @@ void EvolveEnergy::outputVars(Options& state) {
   }
 }
 
+void EvolveEnergy::preconVariables(const Options& UNUSED(state),
+                                   std::vector<PreconVariable>& variables) {
+  // d/dt(E) = energy_source and T ~ E / (Cv * N), neglecting kinetic energy
+  const Field3D dTdE = 1. / (Cv * floor(N, density_floor));
+  if (evolve_log) {
+    variables.push_back({name, "energy_source", &ddt(logE), 1. / E, E * dTdE});
+  } else {
+    variables.push_back({name, "energy_source", &ddt(E), 1.0, dTdE});
+  }
+}
+
 void EvolveEnergy::precon(const Options& state, BoutReal gamma) {
   if (!(enable_precon and thermal_conduction)) {
     return; // Disabled
@@ -455,14 +470,22 @@ void EvolveEnergy::precon(const Options& state, BoutReal gamma) {
   const Field3D N = get<Field3D>(species["density"]);
 
   // Set the coefficient in Div_par( B * Grad_par )
-  Field3D coef = -gamma * kappa_par / floor(N, density_floor);
+  // Conduction depends on T ~ E / (Cv * N), neglecting kinetic energy
+  Field3D coef = -gamma * kappa_par / (Cv * floor(N, density_floor));
 
   if (state.isSet("scale_timederivs")) {
     coef *= get<Field3D>(state["scale_timederivs"]);
   }
 
   inv->setCoefB(coef);
-  Field3D dT = ddt(P);
-  dT.applyBoundary("neumann");
-  ddt(P) = inv->solve(dT);
+
+  // Precondition the evolving variable, E or log(E)
+  Field3D dE = evolve_log ? ddt(logE) * E : ddt(E);
+  dE.applyBoundary("neumann");
+  dE = inv->solve(dE);
+  if (evolve_log) {
+    ddt(logE) = dE / E;
+  } else {
+    ddt(E) = dE;
+  }
 }
@@ -3,6 +3,7 @@
 #include <bout/difops.hxx>
 #include <bout/constants.hxx>
 #include <bout/fv_ops.hxx>
+#include <bout/invert_pardiv.hxx>
 #include <bout/output_bout_types.hxx>
 
 #include "../include/evolve_momentum.hxx"
@@ -58,6 +59,10 @@ EvolveMomentum::EvolveMomentum(std::string name, Options &alloptions, Solver *so
   fix_momentum_boundary_flux = options["fix_momentum_boundary_flux"]
     .doc("Fix Y boundary momentum flux to boundary midpoint value?")
     .withDefault<bool>(false);
+
+  enable_precon = options["precondition"]
+    .doc("Enable preconditioner? (Note: solver may not use it)")
+    .withDefault<bool>(false);
 }
 
 void EvolveMomentum::transform(Options &state) {
@@ -183,7 +188,7 @@ void EvolveMomentum::finally(const Options &state) {
   }
 #endif
 
-  if (diagnose) {
+  if (diagnose and isOutputStep(state)) {
     // Save flows if they are set
 
     if (species.isSet("momentum_flow_xlow")) {
@@ -195,6 +200,10 @@ void EvolveMomentum::finally(const Options &state) {
   }
 }
 
+void EvolveMomentum::timeDerivs(Options& ddts) {
+  ddts[std::string("NV") + name] = ddt(NV);
+}
+
 void EvolveMomentum::outputVars(Options &state) {
   AUTO_TRACE();
   // Normalisations
@@ -263,3 +272,55 @@ void EvolveMomentum::outputVars(Options &state) {
     }
   }
 }
+
+void EvolveMomentum::precon(const Options &state, BoutReal gamma) {
+  if (!enable_precon) {
+    return; // Disabled
+  }
+
+  static std::unique_ptr<InvertParDiv> inv;
+  if (!inv) {
+    // Initialise parallel inversion class
+    inv = InvertParDiv::create();
+    inv->setCoefA(1.0);
+  }
+  const auto& species = state["species"][name];
+  const BoutReal AA = get<BoutReal>(species["AA"]);
+  const Field3D N = get<Field3D>(species["density"]);
+
+  // Same wave speed as used for numerical diffusion in finally()
+  Field3D fastest_wave;
+  if (state.isSet("fastest_wave")) {
+    fastest_wave = get<Field3D>(state["fastest_wave"]);
+  } else {
+    Field3D T = get<Field3D>(species["temperature"]);
+    fastest_wave = sqrt(T / AA);
+  }
+
+  auto* coord = mesh->getCoordinates();
+
+  // Numerical dissipation in Div_par_fvv acts like a parallel
+  // diffusion with coefficient 0.5 * wave speed * parallel cell length.
+  // Eliminating the pressure from the momentum-pressure system gives a
+  // sound wave term gamma * c^2 (Schur complement).
+  Field3D diffusivity = (0.5 * coord->dy * sqrt(coord->g_22) + gamma * fastest_wave)
+                        * fastest_wave;
+
+  if (species.isSet("parallel_viscosity")) {
+    // Parallel viscosity eta acts on V = NV / (A * N)
+    diffusivity += get<Field3D>(species["parallel_viscosity"])
+                   / (AA * floor(N, density_floor));
+  }
+
+  // Set the coefficient in Div_par( B * Grad_par )
+  Field3D coef = -gamma * diffusivity;
+
+  if (state.isSet("scale_timederivs")) {
+    coef *= get<Field3D>(state["scale_timederivs"]);
+  }
+
+  inv->setCoefB(coef);
+  Field3D dNV = ddt(NV);
+  dNV.applyBoundary("neumann");
+  ddt(NV) = inv->solve(dNV);
+}
@@ -362,7 +362,7 @@ void EvolvePressure::finally(const Options& state) {
   }
 #endif
 
-  if (diagnose) {
+  if (diagnose and isOutputStep(state)) {
     // Save flows of energy if they are set
 
     if (species.isSet("energy_flow_xlow")) {
@@ -374,6 +374,10 @@ void EvolvePressure::finally(const Options& state) {
   }
 }
 
+void EvolvePressure::timeDerivs(Options& ddts) {
+  ddts[std::string("P") + name] = ddt(P);
+}
+
 void EvolvePressure::outputVars(Options& state) {
   AUTO_TRACE();
   // Normalisations
@@ -464,6 +468,17 @@ void EvolvePressure::outputVars(Options& state) {
   }
 }
 
+void EvolvePressure::preconVariables(const Options& UNUSED(state),
+                                     std::vector<PreconVariable>& variables) {
+  // d/dt(3/2 P) = energy_source and T = P / N
+  const Field3D Nlim = floor(N, density_floor);
+  if (evolve_log) {
+    variables.push_back({name, "energy_source", &ddt(logP), (2. / 3) / P, P / Nlim});
+  } else {
+    variables.push_back({name, "energy_source", &ddt(P), 2. / 3, 1. / Nlim});
+  }
+}
+
 void EvolvePressure::precon(const Options &state, BoutReal gamma) {
   if (!(enable_precon and thermal_conduction)) {
     return; // Disabled
@@ -364,6 +364,20 @@ void NeutralFullVelocity::finally(const Options &state) {
   }
 }
 
+void NeutralFullVelocity::timeDerivs(Options& ddts) {
+  // Evolving variables are 2D, but residuals are Field3D.
+  // Unallocated derivatives are left unallocated, and skipped
+  auto toField3D = [](const Field2D& f) {
+    return f.isAllocated() ? Field3D(f) : Field3D();
+  };
+  ddts["Nn"] = toField3D(ddt(Nn2D));
+  ddts["Pn"] = toField3D(ddt(Pn2D));
+  // Vector components, named as in the solver
+  ddts["Vnx"] = toField3D(ddt(Vn2D).x);
+  ddts["Vny"] = toField3D(ddt(Vn2D).y);
+  ddts["Vnz"] = toField3D(ddt(Vn2D).z);
+}
+
 /// Add extra fields for output, or set attributes e.g docstrings
 void NeutralFullVelocity::outputVars(Options &state) {
   // Normalisations
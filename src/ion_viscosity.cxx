@@ -112,6 +112,9 @@ void IonViscosity::transform(Options &state) {
       eta.applyBoundary("neumann");
     }
     
+    // Used by evolve_momentum to precondition the viscous term
+    set(species["parallel_viscosity"], eta);
+
     // This term is the parallel flow part of
     // -(2/3) B^(3/2) Grad_par(Pi_ci / B^(3/2))
     const Field3D div_Pi_cipar = sqrtB * FV::Div_par_K_Grad_par(eta / Bxy, sqrtB * V);
@@ -210,7 +213,7 @@ void IonViscosity::transform(Options &state) {
              Field3D(0.5 * Pi_ci * Curlb_B * Grad(phi_av + P_av)
                      - (1 / 3) * bracket(Pi_ci, phi_av + P_av, BRACKET_STD)));
 
-    if (diagnose) {
+    if (diagnose and isOutputStep(state)) {
       // Find the diagnostics struct for this species
       auto search = diagnostics.find(species_name);
       if (search == diagnostics.end()) {
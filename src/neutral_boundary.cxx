@@ -48,6 +48,7 @@ NeutralBoundary::NeutralBoundary(std::string name, Options& alloptions, Solver*
             .doc("Fraction of neutrals that are undergoing fast reflection at the pfr")
             .withDefault<BoutReal>(0.8);
 
+  wall = WallBoundary(mesh);
 }
 
 void NeutralBoundary::transform(Options& state) {
@@ -73,190 +74,136 @@ void NeutralBoundary::transform(Options& state) {
           ? toFieldAligned(getNonFinal<Field3D>(species["energy_source"]))
           : zeroFrom(Nn);
 
-  Coordinates* coord = mesh->getCoordinates();
-  target_energy_source = 0;
-  wall_energy_source = 0;
+  // Diagnostics are only needed for output
+  const bool diagnose_now = diagnose and isOutputStep(state);
+  if (diagnose_now) {
+    target_energy_source = 0;
+    wall_energy_source = 0;
+  }
 
   // Targets
   if (lower_y) {
-    for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-      for (int jz = 0; jz < mesh->LocalNz; jz++) {
-        auto i = indexAt(Nn, r.ind, mesh->ystart, jz);
-        auto im = i.ym();
-        auto ip = i.yp();
-
-        // Free boundary condition on log(Nn), log(Pn)
-        Nn[im] = SQ(Nn[i]) / Nn[ip];
-        Pn[im] = SQ(Pn[i]) / Pn[ip];
-        Tn[im] = SQ(Tn[i]) / Tn[ip];
-
-        // No-flow boundary condition
-        Vn[im] = -Vn[i];
-        NVn[im] = -NVn[i];
-
-        // Calculate midpoint values at wall
-        const BoutReal nnsheath = 0.5 * (Nn[im] + Nn[i]);
-        const BoutReal tnsheath = 0.5 * (Tn[im] + Tn[i]);
-
-        // Thermal speed
-        const BoutReal v_th = 0.25 * sqrt( 8*tnsheath / (PI*AA) );   // Stangeby p.69 eqns. 2.21, 2.24
-
-        // Calculate effective gamma from particle and energy reflection coefficients
-        BoutReal target_gamma_heat = 1 - target_energy_refl_factor * target_fast_refl_fraction 
-                                  -(1-target_fast_refl_fraction) * (3/Tnorm) / (2*tnsheath);  // D. Power thesis 2023
-
-        // Heat flux (> 0)
-        const BoutReal q = target_gamma_heat * nnsheath * tnsheath * v_th;
-        // Multiply by cell area to get power
-        BoutReal flux = q * (coord->J[i] + coord->J[im])
-                        / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[im]));
-
-        // Divide by volume of cell to get energy loss rate (> 0)
-        BoutReal power = flux / (coord->dy[i] * coord->J[i]);
-
-        // Subtract from cell next to boundary
-        energy_source[i] -= power;
+    for (const auto& cell : wall.lower_target) {
+      auto i = cell.i;
+      auto im = i.ym();
+      auto ip = i.yp();
+
+      // Free boundary condition on log(Nn), log(Pn)
+      Nn[im] = SQ(Nn[i]) / Nn[ip];
+      Pn[im] = SQ(Pn[i]) / Pn[ip];
+      Tn[im] = SQ(Tn[i]) / Tn[ip];
+
+      // No-flow boundary condition
+      Vn[im] = -Vn[i];
+      NVn[im] = -NVn[i];
+
+      // Calculate midpoint values at wall
+      const BoutReal nnsheath = 0.5 * (Nn[im] + Nn[i]);
+      const BoutReal tnsheath = 0.5 * (Tn[im] + Tn[i]);
+
+      // Thermal speed
+      const BoutReal v_th = 0.25 * sqrt( 8*tnsheath / (PI*AA) );   // Stangeby p.69 eqns. 2.21, 2.24
+
+      // Calculate effective gamma from particle and energy reflection coefficients
+      BoutReal target_gamma_heat = 1 - target_energy_refl_factor * target_fast_refl_fraction 
+                                -(1-target_fast_refl_fraction) * (3/Tnorm) / (2*tnsheath);  // D. Power thesis 2023
+
+      // Heat flux (> 0)
+      const BoutReal q = target_gamma_heat * nnsheath * tnsheath * v_th;
+      // Multiply by cell area to get power
+      BoutReal flux = q * cell.area;
+
+      // Divide by volume of cell to get energy loss rate (> 0)
+      BoutReal power = flux * cell.inv_volume;
+
+      // Subtract from cell next to boundary
+      energy_source[i] -= power;
+      if (diagnose_now) {
         target_energy_source[i] -= power;
       }
     }
   }
 
   if (upper_y) {
-    for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-      for (int jz = 0; jz < mesh->LocalNz; jz++) {
-        auto i = indexAt(Nn, r.ind, mesh->yend, jz);
-        auto im = i.ym();
-        auto ip = i.yp();
-
-        // Free boundary condition on log(Nn), log(Pn)
-        Nn[ip] = SQ(Nn[i]) / Nn[im];
-        Pn[ip] = SQ(Pn[i]) / Pn[im];
-        Tn[ip] = SQ(Tn[i]) / Tn[im];
-
-        // No-flow boundary condition
-        Vn[ip] = -Vn[i];
-        NVn[ip] = -NVn[i];
-
-        // Calculate midpoint values at wall
-        const BoutReal nnsheath = 0.5 * (Nn[ip] + Nn[i]);
-        const BoutReal tnsheath = 0.5 * (Tn[ip] + Tn[i]);
-
-        // Thermal speed
-        const BoutReal v_th = 0.25 * sqrt( 8*tnsheath / (PI*AA) );   // Stangeby p.69 eqns. 2.21, 2.24
-
-        // Calculate effective gamma from particle and energy reflection coefficients
-        BoutReal target_gamma_heat = 1 - target_energy_refl_factor * target_fast_refl_fraction 
-                                  -(1-target_fast_refl_fraction) * (3/Tnorm) / (2*tnsheath);  // D. Power thesis 2023
-
-        // Heat flux (> 0)
-        const BoutReal q = target_gamma_heat * nnsheath * tnsheath * v_th;
-        // Multiply by cell area to get power
-        BoutReal flux = q * (coord->J[i] + coord->J[ip])
-                        / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[ip]));
-
-        // Divide by volume of cell to get energy loss rate (> 0)
-        BoutReal power = flux / (coord->dy[i] * coord->J[i]);
-
-        // Subtract from cell next to boundary
-        energy_source[i] -= power;
+    for (const auto& cell : wall.upper_target) {
+      auto i = cell.i;
+      auto im = i.ym();
+      auto ip = i.yp();
+
+      // Free boundary condition on log(Nn), log(Pn)
+      Nn[ip] = SQ(Nn[i]) / Nn[im];
+      Pn[ip] = SQ(Pn[i]) / Pn[im];
+      Tn[ip] = SQ(Tn[i]) / Tn[im];
+
+      // No-flow boundary condition
+      Vn[ip] = -Vn[i];
+      NVn[ip] = -NVn[i];
+
+      // Calculate midpoint values at wall
+      const BoutReal nnsheath = 0.5 * (Nn[ip] + Nn[i]);
+      const BoutReal tnsheath = 0.5 * (Tn[ip] + Tn[i]);
+
+      // Thermal speed
+      const BoutReal v_th = 0.25 * sqrt( 8*tnsheath / (PI*AA) );   // Stangeby p.69 eqns. 2.21, 2.24
+
+      // Calculate effective gamma from particle and energy reflection coefficients
+      BoutReal target_gamma_heat = 1 - target_energy_refl_factor * target_fast_refl_fraction 
+                                -(1-target_fast_refl_fraction) * (3/Tnorm) / (2*tnsheath);  // D. Power thesis 2023
+
+      // Heat flux (> 0)
+      const BoutReal q = target_gamma_heat * nnsheath * tnsheath * v_th;
+      // Multiply by cell area to get power
+      BoutReal flux = q * cell.area;
+
+      // Divide by volume of cell to get energy loss rate (> 0)
+      BoutReal power = flux * cell.inv_volume;
+
+      // Subtract from cell next to boundary
+      energy_source[i] -= power;
+      if (diagnose_now) {
         target_energy_source[i] -= power;
       }
     }
   }
 
-    // SOL edge
-  if (sol) {
-    if(mesh->lastX()){  // Only do this for the processor which has the edge region
-      for(int iy=0; iy < mesh->LocalNy ; iy++){
-        for(int iz=0; iz < mesh->LocalNz; iz++){
-
-          auto i = indexAt(Nn, mesh->xend, iy, iz);  // Final domain cell
-          auto ig = indexAt(Nn, mesh->xend+1, iy, iz);  // Guard cell
-          
-          // Calculate midpoint values at wall
-          const BoutReal nnsheath = 0.5 * (Nn[ig] + Nn[i]);
-          const BoutReal tnsheath = 0.5 * (Tn[ig] + Tn[i]);
-
-          // Thermal speed of static Maxwellian in one direction
-          const BoutReal v_th = 0.25 * sqrt( 8*tnsheath / (PI*AA) );   // Stangeby p.69 eqns. 2.21, 2.24
-
-          // Calculate effective gamma from particle and energy reflection coefficients
-          BoutReal sol_gamma_heat = 1 - sol_energy_refl_factor * sol_fast_refl_fraction 
-                                    -(1-sol_fast_refl_fraction) * (3/Tnorm) / (2*tnsheath);  // D. Power thesis 2023
-
-          // Heat flux (> 0)
-          const BoutReal q = sol_gamma_heat * nnsheath * tnsheath * v_th;
+  // SOL and PFR edges
+  auto wallReflection = [&](const std::vector<WallCell>& cells,
+                            BoutReal energy_refl_factor, BoutReal fast_refl_fraction) {
+    for (const auto& cell : cells) {
+      const auto& i = cell.i;      // Final domain cell
+      const auto& ig = cell.guard; // Guard cell
 
-          // Multiply by radial cell area to get power
-          // Expanded form of the calculation for clarity
+      // Calculate midpoint values at wall
+      const BoutReal nnsheath = 0.5 * (Nn[ig] + Nn[i]);
+      const BoutReal tnsheath = 0.5 * (Tn[ig] + Tn[i]);
 
-          // Converts dy to poloidal length: dl = dy * sqrt(g22) = dy * h_theta
-          BoutReal dpolsheath = 0.5*(coord->dy[i] + coord->dy[ig]) *  1/( 0.5*(sqrt(coord->g22[i]) + sqrt(coord->g22[ig])) );
+      // Thermal speed of static Maxwellian in one direction
+      const BoutReal v_th = 0.25 * sqrt( 8*tnsheath / (PI*AA) );   // Stangeby p.69 eqns. 2.21, 2.24
 
-          // Converts dz to toroidal length:  = dz*sqrt(g_33) = dz * R = 2piR
-          BoutReal dtorsheath = 0.5*(coord->dz[i] + coord->dz[ig]) * 0.5*(sqrt(coord->g_33[i]) + sqrt(coord->g_33[ig]));
+      // Calculate effective gamma from particle and energy reflection coefficients
+      BoutReal gamma_heat = 1 - energy_refl_factor * fast_refl_fraction
+                            -(1-fast_refl_fraction) * (3/Tnorm) / (2*tnsheath);  // D. Power thesis 2023
 
-          BoutReal dasheath = dpolsheath * dtorsheath;  // [m^2]
-          BoutReal flux = q * dasheath;  // [W]
+      // Heat flux (> 0)
+      const BoutReal q = gamma_heat * nnsheath * tnsheath * v_th;
 
-          // Divide by volume of cell to get energy loss rate (> 0)
-          BoutReal power = flux / (coord->J[i] * coord->dx[i] * coord->dy[i] * coord->dz[i]);   // [W m^-3]
+      // Multiply by radial cell area to get power [W]
+      // Divide by volume of cell to get energy loss rate (> 0) [W m^-3]
+      BoutReal power = q * cell.area * cell.inv_volume;
 
-          // Subtract from cell next to boundary
-          energy_source[i] -= power;
-          wall_energy_source[i] -= power;
-
-        }
+      // Subtract from cell next to boundary
+      energy_source[i] -= power;
+      if (diagnose_now) {
+        wall_energy_source[i] -= power;
       }
     }
-  }
+  };
 
-  // PFR edge
+  if (sol) {
+    wallReflection(wall.sol, sol_energy_refl_factor, sol_fast_refl_fraction);
+  }
   if (pfr) {
-    if ((mesh->firstX()) and (!mesh->periodicY(mesh->xstart))) {  // do loop if inner edge and not periodic (i.e. PFR)
-      for(int iy=0; iy < mesh->LocalNy ; iy++){
-        for(int iz=0; iz < mesh->LocalNz; iz++){
-
-          auto i = indexAt(Nn, mesh->xstart, iy, iz);  // Final domain cell
-          auto ig = indexAt(Nn, mesh->xstart-1, iy, iz);  // Guard cell
-          
-          // Calculate midpoint values at wall
-          const BoutReal nnsheath = 0.5 * (Nn[ig] + Nn[i]);
-          const BoutReal tnsheath = 0.5 * (Tn[ig] + Tn[i]);
-
-          // Thermal speed of static Maxwellian in one direction
-          const BoutReal v_th = 0.25 * sqrt( 8*tnsheath / (PI*AA) );   // Stangeby p.69 eqns. 2.21, 2.24
-
-          
-          // Calculate effective gamma from particle and energy reflection coefficients
-          BoutReal pfr_gamma_heat = 1 - pfr_energy_refl_factor * pfr_fast_refl_fraction 
-                                    -(1-pfr_fast_refl_fraction) * (3/Tnorm) / (2*tnsheath);  // D. Power thesis 2023
-
-          // Heat flux (> 0)
-          const BoutReal q = pfr_gamma_heat * nnsheath * tnsheath * v_th;
-
-          // Multiply by radial cell area to get power
-          // Expanded form of the calculation for clarity
-
-          // Converts dy to poloidal length: dl = dy * sqrt(g22) = dy * h_theta
-          BoutReal dpolsheath = 0.5*(coord->dy[i] + coord->dy[ig]) *  1/( 0.5*(sqrt(coord->g22[i]) + sqrt(coord->g22[ig])) );
-
-          // Converts dz to toroidal length:  = dz*sqrt(g_33) = dz * R = 2piR
-          BoutReal dtorsheath = 0.5*(coord->dz[i] + coord->dz[ig]) * 0.5*(sqrt(coord->g_33[i]) + sqrt(coord->g_33[ig]));
-
-          BoutReal dasheath = dpolsheath * dtorsheath;  // [m^2]
-          BoutReal flux = q * dasheath;  // [W]
-
-          // Divide by volume of cell to get energy loss rate (> 0)
-          BoutReal power = flux / (coord->J[i] * coord->dx[i] * coord->dy[i] * coord->dz[i]);   // [W m^-3]
-
-          // Subtract from cell next to boundary
-          energy_source[i] -= power;
-          wall_energy_source[i] -= power;
-
-        }
-      }
-    }
+    wallReflection(wall.pfr, pfr_energy_refl_factor, pfr_fast_refl_fraction);
   }
 
   // Set density, pressure and temperature, now with boundary conditions
@@ -70,6 +70,12 @@ NeutralMixed::NeutralMixed(const std::string& name, Options& alloptions, Solver*
     inv->setOuterBoundaryFlags(INVERT_DC_GRAD | INVERT_AC_GRAD);
 
     inv->setCoefA(1.0);
+
+    precon_coefD = LaplacianCoefficient<Field3D>(
+        options["precon_coefficient_tolerance"]
+            .doc("Relative change in diffusion coefficient before updating the "
+                 "preconditioner. 0 means update if changed, < 0 always update")
+            .withDefault(0.0));
   }
 
   // Optionally output time derivatives
@@ -408,6 +414,12 @@ void NeutralMixed::finally(const Options& state) {
 #endif
 }
 
+void NeutralMixed::timeDerivs(Options& ddts) {
+  ddts[std::string("N") + name] = ddt(Nn);
+  ddts[std::string("P") + name] = ddt(Pn);
+  ddts[std::string("NV") + name] = ddt(NVn);
+}
+
 void NeutralMixed::outputVars(Options& state) {
   // Normalisations
   auto Nnorm = get<BoutReal>(state["Nnorm"]);
@@ -530,7 +542,12 @@ void NeutralMixed::precon(const Options& state, BoutReal gamma) {
     coef *= get<Field3D>(state["scale_timederivs"]);
   }
 
-  inv->setCoefD(coef);
+  // Only set if changed (by more than precon_coefficient_tolerance), so the
+  // solver setup can be reused. Lagging the coefficient only affects the
+  // preconditioner, not the solution.
+  if (precon_coefD.update(coef)) {
+    inv->setCoefD(precon_coefD.value());
+  }
 
   ddt(Nn) = inv->solve(ddt(Nn));
   ddt(NVn) = inv->solve(ddt(NVn));
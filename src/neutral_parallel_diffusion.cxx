@@ -65,7 +65,7 @@ void NeutralParallelDiffusion::transform(Options& state) {
       add(species["momentum_source"], F);
     }
 
-    if (diagnose) {
+    if (diagnose and isOutputStep(state)) {
       // Find the diagnostics struct for this species
       auto search = diagnostics.find(species_name);
       if (search == diagnostics.end()) {
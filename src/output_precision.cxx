@@ -0,0 +1,108 @@
+#include "../include/output_precision.hxx"
+
+#include <bout/boutexception.hxx>
+#include <bout/field2d.hxx>
+#include <bout/field3d.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+/// Number of bits in the mantissa of a double
+constexpr int double_bits = 52;
+
+/// Number of bits in the mantissa of a float
+constexpr int float_bits = 23;
+
+/// Return a rounded copy of \p field
+template <typename T>
+T roundField(const T& field, int bits) {
+  T result = copy(field);
+  BOUT_FOR(i, result.getRegion("RGN_ALL")) { result[i] = roundMantissa(result[i], bits); }
+  return result;
+}
+
+/// Number of mantissa bits for \p option, or double_bits to leave unchanged
+int optionBits(Options& option, BoutReal default_relative_error) {
+  if (option.hasAttribute("precision")) {
+    const auto precision = option.attributes["precision"].as<std::string>();
+    if (precision == "float32") {
+      return float_bits;
+    }
+    if (precision == "float64") {
+      return double_bits;
+    }
+    throw BoutException("Output precision of {} must be float32 or float64, not {}",
+                        option.name(), precision);
+  }
+  if (option.hasAttribute("relative_error")) {
+    return mantissaBits(option.attributes["relative_error"].as<BoutReal>());
+  }
+  if (default_relative_error > 0.0) {
+    option.attributes["relative_error"] = default_relative_error;
+  }
+  return mantissaBits(default_relative_error);
+}
+} // namespace
+
+BoutReal roundMantissa(BoutReal value, int bits) {
+  if ((bits >= double_bits) or !std::isfinite(value)) {
+    return value;
+  }
+  bits = std::max(bits, 1);
+
+  std::uint64_t binary;
+  std::memcpy(&binary, &value, sizeof(binary));
+
+  // Round to nearest. A carry out of the mantissa increments the exponent
+  const int drop = double_bits - bits;
+  const std::uint64_t half = std::uint64_t{1} << (drop - 1);
+  const std::uint64_t mask = ~((std::uint64_t{1} << drop) - 1);
+  binary = (binary + half) & mask;
+
+  std::memcpy(&value, &binary, sizeof(value));
+  return value;
+}
+
+int mantissaBits(BoutReal relative_error) {
+  if (relative_error <= 0.0) {
+    return double_bits; // Full precision
+  }
+  // Rounding error is at most 2^-(bits + 1)
+  const int bits = static_cast<int>(std::ceil(-std::log2(relative_error))) - 1;
+  return std::min(std::max(bits, 1), double_bits);
+}
+
+void reduceOutputPrecision(Options& options, BoutReal default_relative_error) {
+  for (const auto& kv : options.getChildren()) {
+    Options& option = options[kv.first];
+
+    if (option.isSection()) {
+      reduceOutputPrecision(option, default_relative_error);
+      continue;
+    }
+    if (!option.isSet() or !option.hasAttribute("time_dimension")) {
+      continue;
+    }
+
+    const bool is_field3d = bout::utils::holds_alternative<Field3D>(option.value);
+    const bool is_field2d = bout::utils::holds_alternative<Field2D>(option.value);
+    if (!(is_field3d or is_field2d)) {
+      continue;
+    }
+
+    const int bits = optionBits(option, default_relative_error);
+    if (bits >= double_bits) {
+      continue;
+    }
+
+    // Note: Fields share data, so the simulation fields must not be modified
+    if (is_field3d) {
+      option.value = roundField(bout::utils::get<Field3D>(option.value), bits);
+    } else {
+      option.value = roundField(bout::utils::get<Field2D>(option.value), bits);
+    }
+  }
+}
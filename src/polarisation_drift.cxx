@@ -54,6 +54,19 @@ PolarisationDrift::PolarisationDrift(std::string name,
           .doc("Include diamagnetic drift in polarisation current?")
           .withDefault<bool>(true);
 
+  // With boussinesq = true the coefficient is constant, so only set it
+  // when it changes. Otherwise it usually changes in every evaluation.
+  const BoutReal coefficient_tolerance =
+      options["coefficient_tolerance"]
+          .doc("Compare mass density with the last value before updating the phi "
+               "solver? 0 means update if changed, < 0 always update")
+          .withDefault(boussinesq ? 0.0 : -1.0);
+  if (coefficient_tolerance > 0.0) {
+    // Lagging the mass density would change the phi_pol which is solved for
+    throw BoutException("PolarisationDrift: coefficient_tolerance must be <= 0");
+  }
+  phiCoefC = LaplacianCoefficient<Field3D>(coefficient_tolerance);
+
   diagnose = options["diagnose"]
     .doc("Output additional diagnostics?")
     .withDefault<bool>(false);
@@ -167,7 +180,11 @@ void PolarisationDrift::transform(Options &state) {
   // Solve for time derivative of potential
   // Using Div(mass_density / B^2 Grad_perp(dphi/dt)) = DivJ
 
-  phiSolver->setCoefC(mass_density / Bsq);
+  // If coefficient_tolerance = 0, only set if changed so the solver setup
+  // can be reused. With boussinesq = true this is then only set once.
+  if (phiCoefC.update(mass_density / Bsq)) {
+    phiSolver->setCoefC(phiCoefC.value());
+  }
 
   // Calculate time derivative of generalised potential
   // The assumption is that the polarisation drift can be parameterised
@@ -2,8 +2,6 @@
 #include "../include/recycling.hxx"
 
 #include <bout/utils.hxx> // for trim, strsplit
-#include "../include/hermes_utils.hxx"  // For indexAt
-#include <bout/coordinates.hxx>
 #include <bout/mesh.hxx>
 #include <bout/constants.hxx>
 
@@ -29,6 +27,9 @@ Recycling::Recycling(std::string name, Options& alloptions, Solver*) {
   is_pump = 0.0;
   mesh->get(is_pump, std::string("is_pump"));
 
+  // Boundary cells and geometry, including pump locations
+  wall = WallBoundary(mesh, is_pump);
+
   for (const auto& species : species_list) {
     std::string from = trim(species, " \t\r()"); // The species name in the list
 
@@ -115,14 +116,8 @@ Recycling::Recycling(std::string name, Options& alloptions, Solver*) {
 void Recycling::transform(Options& state) {
   AUTO_TRACE();
 
-  // Get metric tensor components
-  Coordinates* coord = mesh->getCoordinates();
-  const Field2D& J = coord->J;
-  const Field2D& dy = coord->dy;
-  const Field2D& dx = coord->dx;
-  const Field2D& dz = coord->dz;
-  const Field2D& g_22 = coord->g_22;
-  const Field2D& g11 = coord->g11;
+  // Diagnostic sources are only needed for output
+  const bool diagnose_now = diagnose and isOutputStep(state);
 
   for (const auto& channel : channels) {
     const Options& species_from = state["species"][channel.from];
@@ -149,279 +144,142 @@ void Recycling::transform(Options& state) {
     // Recycling at the divertor target plates
     if (target_recycle) {
 
-      target_recycle_density_source = 0;
-      target_recycle_energy_source = 0;
+      if (diagnose_now) {
+        target_recycle_density_source = 0;
+        target_recycle_energy_source = 0;
+      }
 
-      // Lower Y boundary
+      // Calculate flux of ions into target from Ne and Vi boundary
+      // This calculation is supposed to be consistent with the flow
+      // of plasma from FV::Div_par(N, V)
+      auto targetRecycle = [&](const std::vector<WallCell>& cells) {
+        for (const auto& cell : cells) {
+          const auto& i = cell.i;
+          const auto& ig = cell.guard;
 
-      for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          // Calculate flux through surface [normalised m^-2 s^-1],
-          // should be positive since V < 0.0
-          BoutReal flux =
-              -0.5 * (N(r.ind, mesh->ystart, jz) + N(r.ind, mesh->ystart - 1, jz)) * 0.5
-              * (V(r.ind, mesh->ystart, jz) + V(r.ind, mesh->ystart - 1, jz));
+          // Flux through surface [normalised m^-2 s^-1], should be positive
+          BoutReal flux = cell.direction * 0.5 * (N[i] + N[ig]) * 0.5 * (V[i] + V[ig]);
 
           if (flux < 0.0) {
             flux = 0.0;
           }
 
           // Flow of recycled species inwards
-          BoutReal flow =
-              channel.target_multiplier * flux
-              * (J(r.ind, mesh->ystart) + J(r.ind, mesh->ystart - 1))
-              / (sqrt(g_22(r.ind, mesh->ystart)) + sqrt(g_22(r.ind, mesh->ystart - 1)));
-
-          // Add to density source
-          target_recycle_density_source(r.ind, mesh->ystart, jz) += flow 
-              / (J(r.ind, mesh->ystart) * dy(r.ind, mesh->ystart));
-          density_source(r.ind, mesh->ystart, jz) += flow 
-              / (J(r.ind, mesh->ystart) * dy(r.ind, mesh->ystart));
-
-          // energy of recycled particles
-          target_recycle_energy_source(r.ind, mesh->ystart, jz) += channel.target_energy * flow 
-              / (J(r.ind, mesh->ystart) * dy(r.ind, mesh->ystart));
-          energy_source(r.ind, mesh->ystart, jz) += channel.target_energy * flow 
-              / (J(r.ind, mesh->ystart) * dy(r.ind, mesh->ystart));
-        }
-      }
+          const BoutReal flow = channel.target_multiplier * flux * cell.area;
 
-      // Upper Y boundary
+          // Rate of change of neutrals in final cell
+          const BoutReal source = flow * cell.inv_volume;
 
-      for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-        // Calculate flux of ions into target from Ne and Vi boundary
-        // This calculation is supposed to be consistent with the flow
-        // of plasma from FV::Div_par(N, V)
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          // Flux through surface [normalised m^-2 s^-1], should be positive
-          BoutReal flux = 0.5 * (N(r.ind, mesh->yend, jz) + N(r.ind, mesh->yend + 1, jz))
-                          * 0.5 * (V(r.ind, mesh->yend, jz) + V(r.ind, mesh->yend + 1, jz));
+          // Add to density source, and energy of recycled particles
+          density_source[i] += source;
+          energy_source[i] += channel.target_energy * source;
 
-          if (flux < 0.0) {
-            flux = 0.0;
+          if (diagnose_now) {
+            target_recycle_density_source[i] += source;
+            target_recycle_energy_source[i] += channel.target_energy * source;
           }
-
-          // Flow of neutrals inwards
-          BoutReal flow =
-              channel.target_multiplier * flux * (J(r.ind, mesh->yend) + J(r.ind, mesh->yend + 1))
-              / (sqrt(g_22(r.ind, mesh->yend)) + sqrt(g_22(r.ind, mesh->yend + 1)));
-
-          // Rate of change of neutrals in final cell
-          // Add to density source
-          target_recycle_density_source(r.ind, mesh->yend, jz) += flow 
-              / (J(r.ind, mesh->yend) * dy(r.ind, mesh->yend));
-          density_source(r.ind, mesh->yend, jz) += flow 
-              / (J(r.ind, mesh->yend) * dy(r.ind, mesh->yend));
-
-          target_recycle_energy_source(r.ind, mesh->yend, jz) += channel.target_energy * flow 
-              / (J(r.ind, mesh->yend) * dy(r.ind, mesh->yend));
-          energy_source(r.ind, mesh->yend, jz) += channel.target_energy * flow 
-              / (J(r.ind, mesh->yend) * dy(r.ind, mesh->yend));
         }
-      }
+      };
+
+      targetRecycle(wall.lower_target);
+      targetRecycle(wall.upper_target);
     }
 
     // Initialise counters of pump recycling fluxes
-    pump_recycle_density_source = 0;
-    pump_recycle_energy_source = 0;
-    wall_recycle_density_source = 0;
-    wall_recycle_energy_source = 0;
-
-    // Recycling at the SOL edge (2D/3D only)
-    if (sol_recycle) {
-
-      // Flow out of domain is positive in the positive coordinate direction
-      radial_particle_outflow = get<Field3D>(species_from["particle_flow_xlow"]);
+    if (diagnose_now) {
+      pump_recycle_density_source = 0;
+      pump_recycle_energy_source = 0;
+      wall_recycle_density_source = 0;
+      wall_recycle_energy_source = 0;
+    }
 
-      if(mesh->lastX()){  // Only do this for the processor which has the edge region
-        for(int iy=0; iy < mesh->LocalNy ; iy++){
-          for(int iz=0; iz < mesh->LocalNz; iz++){
-
-            // Volume of cell adjacent to wall which will receive source
-            BoutReal volume = J(mesh->xend, iy) * dx(mesh->xend, iy)
-                 * dy(mesh->xend, iy) * dz(mesh->xend, iy);
-
-            // If cell is a pump, overwrite multiplier with pump multiplier
-            BoutReal multiplier = channel.pfr_multiplier;
-            if ((is_pump(mesh->xend, iy) == 1.0) and (neutral_pump)) {
-              multiplier = channel.pump_multiplier;
-            }
-
-            // Flow of recycled species back from the edge
-            // SOL edge = LHS flow of inner guard cells on the high X side (mesh->xend+1)
-            // Recycling source is 0 for each cell where the flow goes into instead of out of the domain
-            BoutReal recycle_particle_flow = 0;
-            if (radial_particle_outflow(mesh->xend+1, iy, iz) > 0) {
-              recycle_particle_flow = multiplier * radial_particle_outflow(mesh->xend+1, iy, iz); 
-            } 
-
-            // Divide by volume to get source
-            BoutReal recycle_source = recycle_particle_flow / volume;
-
-            // Pump source terms
-            BoutReal esink = 0;
-            BoutReal psink = 0;
-
-            // Compute the neutral loss sink and combine with the recycled source to compute overall neutral sources
-            if ((is_pump(mesh->xend, iy) == 1.0) and (neutral_pump)) {
-
-              auto i = indexAt(Nn, mesh->xend, iy, iz);   // Final domain cell
-              auto is = i.xm();   // Second to final domain cell
-              auto ig = i.xp();   // First guard cell
-
-              // Free boundary condition on Nn, Pn, Tn
-              // These are NOT communicated back into state and will exist only in this component
-              // This will prevent neutrals leaking through cross-field transport from neutral_mixed or other components
-              // While enabling us to still calculate radial wall fluxes separately here
-              BoutReal nnguard = SQ(Nn[i]) / Nn[is];
-              BoutReal pnguard = SQ(Pn[i]) / Pn[is];
-              BoutReal tnguard = SQ(Tn[i]) / Tn[is];
-
-              // Calculate wall conditions
-              BoutReal nnsheath = 0.5 * (Nn[i] + nnguard);
-              BoutReal tnsheath = 0.5 * (Tn[i] + tnguard);
-              BoutReal v_th = 0.25 * sqrt( 8*tnsheath / (PI*AAn) );   // Stangeby p.69 eqns. 2.21, 2.24
-
-              // Convert dy to poloidal length: dl = dy * sqrt(g22) = dy * h_theta
-              // Convert dz to toroidal length:  = dz*sqrt(g_33) = dz * R = 2piR
-              // Calculate radial wall area in [m^2]
-              // Calculate final cell volume [m^3]
-              BoutReal dpolsheath = 0.5*(coord->dy[i] + coord->dy[ig]) *  1/( 0.5*(sqrt(coord->g22[i]) + sqrt(coord->g22[ig])) );
-              BoutReal dtorsheath = 0.5*(coord->dz[i] + coord->dz[ig]) * 0.5*(sqrt(coord->g_33[i]) + sqrt(coord->g_33[ig]));
-              BoutReal dasheath = dpolsheath * dtorsheath;  // [m^2]
-              BoutReal dv = coord->J[i] * coord->dx[i] * coord->dy[i] * coord->dz[i];
-
-              // Calculate particle and energy fluxes of neutrals hitting the pump
-              // Assume thermal velocity greater than perpendicular velocity and use it for flux calc
-              BoutReal pflow = v_th * nnsheath * dasheath;   // [s^-1]
-              psink = pflow / dv * (1 - multiplier);   // Particle sink [s^-1 m^-3]
-
-              // Use gamma=2.0 as per Stangeby p.69, total energy of static Maxwellian
-              BoutReal eflow = 2.0 * tnsheath * v_th * nnsheath * dasheath;   // [W]
-              esink = eflow / dv * (1 - multiplier);   // heatsink [W m^-3]
-
-              // Pump puts neutral particle and energy source in final domain cell
-              // Source accounts for recycled ions and the particle sink due to neutrals hitting the pump
-              // Note that the ions are explicitly transported out of the domain by anomalous_diffusion.cxx
-              // the pump picks this up and adds a recycling source based on this, but doesn't need an ion sink.
-              // Neutrals are not explicitly transported out by any component and must be taken out by the sink below.
-              // Pump multiplier controls both fraction of recycled ions and fraction of returned neutrals 
-              pump_recycle_density_source(mesh->xend, iy, iz) += recycle_source - psink;
-              pump_recycle_energy_source(mesh->xend, iy, iz) += recycle_source * channel.sol_energy - esink;
-
-            } else {
-              wall_recycle_density_source(mesh->xend, iy, iz) += recycle_source;
-              wall_recycle_energy_source(mesh->xend, iy, iz) += recycle_source * channel.sol_energy;
-            }
-
-            // Add to density source which will be picked up by evolve_density.cxx
-            // Add to energy source which will be picked up by evolve_pressure.cxx
-            // psink and esink are additional sinks from the neutral pump which are 0 if disabled
-            density_source(mesh->xend, iy, iz) += recycle_source - psink;
-            energy_source(mesh->xend, iy, iz) += recycle_source * channel.pfr_energy - esink;
+    // Recycling at the SOL and PFR edges (2D/3D only)
+    auto wallRecycle = [&](const std::vector<WallCell>& cells, BoutReal wall_multiplier,
+                           BoutReal recycle_energy) {
+      for (const auto& cell : cells) {
+        const auto& i = cell.i;    // Final domain cell
+        const auto& is = cell.inner; // Second to final domain cell
+
+        const bool pump = cell.pump and neutral_pump;
+
+        // If cell is a pump, overwrite multiplier with pump multiplier
+        const BoutReal multiplier = pump ? channel.pump_multiplier : wall_multiplier;
+
+        // Flow of recycled species back from the edge
+        // SOL edge = LHS flow of inner guard cells on the high X side (mesh->xend+1)
+        // PFR edge = LHS flow of the first domain cell on the low X side (mesh->xstart)
+        // Flow out of domain is positive in the positive coordinate direction,
+        // so the PFR outflow is in the negative coordinate direction.
+        // Recycling source is 0 for each cell where the flow goes into instead of out of the domain
+        const BoutReal outflow =
+            cell.direction * radial_particle_outflow[(cell.direction > 0) ? cell.guard : i];
+        BoutReal recycle_particle_flow = 0;
+        if (outflow > 0) {
+          recycle_particle_flow = multiplier * outflow;
+        }
 
+        // Divide by volume to get source
+        const BoutReal recycle_source = recycle_particle_flow * cell.inv_volume;
+
+        // Pump source terms
+        BoutReal esink = 0;
+        BoutReal psink = 0;
+
+        // Compute the neutral loss sink and combine with the recycled source to compute overall neutral sources
+        if (pump) {
+          // Free boundary condition on Nn, Tn
+          // These are NOT communicated back into state and will exist only in this component
+          // This will prevent neutrals leaking through cross-field transport from neutral_mixed or other components
+          // While enabling us to still calculate radial wall fluxes separately here
+          const BoutReal nnguard = SQ(Nn[i]) / Nn[is];
+          const BoutReal tnguard = SQ(Tn[i]) / Tn[is];
+
+          // Calculate wall conditions
+          const BoutReal nnsheath = 0.5 * (Nn[i] + nnguard);
+          const BoutReal tnsheath = 0.5 * (Tn[i] + tnguard);
+          const BoutReal v_th = 0.25 * sqrt( 8*tnsheath / (PI*AAn) );   // Stangeby p.69 eqns. 2.21, 2.24
+
+          // Calculate particle and energy fluxes of neutrals hitting the pump
+          // Assume thermal velocity greater than perpendicular velocity and use it for flux calc
+          const BoutReal pflow = v_th * nnsheath * cell.area;   // [s^-1]
+          psink = pflow * cell.inv_volume * (1 - multiplier);   // Particle sink [s^-1 m^-3]
+
+          // Use gamma=2.0 as per Stangeby p.69, total energy of static Maxwellian
+          const BoutReal eflow = 2.0 * tnsheath * v_th * nnsheath * cell.area;   // [W]
+          esink = eflow * cell.inv_volume * (1 - multiplier);   // heatsink [W m^-3]
+
+          // Pump puts neutral particle and energy source in final domain cell
+          // Source accounts for recycled ions and the particle sink due to neutrals hitting the pump
+          // Note that the ions are explicitly transported out of the domain by anomalous_diffusion.cxx
+          // the pump picks this up and adds a recycling source based on this, but doesn't need an ion sink.
+          // Neutrals are not explicitly transported out by any component and must be taken out by the sink below.
+          // Pump multiplier controls both fraction of recycled ions and fraction of returned neutrals 
+          if (diagnose_now) {
+            pump_recycle_density_source[i] += recycle_source - psink;
+            pump_recycle_energy_source[i] += recycle_source * recycle_energy - esink;
           }
+
+        } else if (diagnose_now) {
+          wall_recycle_density_source[i] += recycle_source;
+          wall_recycle_energy_source[i] += recycle_source * recycle_energy;
         }
+
+        // Add to density source which will be picked up by evolve_density.cxx
+        // Add to energy source which will be picked up by evolve_pressure.cxx
+        // psink and esink are additional sinks from the neutral pump which are 0 if disabled
+        density_source[i] += recycle_source - psink;
+        energy_source[i] += recycle_source * recycle_energy - esink;
       }
-    }
+    };
 
-    // Recycling at the PFR edge (2D/3D only)
+    if (sol_recycle or pfr_recycle) {
+      radial_particle_outflow = get<Field3D>(species_from["particle_flow_xlow"]);
+    }
+    if (sol_recycle) {
+      wallRecycle(wall.sol, channel.sol_multiplier, channel.sol_energy);
+    }
     if (pfr_recycle) {
-
-      // PFR is flipped compared to edge: x=0 is at the PFR edge. Therefore outflow is in the negative coordinate direction.
-      radial_particle_outflow = get<Field3D>(species_from["particle_flow_xlow"]) * -1;
-
-      if(mesh->firstX()){   // Only do this for the processor which has the core region
-        if (!mesh->periodicY(mesh->xstart)) {   // Only do this for the processor with a periodic Y, i.e. the PFR
-          for(int iy=0; iy < mesh->LocalNy ; iy++){
-            for(int iz=0; iz < mesh->LocalNz; iz++){
-            
-
-              // Volume of cell adjacent to wall which will receive source
-              BoutReal volume = J(mesh->xstart, iy) * dx(mesh->xstart, iy)
-                  * dy(mesh->xstart, iy) * dz(mesh->xstart, iy);
-
-              // If cell is a pump, overwrite multiplier with pump multiplier
-              BoutReal multiplier = channel.pfr_multiplier;
-              if ((is_pump(mesh->xstart, iy, iz) == 1.0) and (neutral_pump))  {
-                multiplier = channel.pump_multiplier;
-              }
-              
-              // Flow of recycled species back from the edge
-              // PFR edge = LHS flow of the first domain cell on the low X side (mesh->xstart)
-              // Recycling source is 0 for each cell where the flow goes into instead of out of the domain
-              BoutReal recycle_particle_flow = 0;
-              if (radial_particle_outflow(mesh->xstart, iy, iz) > 0) { 
-                recycle_particle_flow = multiplier * radial_particle_outflow(mesh->xstart, iy, iz); 
-              }
-
-              // Divide by volume to get source
-              BoutReal recycle_source = recycle_particle_flow / volume;
-
-              // Pump source terms
-              BoutReal esink = 0;
-              BoutReal psink = 0;
-
-              // Add to appropriate diagnostic field depending if pump or not
-              if ((is_pump(mesh->xstart, iy) == 1.0) and (neutral_pump))  {
-                auto i = indexAt(Nn, mesh->xstart, iy, iz);   // Final domain cell
-                auto is = i.xp();   // Second to final domain cell
-                auto ig = i.xm();   // First guard cell
-
-                // Free boundary condition on Nn, Pn, Tn
-                // These are NOT communicated back into state and will exist only in this component
-                // This will prevent neutrals leaking through cross-field transport from neutral_mixed or other components
-                // While enabling us to still calculate radial wall fluxes separately here
-                BoutReal nnguard = SQ(Nn[i]) / Nn[is];
-                BoutReal pnguard = SQ(Pn[i]) / Pn[is];
-                BoutReal tnguard = SQ(Tn[i]) / Tn[is];
-
-                // Calculate wall conditions
-                BoutReal nnsheath = 0.5 * (Nn[i] + nnguard);
-                BoutReal tnsheath = 0.5 * (Tn[i] + tnguard);
-                BoutReal v_th = 0.25 * sqrt( 8*tnsheath / (PI*AAn) );   // Stangeby p.69 eqns. 2.21, 2.24
-
-                // Convert dy to poloidal length: dl = dy * sqrt(g22) = dy * h_theta
-                // Convert dz to toroidal length:  = dz*sqrt(g_33) = dz * R = 2piR
-                // Calculate radial wall area in [m^2]
-                // Calculate final cell volume [m^3]
-                BoutReal dpolsheath = 0.5*(coord->dy[i] + coord->dy[ig]) *  1/( 0.5*(sqrt(coord->g22[i]) + sqrt(coord->g22[ig])) );
-                BoutReal dtorsheath = 0.5*(coord->dz[i] + coord->dz[ig]) * 0.5*(sqrt(coord->g_33[i]) + sqrt(coord->g_33[ig]));
-                BoutReal dasheath = dpolsheath * dtorsheath;  // [m^2]
-                BoutReal dv = coord->J[i] * coord->dx[i] * coord->dy[i] * coord->dz[i];
-
-                // Calculate particle and energy fluxes of neutrals hitting the pump
-                // Assume thermal velocity greater than perpendicular velocity and use it for flux calc
-                BoutReal pflow = v_th * nnsheath * dasheath;   // [s^-1]
-                psink = pflow / dv * (1 - multiplier);   // Particle sink [s^-1 m^-3]
-
-                // Use gamma=2.0 as per Stangeby p.69, total energy of static Maxwellian
-                BoutReal eflow = 2.0 * tnsheath * v_th * nnsheath * dasheath;   // [W]
-                esink = eflow / dv * (1 - multiplier);   // heatsink [W m^-3]
-
-                // Pump puts neutral particle and energy source in final domain cell
-                // Source accounts for recycled ions and the particle sink due to neutrals hitting the pump
-                // Note that the ions are explicitly transported out of the domain by anomalous_diffusion.cxx
-                // the pump picks this up and adds a recycling source based on this, but doesn't need an ion sink.
-                // Neutrals are not explicitly transported out by any component and must be taken out by the sink below.
-                // Pump multiplier controls both fraction of recycled ions and fraction of returned neutrals 
-                pump_recycle_density_source(mesh->xend, iy, iz) += recycle_source - psink;
-                pump_recycle_energy_source(mesh->xend, iy, iz) += recycle_source * channel.sol_energy - esink;
-              } else {
-                wall_recycle_density_source(mesh->xstart, iy, iz) += recycle_source;
-                wall_recycle_energy_source(mesh->xstart, iy, iz) += recycle_source * channel.pfr_energy;
-              }
-            
-              // Add to density source which will be picked up by evolve_density.cxx
-              // Add to energy source which will be picked up by evolve_pressure.cxx
-              // psink and esink are additional sinks from the neutral pump which are 0 if disabled
-              density_source(mesh->xend, iy, iz) += recycle_source - psink;
-              energy_source(mesh->xend, iy, iz) += recycle_source * channel.pfr_energy - esink;
-
-            }
-          }
-        }
-      }
+      wallRecycle(wall.pfr, channel.pfr_multiplier, channel.pfr_energy);
     }
 
     // Put the updated sources back into the state
@@ -253,6 +253,11 @@ void RelaxPotential::finally(const Options& state) {
   }
 }
 
+void RelaxPotential::timeDerivs(Options& ddts) {
+  ddts["Vort"] = ddt(Vort);
+  ddts["phi1"] = ddt(phi1);
+}
+
 void RelaxPotential::outputVars(Options& state) {
   AUTO_TRACE();
   // Normalisations
@@ -0,0 +1,261 @@
+#include "../include/restart_interpolation.hxx"
+
+#include <bout/assert.hxx>
+#include <bout/boutexception.hxx>
+#include <bout/field3d.hxx>
+#include <bout/mesh.hxx>
+#include <bout/options_netcdf.hxx>
+#include <bout/output.hxx>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace {
+/// Segment boundaries: 0, the interior boundaries in (0, n), then n
+std::vector<int> segmentBounds(std::vector<int> boundaries, int n) {
+  std::vector<int> result{0};
+  std::sort(boundaries.begin(), boundaries.end());
+  for (int b : boundaries) {
+    if ((b > result.back()) and (b < n)) {
+      result.push_back(b);
+    }
+  }
+  result.push_back(n);
+  return result;
+}
+
+/// Read an integer from restart file options, or use a default
+int getInt(const Options& options, const std::string& name, int default_value) {
+  return options.isSet(name) ? options[name].as<int>() : default_value;
+}
+
+/// Layout and topology of a mesh
+struct MeshLayout {
+  int nx;  ///< Global X size, including boundary cells
+  int ny;  ///< Global Y size, excluding boundary cells
+  int nz;
+  int mxg; ///< Number of X guard cells
+  std::vector<int> x_bounds; ///< Segments in X
+  std::vector<int> y_bounds; ///< Segments in Y
+};
+
+MeshLayout layoutFrom(int nx, int ny, int nz, int mxg, int ixseps1, int ixseps2,
+                      int jyseps1_1, int jyseps2_1, int jyseps1_2, int jyseps2_2,
+                      int ny_inner) {
+  return {nx, ny, nz, mxg,
+          segmentBounds({mxg, ixseps1, ixseps2, nx - mxg}, nx),
+          segmentBounds({jyseps1_1 + 1, jyseps2_1 + 1, ny_inner, jyseps1_2 + 1,
+                         jyseps2_2 + 1},
+                        ny)};
+}
+} // namespace
+
+InterpolationWeights interpolationWeights(int index, const std::vector<int>& new_bounds,
+                                          const std::vector<int>& old_bounds) {
+  ASSERT1(new_bounds.size() == old_bounds.size());
+  ASSERT1(new_bounds.size() >= 2);
+
+  // Clamp to the grid, e.g. Y boundary cells
+  index = std::min(std::max(index, new_bounds.front()), new_bounds.back() - 1);
+
+  // Find the segment containing index
+  std::size_t k = 0;
+  while (index >= new_bounds[k + 1]) {
+    ++k;
+  }
+
+  const int old_start = old_bounds[k];
+  const int old_end = old_bounds[k + 1]; // One past the last cell
+  if (old_end <= old_start) {
+    throw BoutException("Restart interpolation: No cells in old grid segment {}", k);
+  }
+
+  // Position of the cell centre as a fraction of the segment
+  const BoutReal fraction =
+      (index + 0.5 - new_bounds[k]) / (new_bounds[k + 1] - new_bounds[k]);
+  const BoutReal position = old_start + fraction * (old_end - old_start) - 0.5;
+
+  if (position <= old_start) {
+    return {old_start, old_start, 0.0};
+  }
+  if (position >= old_end - 1) {
+    return {old_end - 1, old_end - 1, 0.0};
+  }
+  const int lower = static_cast<int>(std::floor(position));
+  return {lower, lower + 1, position - lower};
+}
+
+Options interpolateRestart(const std::string& path, Mesh* mesh) {
+  AUTO_TRACE();
+
+  auto filename = [&](int rank) { return fmt::format("{}/BOUT.restart.{}.nc", path, rank); };
+
+  // Layout of the old mesh, from the first file
+  Options first = bout::OptionsNetCDF(filename(0)).read();
+
+  const int nxpe = getInt(first, "NXPE", 1);
+  const int nype = getInt(first, "NYPE", 1);
+  const int mxsub = first["MXSUB"].as<int>();
+  const int mysub = first["MYSUB"].as<int>();
+  const int mxg = getInt(first, "MXG", 2);
+  const int myg = getInt(first, "MYG", 2);
+
+  const int nx_old = nxpe * mxsub + 2 * mxg;
+  const int ny_old = nype * mysub;
+
+  // Collect 3D variables and scalars
+  Options result;
+  std::map<std::string, std::vector<BoutReal>> old_data;
+  int nz_old = -1;
+  for (const auto& kv : first.getChildren()) {
+    const Options& var = kv.second;
+    if (!var.isSet()) {
+      continue;
+    }
+    if (bout::utils::holds_alternative<Tensor<BoutReal>>(var.value)) {
+      const auto& tensor = bout::utils::get<Tensor<BoutReal>>(var.value);
+      nz_old = std::get<2>(tensor.shape());
+      old_data[kv.first].resize(static_cast<std::size_t>(nx_old) * ny_old * nz_old);
+    } else if (bout::utils::holds_alternative<int>(var.value)
+               or bout::utils::holds_alternative<BoutReal>(var.value)) {
+      result[kv.first] = var;
+    }
+  }
+  if (old_data.empty()) {
+    throw BoutException("No 3D variables in {}", filename(0));
+  }
+
+  // Interpolation in Y is at fixed Z index, which is only along field lines
+  // if fields are stored in field-aligned coordinates
+  Options& paralleltransform = Options::root()["mesh"]["paralleltransform"];
+  if (((nz_old > 1) or (mesh->LocalNz > 1)) and paralleltransform.isSet("type")
+      and (paralleltransform["type"].as<std::string>() != "identity")) {
+    throw BoutException("Restart interpolation: Only implemented for nz = 1 "
+                        "or paralleltransform:type = identity");
+  }
+
+  const MeshLayout old_layout =
+      layoutFrom(nx_old, ny_old, nz_old, mxg, getInt(first, "ixseps1", nx_old),
+                 getInt(first, "ixseps2", nx_old), getInt(first, "jyseps1_1", -1),
+                 getInt(first, "jyseps2_1", ny_old / 2), getInt(first, "jyseps1_2", ny_old / 2),
+                 getInt(first, "jyseps2_2", ny_old - 1),
+                 getInt(first, "ny_inner", ny_old / 2));
+
+  // Layout of the new mesh
+  auto meshInt = [&](const std::string& name, int default_value) {
+    int value;
+    mesh->get(value, name, default_value);
+    return value;
+  };
+  const int nx_new = mesh->GlobalNx;
+  const int ny_new = mesh->GlobalNyNoBoundaries;
+  const int nz_new = mesh->LocalNz;
+  const MeshLayout new_layout = layoutFrom(
+      nx_new, ny_new, nz_new, mesh->xstart, meshInt("ixseps1", nx_new),
+      meshInt("ixseps2", nx_new), meshInt("jyseps1_1", -1), meshInt("jyseps2_1", ny_new / 2),
+      meshInt("jyseps1_2", ny_new / 2), meshInt("jyseps2_2", ny_new - 1),
+      meshInt("ny_inner", ny_new / 2));
+
+  if ((new_layout.x_bounds.size() != old_layout.x_bounds.size())
+      or (new_layout.y_bounds.size() != old_layout.y_bounds.size())) {
+    throw BoutException("Restart interpolation: Old and new meshes have different topology");
+  }
+
+  // Range of old cells used by the local cells, including guard cells
+  int x_min = nx_old, x_max = -1, y_min = ny_old, y_max = -1;
+  for (int x = 0; x < mesh->LocalNx; ++x) {
+    const auto wx = interpolationWeights(mesh->getGlobalXIndex(x), new_layout.x_bounds,
+                                         old_layout.x_bounds);
+    x_min = std::min(x_min, wx.lower);
+    x_max = std::max(x_max, wx.upper);
+  }
+  for (int y = 0; y < mesh->LocalNy; ++y) {
+    const auto wy = interpolationWeights(mesh->getGlobalYIndexNoBoundaries(y),
+                                         new_layout.y_bounds, old_layout.y_bounds);
+    y_min = std::min(y_min, wy.lower);
+    y_max = std::max(y_max, wy.upper);
+  }
+
+  // Read the domain cells and X boundary cells from the processors
+  // which overlap this processor. Processor index is pe_y * nxpe + pe_x
+  for (int pe = 0; pe < nxpe * nype; ++pe) {
+    const int pe_x = pe % nxpe;
+    const int pe_y = pe / nxpe;
+
+    const int xstart = (pe_x == 0) ? 0 : mxg;
+    const int xend = (pe_x == nxpe - 1) ? mxsub + 2 * mxg : mxsub + mxg;
+
+    if ((pe_x * mxsub + xend <= x_min) or (pe_x * mxsub + xstart > x_max)
+        or ((pe_y + 1) * mysub <= y_min) or (pe_y * mysub > y_max)) {
+      continue; // Not needed on this processor
+    }
+    const Options file = (pe == 0) ? first : bout::OptionsNetCDF(filename(pe)).read();
+
+    for (auto& kv : old_data) {
+      const auto& tensor = file[kv.first].as<Tensor<BoutReal>>();
+      auto& data = kv.second;
+      for (int x = xstart; x < xend; ++x) {
+        const int gx = pe_x * mxsub + x;
+        for (int y = myg; y < mysub + myg; ++y) {
+          const int gy = pe_y * mysub + y - myg;
+          for (int z = 0; z < nz_old; ++z) {
+            data[(static_cast<std::size_t>(gx) * ny_old + gy) * nz_old + z] = tensor(x, y, z);
+          }
+        }
+      }
+    }
+  }
+
+  output_info.write("Interpolating restart from {}: {}x{}x{} to {}x{}x{}\n", path, nx_old,
+                    ny_old, nz_old, nx_new, ny_new, nz_new);
+
+  // Interpolate onto local cells, including guard cells
+  for (const auto& kv : old_data) {
+    const auto& data = kv.second;
+    auto at = [&](int x, int y, int z) {
+      return data[(static_cast<std::size_t>(x) * ny_old + y) * nz_old + z];
+    };
+
+    Field3D field{0.0, mesh};
+    BOUT_FOR(i, field.getRegion("RGN_ALL")) {
+      const auto wx = interpolationWeights(mesh->getGlobalXIndex(i.x()),
+                                           new_layout.x_bounds, old_layout.x_bounds);
+      const auto wy = interpolationWeights(mesh->getGlobalYIndexNoBoundaries(i.y()),
+                                           new_layout.y_bounds, old_layout.y_bounds);
+
+      // Periodic in Z
+      const BoutReal zpos = static_cast<BoutReal>(i.z()) * nz_old / nz_new;
+      const int z0 = static_cast<int>(std::floor(zpos)) % nz_old;
+      const int z1 = (z0 + 1) % nz_old;
+      const BoutReal wz = zpos - std::floor(zpos);
+
+      BoutReal value = 0.0;
+      for (const auto& xw : {std::make_pair(wx.lower, 1. - wx.weight),
+                             std::make_pair(wx.upper, wx.weight)}) {
+        for (const auto& yw : {std::make_pair(wy.lower, 1. - wy.weight),
+                               std::make_pair(wy.upper, wy.weight)}) {
+          value += xw.second * yw.second
+                   * ((1. - wz) * at(xw.first, yw.first, z0) + wz * at(xw.first, yw.first, z1));
+        }
+      }
+      field[i] = value;
+    }
+    result[kv.first] = field;
+  }
+
+  return result;
+}
+
+Options interpolatedState(const Options& interpolated) {
+  Options result;
+  for (const auto& kv : interpolated.getChildren()) {
+    if (kv.second.isSet()
+        and bout::utils::holds_alternative<Field3D>(kv.second.value)) {
+      result[kv.first] = kv.second;
+    }
+  }
+  return result;
+}
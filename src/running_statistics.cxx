@@ -0,0 +1,173 @@
+#include "../include/running_statistics.hxx"
+
+#include <bout/mesh.hxx>
+#include <bout/utils.hxx> // for trim, strsplit
+
+#include <cmath>
+#include <type_traits>
+
+using bout::globals::mesh;
+
+RunningStatistics::RunningStatistics(std::string name, Options& alloptions, Solver*) {
+  AUTO_TRACE();
+
+  Options& options = alloptions[name];
+
+  if (!alloptions["solver"]["monitor_timestep"].withDefault<bool>(false)) {
+    throw BoutException("{}: Samples are taken after each solver timestep, so "
+                        "solver:monitor_timestep must be true",
+                        name);
+  }
+  // Only these solvers evaluate the model with the accepted solution at
+  // the start of the next step, so that it can be sampled. Implicit
+  // solvers' last evaluations are iterations, and their solutions are
+  // not available to the model (see ComponentScheduler::timestepAccepted)
+  const std::string solver_type = alloptions["solver"].isSet("type")
+                                      ? alloptions["solver"]["type"].as<std::string>()
+                                      : "cvode"; // BOUT++ default
+  if ((solver_type != "euler") and (solver_type != "rk4") and (solver_type != "rk3ssp")
+      and (solver_type != "rkgeneric")) {
+    throw BoutException("{}: Accepted states can't be sampled with solver:type = {}. "
+                        "Use an explicit solver: euler, rk4, rk3ssp or rkgeneric",
+                        name, solver_type);
+  }
+
+  moments = options["moments"]
+                .doc("Highest moment: 1 = mean, 2 = variance, 3 = skewness, 4 = kurtosis")
+                .withDefault<int>(2);
+  if ((moments < 1) or (moments > 4)) {
+    throw BoutException("{}: moments must be between 1 and 4, not {}", name, moments);
+  }
+
+  sample_interval = options["sample_interval"]
+                        .doc("Time between samples [normalised]. Must be > 0")
+                        .as<BoutReal>();
+  if (sample_interval <= 0.0) {
+    throw BoutException("{}: sample_interval must be > 0, not {}", name, sample_interval);
+  }
+
+  z_average = options["z_average"].doc("Average over Z before sampling?").withDefault<bool>(false);
+  z_index = options["z_index"]
+                .doc("Only sample this Z index. < 0 means all Z")
+                .withDefault<int>(-1);
+  if (z_average and (z_index >= 0)) {
+    throw BoutException("{}: Can't set both z_average and z_index", name);
+  }
+  if (z_index >= mesh->LocalNz) {
+    throw BoutException("{}: z_index {} out of range", name, z_index);
+  }
+
+  reset_on_output = options["reset_on_output"]
+                        .doc("Only use samples since the last output?")
+                        .withDefault<bool>(true);
+
+  for (const auto& variable : strsplit(options["variables"]
+                                           .doc("Comma-separated list of state variables "
+                                                "e.g. species:e:density")
+                                           .as<std::string>(),
+                                       ',')) {
+    const std::string var_path = trim(variable, " \t\r");
+    if (var_path.empty()) {
+      continue;
+    }
+    Variable var{{}, "", Moments<Field3D>(moments), Moments<Field2D>(moments)};
+    for (const auto& part : strsplit(var_path, ':')) {
+      var.path.push_back(trim(part, " \t\r"));
+    }
+    for (std::size_t i = (var.path.front() == "species") ? 1 : 0; i < var.path.size(); ++i) {
+      var.label += (var.label.empty() ? "" : "_") + var.path[i];
+    }
+    variables.push_back(std::move(var));
+  }
+
+  last_sample = 0;
+}
+
+void RunningStatistics::sample(Variable& var, const Field3D& value) {
+  if (z_average) {
+    var.moments2d.add(DC(value));
+  } else if (z_index >= 0) {
+    Field2D slice{emptyFrom(DC(value))};
+    BOUT_FOR(i, slice.getRegion("RGN_ALL")) {
+      slice[i] = value(i.x(), i.y(), z_index);
+    }
+    var.moments2d.add(slice);
+  } else {
+    var.moments3d.add(value);
+  }
+}
+
+void RunningStatistics::timestepAccepted(const Options& state) {
+  AUTO_TRACE();
+
+  // Samples are taken at multiples of sample_interval, independent of
+  // the solver timesteps
+  const BoutReal time = getNonFinal<BoutReal>(state["time"]);
+  const auto sample_index = static_cast<long>(std::floor(time / sample_interval));
+  if (sampled and (sample_index <= last_sample)) {
+    return; // Already sampled. Ignores time going backwards.
+  }
+  sampled = true;
+  last_sample = sample_index;
+
+  for (auto& var : variables) {
+    const Options* option = &state;
+    for (const auto& name : var.path) {
+      if (!option->isSection(name) and !option->isSet(name)) {
+        throw BoutException("running_statistics: {} is not in the state", var.label);
+      }
+      option = &(*option)[name];
+    }
+    sample(var, getNonFinal<Field3D>(*option));
+  }
+}
+
+void RunningStatistics::outputVars(Options& state) {
+  AUTO_TRACE();
+
+  auto saveMoments = [&](const auto& stats, const std::string& label) {
+    using T = std::decay_t<decltype(stats.mean())>;
+    set_with_attrs(state[label + "_samples"], stats.samples(),
+                   {{"time_dimension", "t"},
+                    {"long_name", "Number of samples of " + label},
+                    {"source", "running_statistics"}});
+    // Every output is written, so that the output variables are the same
+    // at all times. Moments are NaN if there are no samples.
+    const bool empty = (stats.samples() == 0);
+    // Copy, since the mean is modified as samples are added
+    set_with_attrs(state[label + "_mean"], empty ? T(BoutNaN) : copy(stats.mean()),
+                   {{"time_dimension", "t"},
+                    {"long_name", "Time average of " + label},
+                    {"source", "running_statistics"}});
+    if (moments >= 2) {
+      set_with_attrs(state[label + "_var"], empty ? T(BoutNaN) : stats.variance(),
+                     {{"time_dimension", "t"},
+                      {"long_name", "Variance of " + label},
+                      {"source", "running_statistics"}});
+    }
+    if (moments >= 3) {
+      set_with_attrs(state[label + "_skew"], empty ? T(BoutNaN) : stats.skewness(),
+                     {{"time_dimension", "t"},
+                      {"long_name", "Skewness of " + label},
+                      {"source", "running_statistics"}});
+    }
+    if (moments >= 4) {
+      set_with_attrs(state[label + "_kurt"], empty ? T(BoutNaN) : stats.kurtosis(),
+                     {{"time_dimension", "t"},
+                      {"long_name", "Excess kurtosis of " + label},
+                      {"source", "running_statistics"}});
+    }
+  };
+
+  for (auto& var : variables) {
+    if (z_average or (z_index >= 0)) {
+      saveMoments(var.moments2d, var.label);
+    } else {
+      saveMoments(var.moments3d, var.label);
+    }
+    if (reset_on_output) {
+      var.moments2d.reset();
+      var.moments3d.reset();
+    }
+  }
+}
@@ -1,8 +1,12 @@
 #include "../include/sheath_boundary.hxx"
+#include "../include/boundary_slice.hxx"
 
 #include <bout/output_bout_types.hxx>
 
+#include <vector>
+
 #include "bout/constants.hxx"
+#include "bout/coordinates.hxx"
 #include "bout/mesh.hxx"
 using bout::globals::mesh;
 
@@ -21,12 +25,6 @@ BoutReal floor(BoutReal value, BoutReal min) {
   return value;
 }
 
-Ind3D indexAt(const Field3D& f, int x, int y, int z) {
-  int ny = f.getNy();
-  int nz = f.getNz();
-  return Ind3D{(x * ny + y) * nz + z, ny, nz};
-}
-
 /// Limited free gradient of log of a quantity
 /// This ensures that the guard cell values remain positive
 /// while also ensuring that the quantity never increases
@@ -53,6 +51,21 @@ BoutReal limitFree(BoutReal fm, BoutReal fc) {
   return fp;
 }
 
+/// Quantities for one ion species at the sheath boundaries
+struct SheathIon {
+  Options& species;
+  BoutReal Zi;        ///< Charge
+  BoutReal Mi;        ///< Mass, normalised to proton mass
+  BoutReal adiabatic; ///< Ratio of specific heats
+
+  /// Fields from the state, which boundary values are scattered into
+  Field3D N_field, T_field, P_field, V_field, NV_field, energy_source_field,
+      energy_flow_field;
+
+  /// Field-aligned values next to the boundaries
+  BoundarySlice N, T, P, V, NV, energy_source, energy_flow;
+};
+
 }
 
 SheathBoundary::SheathBoundary(std::string name, Options &alloptions, Solver *) {
@@ -104,6 +117,8 @@ SheathBoundary::SheathBoundary(std::string name, Options &alloptions, Solver *)
   floor_potential = options["floor_potential"]
                         .doc("Apply a floor to wall potential when calculating Ve?")
                         .withDefault<bool>(true);
+
+  wall = WallBoundary(mesh);
 }
 
 void SheathBoundary::transform(Options &state) {
@@ -113,12 +128,17 @@ void SheathBoundary::transform(Options &state) {
   Options& electrons = allspecies["e"];
 
   // Need electron properties
+  const Field3D Ne_field = floor(GET_NOBOUNDARY(Field3D, electrons["density"]), 0.0);
+  const Field3D Te_field = GET_NOBOUNDARY(Field3D, electrons["temperature"]);
+  const Field3D Pe_field = IS_SET_NOBOUNDARY(electrons["pressure"])
+    ? getNoBoundary<Field3D>(electrons["pressure"])
+    : Te_field * Ne_field;
+
+  // Field-aligned values next to the boundaries
   // Not const because boundary conditions will be set
-  Field3D Ne = toFieldAligned(floor(GET_NOBOUNDARY(Field3D, electrons["density"]), 0.0));
-  Field3D Te = toFieldAligned(GET_NOBOUNDARY(Field3D, electrons["temperature"]));
-  Field3D Pe = IS_SET_NOBOUNDARY(electrons["pressure"])
-    ? toFieldAligned(getNoBoundary<Field3D>(electrons["pressure"]))
-    : Te * Ne;
+  BoundarySlice Ne(Ne_field);
+  BoundarySlice Te(Te_field);
+  BoundarySlice Pe(Pe_field);
 
   // Ratio of specific heats
   const BoutReal electron_adiabatic =
@@ -129,541 +149,363 @@ void SheathBoundary::transform(Options &state) {
       IS_SET(electrons["AA"]) ? get<BoutReal>(electrons["AA"]) : SI::Me / SI::Mp;
 
   // This is for applying boundary conditions
-  Field3D Ve = IS_SET_NOBOUNDARY(electrons["velocity"])
-    ? toFieldAligned(getNoBoundary<Field3D>(electrons["velocity"]))
-    : zeroFrom(Ne);
-
-  Field3D NVe = IS_SET_NOBOUNDARY(electrons["momentum"])
-    ? toFieldAligned(getNoBoundary<Field3D>(electrons["momentum"]))
-    : zeroFrom(Ne);
+  const Field3D Ve_field = IS_SET_NOBOUNDARY(electrons["velocity"])
+    ? getNoBoundary<Field3D>(electrons["velocity"])
+    : zeroFrom(Ne_field);
+  BoundarySlice Ve(Ve_field);
+
+  const Field3D NVe_field = IS_SET_NOBOUNDARY(electrons["momentum"])
+    ? getNoBoundary<Field3D>(electrons["momentum"])
+    : zeroFrom(Ne_field);
+  BoundarySlice NVe(NVe_field);
+
+  const Field3D electron_energy_source_field = electrons.isSet("energy_source")
+    ? getNonFinal<Field3D>(electrons["energy_source"])
+    : zeroFrom(Ne_field);
+  BoundarySlice electron_energy_source(electron_energy_source_field);
+
+  // Heat flow through the sheath, at the Y cell faces
+  const Field3D electron_energy_flow_field = electrons.isSet("energy_flow_ylow")
+    ? getNonFinal<Field3D>(electrons["energy_flow_ylow"])
+    : zeroFrom(Ne_field);
+  BoundarySlice electron_energy_flow(electron_energy_flow_field);
 
-  Coordinates *coord = mesh->getCoordinates();
-
-  //////////////////////////////////////////////////////////////////
   // Electrostatic potential
   // If phi is set, use free boundary condition
   // If phi not set, calculate assuming zero current
-  Field3D phi;
-  if (IS_SET_NOBOUNDARY(state["fields"]["phi"])) {
-    phi = toFieldAligned(getNoBoundary<Field3D>(state["fields"]["phi"]));
-  } else {
-    // Calculate potential phi assuming zero current
-    // Note: This is equation (22) in Tskhakaya 2005, with I = 0
-
-    // Need to sum  s_i Z_i C_i over all ion species
-    //
-    // To avoid looking up species for every grid point, this
-    // loops over the boundaries once per species.
-    Field3D ion_sum {zeroFrom(Ne)};
-    phi = emptyFrom(Ne); // So phi is field aligned
-
-    // Iterate through charged ion species
-    for (auto& kv : allspecies.getChildren()) {
-      Options& species = allspecies[kv.first];
-
-      if ((kv.first == "e") or !IS_SET(species["charge"])
-          or (get<BoutReal>(species["charge"]) == 0.0)) {
-        continue; // Skip electrons and non-charged ions
-      }
-
-      const Field3D Ni = toFieldAligned(floor(GET_NOBOUNDARY(Field3D, species["density"]), 0.0));
-      const Field3D Ti = toFieldAligned(GET_NOBOUNDARY(Field3D, species["temperature"]));
-      const BoutReal Mi = GET_NOBOUNDARY(BoutReal, species["AA"]);
-      const BoutReal Zi = GET_NOBOUNDARY(BoutReal, species["charge"]);
-
-      const BoutReal adiabatic = IS_SET(species["adiabatic"])
-                                     ? get<BoutReal>(species["adiabatic"])
-                                     : 5. / 3; // Ratio of specific heats (ideal gas)
-
-      if (lower_y) {
-        // Sum values, put result in mesh->ystart
-
-        for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-          for (int jz = 0; jz < mesh->LocalNz; jz++) {
-            auto i = indexAt(Ni, r.ind, mesh->ystart, jz);
-            auto ip = i.yp();
-            
-            // Free boundary extrapolate ion concentration
-            BoutReal s_i = clip(0.5 * (3. * Ni[i] / Ne[i] - Ni[ip] / Ne[ip]),
-                                      0.0, 1.0); // Limit range to [0,1]
-
-            if (!std::isfinite(s_i)) {
-              s_i = 1.0;
-            }
-            BoutReal te = Te[i];
-            BoutReal ti = Ti[i];
-            
-            // Equation (9) in Tskhakaya 2005
-
-            BoutReal grad_ne = Ne[ip] - Ne[i];
-            BoutReal grad_ni = Ni[ip] - Ni[i];
-
-            // Note: Needed to get past initial conditions, perhaps transients
-            // but this shouldn't happen in steady state
-            if (fabs(grad_ni) < 1e-3) {
-                grad_ni = grad_ne = 1e-3;  // Remove kinetic correction term
-            }
-
-            BoutReal C_i_sq = clip(
-                (adiabatic * ti + Zi * s_i * te * grad_ne / grad_ni)
-                    / Mi,
-                0, 100); // Limit for e.g. Ni zero gradient
-
-            // Note: Vzi = C_i * sin(α)
-            ion_sum[i] += s_i * Zi * sin_alpha * sqrt(C_i_sq);
-          }
-        }
-      }
+  const bool phi_set = IS_SET_NOBOUNDARY(state["fields"]["phi"]);
+  // Note: If not set, phi in the domain is not calculated
+  const Field3D phi_field =
+      phi_set ? getNoBoundary<Field3D>(state["fields"]["phi"]) : zeroFrom(Ne_field);
+  BoundarySlice phi(phi_field);
 
-      if (upper_y) {
-        // Sum values, put results in mesh->yend
-        
-        for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-          for (int jz = 0; jz < mesh->LocalNz; jz++) {
-            auto i = indexAt(Ni, r.ind, mesh->yend, jz);
-            auto im = i.ym();
-
-            BoutReal s_i =
-                clip(0.5 * (3. * Ni[i] / Ne[i] - Ni[im] / Ne[im]), 0.0, 1.0);
-
-            if (!std::isfinite(s_i)) {
-              s_i = 1.0;
-            }
-
-            BoutReal te = Te[i];
-            BoutReal ti = Ti[i];
-            
-            // Equation (9) in Tskhakaya 2005
-            
-            BoutReal grad_ne = Ne[i] - Ne[im];
-            BoutReal grad_ni = Ni[i] - Ni[im];
+  //////////////////////////////////////////////////////////////////
+  // Gather the charged ion species, so that species are only looked
+  // up once, and all species are handled in a single pass over the
+  // boundary cells
 
-            if (fabs(grad_ni) < 1e-3) {
-                grad_ni = grad_ne = 1e-3; // Remove kinetic correction term
-            }
+  std::vector<SheathIon> ions;
+  for (auto& kv : allspecies.getChildren()) {
+    if (kv.first == "e") {
+      continue; // Skip electrons
+    }
 
-            BoutReal C_i_sq = clip(
-                (adiabatic * ti + Zi * s_i * te * grad_ne / grad_ni)
-                    / Mi,
-                0, 100); // Limit for e.g. Ni zero gradient
+    Options& species = allspecies[kv.first]; // Note: Need non-const
 
-            ion_sum(r.ind, mesh->yend, jz) += s_i * Zi * sqrt(C_i_sq);
+    // Ion charge
+    const BoutReal Zi =
+        IS_SET(species["charge"]) ? get<BoutReal>(species["charge"]) : 0.0;
 
-          }
-        }
-      }
+    if (Zi == 0.0) {
+      continue; // Neutral -> skip
     }
 
-    phi.allocate();
-
-    // ion_sum now contains  sum  s_i Z_i C_i over all ion species
-    // at mesh->ystart and mesh->yend indices
-    if (lower_y) {
-      for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(phi, r.ind, mesh->ystart, jz);
-
-          if (Te[i] <= 0.0) {
-            phi[i] = 0.0;
-          } else {
-            phi[i] = Te[i] * log(sqrt(Te[i] / (Me * TWOPI)) * (1. - Ge) / ion_sum[i]);
-          }
+    // Characteristics of this species
+    const BoutReal Mi = get<BoutReal>(species["AA"]);
 
-          const BoutReal phi_wall = wall_potential[i];
-          phi[i] += phi_wall; // Add bias potential
+    const BoutReal adiabatic = IS_SET(species["adiabatic"])
+                                   ? get<BoutReal>(species["adiabatic"])
+                                   : 5. / 3; // Ratio of specific heats (ideal gas)
 
-          phi[i.yp()] = phi[i.ym()] = phi[i]; // Constant into sheath
-        }
-      }
-    }
+    // Density and temperature boundary conditions will be imposed (free)
+    const Field3D Ni = floor(getNoBoundary<Field3D>(species["density"]), 0.0);
+    const Field3D Ti = getNoBoundary<Field3D>(species["temperature"]);
+    const Field3D Pi = species.isSet("pressure")
+      ? getNoBoundary<Field3D>(species["pressure"])
+      : Ni * Ti;
 
-    if (upper_y) {
-      for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(phi, r.ind, mesh->yend, jz);
+    // Get the velocity and momentum
+    // These will be modified at the boundaries
+    // and then put back into the state
+    const Field3D Vi = species.isSet("velocity")
+      ? getNoBoundary<Field3D>(species["velocity"])
+      : zeroFrom(Ni);
+    const Field3D NVi = species.isSet("momentum")
+      ? getNoBoundary<Field3D>(species["momentum"])
+      : Mi * Ni * Vi;
 
-          if (Te[i] <= 0.0) {
-            phi[i] = 0.0;
-          } else {
-            phi[i] = Te[i] * log(sqrt(Te[i] / (Me * TWOPI)) * (1. - Ge) / ion_sum[i]);
-          }
+    // Energy source will be modified in the domain
+    const Field3D energy_source = species.isSet("energy_source")
+      ? getNonFinal<Field3D>(species["energy_source"])
+      : zeroFrom(Ni);
 
-          const BoutReal phi_wall = wall_potential[i];
-          phi[i] += phi_wall; // Add bias potential
+    const Field3D energy_flow = species.isSet("energy_flow_ylow")
+      ? getNonFinal<Field3D>(species["energy_flow_ylow"])
+      : zeroFrom(Ni);
 
-          phi[i.yp()] = phi[i.ym()] = phi[i];
-        }
-      }
-    }
+    ions.push_back({species, Zi, Mi, adiabatic,
+                    Ni, Ti, Pi, Vi, NVi, energy_source, energy_flow,
+                    BoundarySlice(Ni), BoundarySlice(Ti), BoundarySlice(Pi),
+                    BoundarySlice(Vi), BoundarySlice(NVi),
+                    BoundarySlice(energy_source), BoundarySlice(energy_flow)});
   }
 
   //////////////////////////////////////////////////////////////////
-  // Electrons
+  // Iterate over the boundary cells once, calculating the potential
+  // and the boundary conditions for all species in each cell
 
-  Field3D electron_energy_source = electrons.isSet("energy_source")
-    ? toFieldAligned(getNonFinal<Field3D>(electrons["energy_source"]))
-    : zeroFrom(Ne);
+  Coordinates* coord = mesh->getCoordinates();
 
+  std::vector<const std::vector<WallCell>*> targets;
   if (lower_y) {
-    for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-      for (int jz = 0; jz < mesh->LocalNz; jz++) {
-        auto i = indexAt(Ne, r.ind, mesh->ystart, jz);
-        auto ip = i.yp();
-        auto im = i.ym();
-
-        // Free gradient of log electron density and temperature
-        // Limited so that the values don't increase into the sheath
-        // This ensures that the guard cell values remain positive
-        // exp( 2*log(N[i]) - log(N[ip]) )
-
-        Ne[im] = limitFree(Ne[ip], Ne[i]);
-        Te[im] = limitFree(Te[ip], Te[i]);
-        Pe[im] = limitFree(Pe[ip], Pe[i]);
-
-        // Free boundary potential linearly extrapolated
-        phi[im] = 2 * phi[i] - phi[ip];
-
-        const BoutReal nesheath = 0.5 * (Ne[im] + Ne[i]);
-        const BoutReal tesheath = 0.5 * (Te[im] + Te[i]);  // electron temperature
-        const BoutReal phi_wall = wall_potential[i];
-
-        const BoutReal phisheath = floor_potential ? floor(
-            0.5 * (phi[im] + phi[i]), phi_wall) // Electron saturation at phi = phi_wall
-	    : 0.5 * (phi[im] + phi[i]);
-
-        // Electron sheath heat transmission
-        const BoutReal gamma_e = floor(2 / (1. - Ge) + (phisheath - phi_wall) / floor(tesheath, 1e-5), 0.0);
-
-        // Electron velocity into sheath (< 0)
-        const BoutReal vesheath = (tesheath < 1e-10) ?
-          0.0 :
-          -sqrt(tesheath / (TWOPI * Me)) * (1. - Ge) * exp(-(phisheath - phi_wall) / tesheath);
+    targets.push_back(&wall.lower_target);
+  }
+  if (upper_y) {
+    targets.push_back(&wall.upper_target);
+  }
 
-        Ve[im] = 2 * vesheath - Ve[i];
-        NVe[im] = 2. * Me * nesheath * vesheath - NVe[i];
+  for (const auto* target : targets) {
+    for (const auto& cell : *target) {
+      // Direction into the sheath: -1 lower, +1 upper
+      const int sign = cell.direction;
 
-        // Take into account the flow of energy due to fluid flow
-        // This is additional energy flux through the sheath
-        // Note: Here this is negative because vesheath < 0
-        BoutReal q = ((gamma_e - 1 - 1 / (electron_adiabatic - 1)) * tesheath
-                      - 0.5 * Me * SQ(vesheath))
-                     * nesheath * vesheath;
+      // Positions in the boundary slices. These are the same for all slices
+      const int i = Ne.position(cell.i);
+      const int ig = Ne.position(cell.guard);
+      const int ic = Ne.position(cell.inner);
 
-        // Multiply by cell area to get power
-        BoutReal flux = q * (coord->J[i] + coord->J[im])
-                        / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[im]));
+      // The Y cell face on the boundary, at which flows are stored
+      const int face = (sign > 0) ? ig : i;
 
-        // Divide by volume of cell to get energy loss rate (< 0)
-        BoutReal power = flux / (coord->dy[i] * coord->J[i]);
+      const BoutReal phi_wall = wall_potential[cell.i];
 
-#if CHECKLEVEL >= 1
-        if (!std::isfinite(power)) {
-	  throw BoutException("Non-finite power at {} : Te {} Ne {} Ve {} phi {}, {}", i, tesheath, nesheath, vesheath, phi[i], phi[ip]);
-	}
-#endif
+      // Multiply by cell area and divide by volume of cell
+      // to convert a flux to a rate of change
+      const BoutReal area_over_volume = cell.area * cell.inv_volume;
 
-        electron_energy_source[i] += power;
-      }
-    }
-  }
-  if (upper_y) {
-    // This is essentially the same as at the lower y boundary
-    // except ystart -> yend, ip <-> im
-    // 
-    for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-      for (int jz = 0; jz < mesh->LocalNz; jz++) {
-        auto i = indexAt(Ne, r.ind, mesh->yend, jz);
-        auto ip = i.yp();
-        auto im = i.ym();
-
-        // Free gradient of log electron density and temperature
-        // This ensures that the guard cell values remain positive
-        // exp( 2*log(N[i]) - log(N[ip]) )
+      // Multiply by the face area to convert a flux to a flow
+      const BoutReal face_area = cell.area * coord->dx[cell.i] * coord->dz[cell.i];
 
-        Ne[ip] = limitFree(Ne[im], Ne[i]);
-        Te[ip] = limitFree(Te[im], Te[i]);
-        Pe[ip] = limitFree(Pe[im], Pe[i]);
+      if (!phi_set) {
+        // Calculate potential phi assuming zero current
+        // Note: This is equation (22) in Tskhakaya 2005, with I = 0
 
-        // Free boundary potential linearly extrapolated
-        phi[ip] = 2 * phi[i] - phi[im];
+        // Sum  s_i Z_i C_i over all ion species
+        BoutReal ion_sum = 0.0;
+        for (const auto& ion : ions) {
+          const BoundarySlice& Ni = ion.N;
 
-        const BoutReal nesheath = 0.5 * (Ne[ip] + Ne[i]);
-        const BoutReal tesheath = 0.5 * (Te[ip] + Te[i]);  // electron temperature
-        const BoutReal phi_wall = wall_potential[i];
-        const BoutReal phisheath = floor_potential ? floor(0.5 * (phi[ip] + phi[i]), phi_wall) // Electron saturation at phi = phi_wall
-                                                   : 0.5 * (phi[ip] + phi[i]);
+          // Free boundary extrapolate ion concentration
+          BoutReal s_i = clip(0.5 * (3. * Ni[i] / Ne[i] - Ni[ic] / Ne[ic]),
+                              0.0, 1.0); // Limit range to [0,1]
 
-        // Electron sheath heat transmission
-        const BoutReal gamma_e = floor(2 / (1. - Ge) + (phisheath - phi_wall) / floor(tesheath, 1e-5), 0.0);
+          if (!std::isfinite(s_i)) {
+            s_i = 1.0;
+          }
 
-        // Electron velocity into sheath (> 0)
-        const BoutReal vesheath = (tesheath < 1e-10) ?
-          0.0 :
-          sqrt(tesheath / (TWOPI * Me)) * (1. - Ge) * exp(-(phisheath - phi_wall) / tesheath);
+          // Equation (9) in Tskhakaya 2005
+          BoutReal grad_ne = Ne[ic] - Ne[i];
+          BoutReal grad_ni = Ni[ic] - Ni[i];
 
-        Ve[ip] = 2 * vesheath - Ve[i];
-        NVe[ip] = 2. * Me * nesheath * vesheath - NVe[i];
+          // Note: Needed to get past initial conditions, perhaps transients
+          // but this shouldn't happen in steady state
+          if (fabs(grad_ni) < 1e-3) {
+            grad_ni = grad_ne = 1e-3; // Remove kinetic correction term
+          }
 
-        // Take into account the flow of energy due to fluid flow
-        // This is additional energy flux through the sheath
-        // Note: Here this is positive because vesheath > 0
-        BoutReal q = ((gamma_e - 1 - 1 / (electron_adiabatic - 1)) * tesheath
-                      - 0.5 * Me * SQ(vesheath))
-                     * nesheath * vesheath;
+          const BoutReal C_i_sq =
+              clip((ion.adiabatic * ion.T[i] + ion.Zi * s_i * Te[i] * grad_ne / grad_ni)
+                       / ion.Mi,
+                   0, 100); // Limit for e.g. Ni zero gradient
 
-        // Multiply by cell area to get power
-        BoutReal flux = q * (coord->J[i] + coord->J[ip])
-                        / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[ip]));
+          // Note: Vzi = C_i * sin(α)
+          ion_sum += s_i * ion.Zi * sin_alpha * sqrt(C_i_sq);
+        }
 
-        // Divide by volume of cell to get energy loss rate (> 0)
-        BoutReal power = flux / (coord->dy[i] * coord->J[i]);
-#if CHECKLEVEL >= 1
-	if (!std::isfinite(power)) {
-	  throw BoutException("Non-finite power {} at {} : Te {} Ne {} Ve {} phi {}, {} => q {}, flux {}",
-                              power, i, tesheath, nesheath, vesheath, phi[i], phi[im], q, flux);
+        if (Te[i] <= 0.0) {
+          phi[i] = 0.0;
+        } else {
+          phi[i] = Te[i] * log(sqrt(Te[i] / (Me * TWOPI)) * (1. - Ge) / ion_sum);
         }
-#endif
-        electron_energy_source[i] -= power;
+        phi[i] += phi_wall; // Add bias potential
+
+        phi[ic] = phi[ig] = phi[i]; // Constant into sheath
       }
-    }
-  }
 
-  // Set electron density and temperature, now with boundary conditions
-  setBoundary(electrons["density"], fromFieldAligned(Ne));
-  setBoundary(electrons["temperature"], fromFieldAligned(Te));
-  setBoundary(electrons["pressure"], fromFieldAligned(Pe));
+      //////////////////////////////////////////////////////////////////
+      // Electrons
 
-  // Add energy source (negative in cell next to sheath)
-  // Note: already includes previously set sources
-  set(electrons["energy_source"], fromFieldAligned(electron_energy_source));
+      // Free gradient of log electron density and temperature
+      // Limited so that the values don't increase into the sheath
+      // This ensures that the guard cell values remain positive
+      // exp( 2*log(N[i]) - log(N[ic]) )
 
-  if (IS_SET_NOBOUNDARY(electrons["velocity"])) {
-    setBoundary(electrons["velocity"], fromFieldAligned(Ve));
-  }
-  if (IS_SET_NOBOUNDARY(electrons["momentum"])) {
-    setBoundary(electrons["momentum"], fromFieldAligned(NVe));
-  }
+      Ne[ig] = limitFree(Ne[ic], Ne[i]);
+      Te[ig] = limitFree(Te[ic], Te[i]);
+      Pe[ig] = limitFree(Pe[ic], Pe[i]);
 
-  if (always_set_phi or IS_SET_NOBOUNDARY(state["fields"]["phi"])) {
-    // Set the potential, including boundary conditions
-    phi = fromFieldAligned(phi);
-    //output.write("-> phi {}\n", phi(10, mesh->yend+1, 0));
-    setBoundary(state["fields"]["phi"], phi);
-  }
+      // Free boundary potential linearly extrapolated
+      phi[ig] = 2 * phi[i] - phi[ic];
 
-  //////////////////////////////////////////////////////////////////
-  // Iterate through all ions
-  for (auto& kv : allspecies.getChildren()) {
-    if (kv.first == "e") {
-      continue; // Skip electrons
-    }
+      const BoutReal nesheath = 0.5 * (Ne[ig] + Ne[i]);
+      const BoutReal tesheath = 0.5 * (Te[ig] + Te[i]);  // electron temperature
 
-    Options& species = allspecies[kv.first]; // Note: Need non-const
+      const BoutReal phisheath = floor_potential ? floor(
+          0.5 * (phi[ig] + phi[i]), phi_wall) // Electron saturation at phi = phi_wall
+          : 0.5 * (phi[ig] + phi[i]);
 
-    // Ion charge
-    const BoutReal Zi =
-        IS_SET(species["charge"]) ? get<BoutReal>(species["charge"]) : 0.0;
+      // Electron sheath heat transmission
+      const BoutReal gamma_e = floor(2 / (1. - Ge) + (phisheath - phi_wall) / floor(tesheath, 1e-5), 0.0);
 
-    if (Zi == 0.0) {
-      continue; // Neutral -> skip
-    }
+      // Electron velocity into sheath (sign of sign)
+      const BoutReal vesheath = (tesheath < 1e-10) ?
+        0.0 :
+        sign * sqrt(tesheath / (TWOPI * Me)) * (1. - Ge) * exp(-(phisheath - phi_wall) / tesheath);
 
-    // Characteristics of this species
-    const BoutReal Mi = get<BoutReal>(species["AA"]);
+      Ve[ig] = 2 * vesheath - Ve[i];
+      NVe[ig] = 2. * Me * nesheath * vesheath - NVe[i];
 
-    const BoutReal adiabatic = IS_SET(species["adiabatic"])
-                                   ? get<BoutReal>(species["adiabatic"])
-                                   : 5. / 3; // Ratio of specific heats (ideal gas)
+      // Take into account the flow of energy due to fluid flow
+      // This is additional energy flux through the sheath
+      // Note: Same sign as vesheath
+      const BoutReal q = ((gamma_e - 1 - 1 / (electron_adiabatic - 1)) * tesheath
+                          - 0.5 * Me * SQ(vesheath))
+                         * nesheath * vesheath;
 
-    // Density and temperature boundary conditions will be imposed (free)
-    Field3D Ni = toFieldAligned(floor(getNoBoundary<Field3D>(species["density"]), 0.0));
-    Field3D Ti = toFieldAligned(getNoBoundary<Field3D>(species["temperature"]));
-    Field3D Pi = species.isSet("pressure")
-      ? toFieldAligned(getNoBoundary<Field3D>(species["pressure"]))
-      : Ni * Ti;
+      // Energy loss rate from the cell (sign of sign)
+      const BoutReal power = q * area_over_volume;
 
-    // Get the velocity and momentum
-    // These will be modified at the boundaries
-    // and then put back into the state
-    Field3D Vi = species.isSet("velocity")
-      ? toFieldAligned(getNoBoundary<Field3D>(species["velocity"]))
-      : zeroFrom(Ni);
-    Field3D NVi = species.isSet("momentum")
-      ? toFieldAligned(getNoBoundary<Field3D>(species["momentum"]))
-      : Mi * Ni * Vi;
+#if CHECKLEVEL >= 1
+      if (!std::isfinite(power)) {
+        throw BoutException("Non-finite power {} at {} : Te {} Ne {} Ve {} phi {}, {}",
+                            power, cell.i, tesheath, nesheath, vesheath, phi[i], phi[ic]);
+      }
+#endif
 
-    // Energy source will be modified in the domain
-    Field3D energy_source = species.isSet("energy_source")
-      ? toFieldAligned(getNonFinal<Field3D>(species["energy_source"]))
-      : zeroFrom(Ni);
+      electron_energy_source[i] -= sign * power;
 
-    if (lower_y) {
-      for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(Ne, r.ind, mesh->ystart, jz);
-          auto ip = i.yp();
-          auto im = i.ym();
-
-          // Free gradient of log electron density and temperature
-          // This ensures that the guard cell values remain positive
-          // exp( 2*log(N[i]) - log(N[ip]) )
-
-          Ni[im] = limitFree(Ni[ip], Ni[i]);
-          Ti[im] = limitFree(Ti[ip], Ti[i]);
-          Pi[im] = limitFree(Pi[ip], Pi[i]);
-
-          // Calculate sheath values at half-way points (cell edge)
-          const BoutReal nesheath = 0.5 * (Ne[im] + Ne[i]);
-          const BoutReal nisheath = 0.5 * (Ni[im] + Ni[i]);
-          const BoutReal tesheath = floor(0.5 * (Te[im] + Te[i]), 1e-5);  // electron temperature
-          const BoutReal tisheath = floor(0.5 * (Ti[im] + Ti[i]), 1e-5);  // ion temperature
-
-          // Ion sheath heat transmission coefficient
-          // Equation (22) in Tskhakaya 2005
-          // with 
-          //
-          // 1 / (1 + ∂_{ln n_e} ln s_i = s_i ∂_z n_e / ∂_z n_i
-          // (from comparing C_i^2 in eq. 9 with eq. 20
-          //
-          // 
-          BoutReal s_i = clip(nisheath / floor(nesheath, 1e-10), 0, 1); // Concentration
-          BoutReal grad_ne = Ne[i] - nesheath;
-          BoutReal grad_ni = Ni[i] - nisheath;
+      // Total heat flow into the sheath (sign of sign)
+      electron_energy_flow[face] += gamma_e * tesheath * nesheath * vesheath * face_area;
 
-          if (fabs(grad_ni) < 1e-3) {
-            grad_ni = grad_ne = 1e-3; // Remove kinetic correction term
-          }
+      //////////////////////////////////////////////////////////////////
+      // Ions
 
-          // Ion speed into sheath
-          // Equation (9) in Tskhakaya 2005
-          //
-          BoutReal C_i_sq =
-              clip((adiabatic * tisheath + Zi * s_i * tesheath * grad_ne / grad_ni) / Mi,
-                   0, 100); // Limit for e.g. Ni zero gradient
+      // Electron temperature at the sheath entrance, for ion sound speed
+      const BoutReal tesheath_floor = floor(tesheath, 1e-5);
 
-          // Ion sheath heat transmission coefficient
-          const BoutReal gamma_i = 2.5 + 0.5 * Mi * C_i_sq / tisheath;
+      for (auto& ion : ions) {
+        BoundarySlice& Ni = ion.N;
+        BoundarySlice& Ti = ion.T;
+        BoundarySlice& Pi = ion.P;
 
-          const BoutReal visheath = - sqrt(C_i_sq); // Negative -> into sheath
+        // Free gradient of log ion density and temperature
+        // This ensures that the guard cell values remain positive
+        // exp( 2*log(N[i]) - log(N[ic]) )
+
+        Ni[ig] = limitFree(Ni[ic], Ni[i]);
+        Ti[ig] = limitFree(Ti[ic], Ti[i]);
+        Pi[ig] = limitFree(Pi[ic], Pi[i]);
+
+        // Calculate sheath values at half-way points (cell edge)
+        const BoutReal nisheath = 0.5 * (Ni[ig] + Ni[i]);
+        const BoutReal tisheath = floor(0.5 * (Ti[ig] + Ti[i]), 1e-5);  // ion temperature
+
+        // Ion sheath heat transmission coefficient
+        // Equation (22) in Tskhakaya 2005
+        // with
+        //
+        // 1 / (1 + ∂_{ln n_e} ln s_i = s_i ∂_z n_e / ∂_z n_i
+        // (from comparing C_i^2 in eq. 9 with eq. 20
+        //
+        //
+        const BoutReal s_i = clip(nisheath / floor(nesheath, 1e-10), 0, 1); // Concentration
+        BoutReal grad_ne = Ne[i] - nesheath;
+        BoutReal grad_ni = Ni[i] - nisheath;
+
+        if (fabs(grad_ni) < 1e-3) {
+          grad_ni = grad_ne = 1e-3; // Remove kinetic correction term
+        }
 
-          // Set boundary conditions on flows
-          Vi[im] = 2. * visheath - Vi[i];
-          NVi[im] = 2. * Mi * nisheath * visheath - NVi[i];
+        // Ion speed into sheath
+        // Equation (9) in Tskhakaya 2005
+        //
+        const BoutReal C_i_sq =
+            clip((ion.adiabatic * tisheath
+                  + ion.Zi * s_i * tesheath_floor * grad_ne / grad_ni)
+                     / ion.Mi,
+                 0, 100); // Limit for e.g. Ni zero gradient
 
-          // Take into account the flow of energy due to fluid flow
-          // This is additional energy flux through the sheath
-          // Note: Here this is negative because visheath < 0
-          BoutReal q =
-              ((gamma_i - 1 - 1 / (adiabatic - 1)) * tisheath - 0.5 * Mi * C_i_sq)
-              * nisheath * visheath;
-          if (q > 0.0) {
-            q = 0.0;
-          }
+        // Ion sheath heat transmission coefficient
+        const BoutReal gamma_i = 2.5 + 0.5 * ion.Mi * C_i_sq / tisheath;
 
-          // Multiply by cell area to get power
-          BoutReal flux = q * (coord->J[i] + coord->J[im])
-                          / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[im]));
+        const BoutReal visheath = sign * sqrt(C_i_sq); // Into sheath
 
-          // Divide by volume of cell to get energy loss rate (< 0)
-          BoutReal power = flux / (coord->dy[i] * coord->J[i]);
-	  ASSERT1(std::isfinite(power));
-          ASSERT2(power <= 0.0);
+        // Set boundary conditions on flows
+        ion.V[ig] = 2. * visheath - ion.V[i];
+        ion.NV[ig] = 2. * ion.Mi * nisheath * visheath - ion.NV[i];
 
-          energy_source[i] += power;
+        // Take into account the flow of energy due to fluid flow
+        // This is additional energy flux through the sheath
+        // Note: Same sign as visheath
+        BoutReal q =
+            ((gamma_i - 1 - 1 / (ion.adiabatic - 1)) * tisheath - 0.5 * ion.Mi * C_i_sq)
+            * nisheath * visheath;
+        if (sign * q < 0.0) {
+          q = 0.0; // No energy flux out of the sheath
         }
-      }
-    }
-    if (upper_y) {
-      // Note: This is essentially the same as the lower boundary,
-      // but with directions reversed e.g. ystart -> yend, ip <-> im
-      // 
-      for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(Ne, r.ind, mesh->yend, jz);
-          auto ip = i.yp();
-          auto im = i.ym();
-
-          // Free gradient of log electron density and temperature
-          // This ensures that the guard cell values remain positive
-          // exp( 2*log(N[i]) - log(N[ip]) )
-
-          Ni[ip] = limitFree(Ni[im], Ni[i]);
-          Ti[ip] = limitFree(Ti[im], Ti[i]);
-          Pi[ip] = limitFree(Pi[im], Pi[i]);
-
-          // Calculate sheath values at half-way points (cell edge)
-          const BoutReal nesheath = 0.5 * (Ne[ip] + Ne[i]);
-          const BoutReal nisheath = 0.5 * (Ni[ip] + Ni[i]);
-          const BoutReal tesheath = floor(0.5 * (Te[ip] + Te[i]), 1e-5);  // electron temperature
-          const BoutReal tisheath = floor(0.5 * (Ti[ip] + Ti[i]), 1e-5);  // ion temperature
-
-          // Ion sheath heat transmission coefficient
-          //
-          // 1 / (1 + ∂_{ln n_e} ln s_i = s_i * ∂n_e / (s_i * ∂n_e + ∂ n_i) 
-          BoutReal s_i = (nesheath > 1e-5) ? nisheath / nesheath : 0.0; // Concentration
-          BoutReal grad_ne = Ne[i] - nesheath;
-          BoutReal grad_ni = Ni[i] - nisheath;
 
-          if (fabs(grad_ni) < 1e-3) {
-            grad_ni = grad_ne = 1e-3; // Remove kinetic correction term
-          }
+        // Energy loss rate from the cell (sign of sign)
+        const BoutReal ion_power = q * area_over_volume;
+        ASSERT1(std::isfinite(ion_power));
+        ASSERT2(sign * ion_power >= 0.0);
 
-          // Ion speed into sheath
-          // Equation (9) in Tskhakaya 2005
-          //
-          BoutReal C_i_sq =
-              clip((adiabatic * tisheath + Zi * s_i * tesheath * grad_ne / grad_ni) / Mi,
-                   0, 100); // Limit for e.g. Ni zero gradient
+        ion.energy_source[i] -= sign * ion_power;
 
-          const BoutReal gamma_i = 2.5 + 0.5 * Mi * C_i_sq / tisheath; // + Δγ 
+        // Total heat flow into the sheath (sign of sign)
+        ion.energy_flow[face] += gamma_i * tisheath * nisheath * visheath * face_area;
+      }
+    }
+  }
 
-          const BoutReal visheath = sqrt(C_i_sq); // Positive -> into sheath
+  //////////////////////////////////////////////////////////////////
+  // Put the modified fields back into the state
 
-          // Set boundary conditions on flows
-          Vi[ip] = 2. * visheath - Vi[i];
-          NVi[ip] = 2. * Mi * nisheath * visheath - NVi[i];
+  // Set electron density and temperature, now with boundary conditions
+  setBoundary(electrons["density"], Ne.scatter(Ne_field));
+  setBoundary(electrons["temperature"], Te.scatter(Te_field));
+  setBoundary(electrons["pressure"], Pe.scatter(Pe_field));
 
-          // Take into account the flow of energy due to fluid flow
-          // This is additional energy flux through the sheath
-          // Note: Here this is positive because visheath > 0
-          BoutReal q =
-              ((gamma_i - 1 - 1 / (adiabatic - 1)) * tisheath - 0.5 * C_i_sq * Mi)
-              * nisheath * visheath;
+  // Add energy source (negative in cell next to sheath)
+  // Note: already includes previously set sources
+  set(electrons["energy_source"],
+      electron_energy_source.scatter(electron_energy_source_field));
 
-          if (q < 0.0) {
-            q = 0.0;
-          }
+  // Heat flow through the sheath, including previously set flows
+  set(electrons["energy_flow_ylow"],
+      electron_energy_flow.scatter(electron_energy_flow_field));
 
-          // Multiply by cell area to get power
-          BoutReal flux = q * (coord->J[i] + coord->J[ip])
-                          / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[ip]));
+  if (IS_SET_NOBOUNDARY(electrons["velocity"])) {
+    setBoundary(electrons["velocity"], Ve.scatter(Ve_field));
+  }
+  if (IS_SET_NOBOUNDARY(electrons["momentum"])) {
+    setBoundary(electrons["momentum"], NVe.scatter(NVe_field));
+  }
 
-          // Divide by volume of cell to get energy loss rate (> 0)
-          BoutReal power = flux / (coord->dy[i] * coord->J[i]);
-          ASSERT1(std::isfinite(power));
-          ASSERT2(power >= 0.0);
+  if (always_set_phi or phi_set) {
+    // Set the potential, including boundary conditions
+    setBoundary(state["fields"]["phi"], phi.scatter(phi_field));
+  }
 
-          energy_source[i] -= power; // Note: Sign negative because power > 0
-        }
-      }
-    }
+  for (auto& ion : ions) {
+    Options& species = ion.species;
 
-    // Finished boundary conditions for this species
-    // Put the modified fields back into the state.
-    setBoundary(species["density"], fromFieldAligned(Ni));
-    setBoundary(species["temperature"], fromFieldAligned(Ti));
-    setBoundary(species["pressure"], fromFieldAligned(Pi));
+    setBoundary(species["density"], ion.N.scatter(ion.N_field));
+    setBoundary(species["temperature"], ion.T.scatter(ion.T_field));
+    setBoundary(species["pressure"], ion.P.scatter(ion.P_field));
 
     if (species.isSet("velocity")) {
-      setBoundary(species["velocity"], fromFieldAligned(Vi));
+      setBoundary(species["velocity"], ion.V.scatter(ion.V_field));
     }
 
     if (species.isSet("momentum")) {
-      setBoundary(species["momentum"], fromFieldAligned(NVi));
+      setBoundary(species["momentum"], ion.NV.scatter(ion.NV_field));
     }
 
     // Additional loss of energy through sheath
     // Note: Already includes previously set sources
-    set(species["energy_source"], fromFieldAligned(energy_source));
+    set(species["energy_source"], ion.energy_source.scatter(ion.energy_source_field));
+
+    // Heat flow through the sheath, including previously set flows
+    set(species["energy_flow_ylow"], ion.energy_flow.scatter(ion.energy_flow_field));
   }
 }
@@ -2,10 +2,12 @@
 /// to the wall. Potential (if set) is linearly extrapolated into the boundary.
 
 #include "../include/sheath_boundary_insulating.hxx"
+#include "../include/boundary_slice.hxx"
 
 #include <bout/output_bout_types.hxx>
 
 #include "bout/constants.hxx"
+#include "bout/coordinates.hxx"
 #include "bout/mesh.hxx"
 using bout::globals::mesh;
 
@@ -24,12 +26,6 @@ BoutReal floor(BoutReal value, BoutReal min) {
   return value;
 }
 
-Ind3D indexAt(const Field3D& f, int x, int y, int z) {
-  int ny = f.getNy();
-  int nz = f.getNz();
-  return Ind3D{(x * ny + y) * nz + z, ny, nz};
-}
-
 /// Limited free gradient of log of a quantity
 /// This ensures that the guard cell values remain positive
 /// while also ensuring that the quantity never increases
@@ -86,6 +82,8 @@ SheathBoundaryInsulating::SheathBoundaryInsulating(std::string name, Options &al
   gamma_e = options["gamma_e"]
     .doc("Electron sheath heat transmission coefficient")
     .withDefault(3.5);
+
+  wall = WallBoundary(mesh);
 }
 
 void SheathBoundaryInsulating::transform(Options &state) {
@@ -95,12 +93,17 @@ void SheathBoundaryInsulating::transform(Options &state) {
   Options& electrons = allspecies["e"];
 
   // Need electron properties
+  const Field3D Ne_field = floor(GET_NOBOUNDARY(Field3D, electrons["density"]), 0.0);
+  const Field3D Te_field = GET_NOBOUNDARY(Field3D, electrons["temperature"]);
+  const Field3D Pe_field = IS_SET_NOBOUNDARY(electrons["pressure"])
+    ? getNoBoundary<Field3D>(electrons["pressure"])
+    : Te_field * Ne_field;
+
+  // Field-aligned values next to the boundaries
   // Not const because boundary conditions will be set
-  Field3D Ne = toFieldAligned(floor(GET_NOBOUNDARY(Field3D, electrons["density"]), 0.0));
-  Field3D Te = toFieldAligned(GET_NOBOUNDARY(Field3D, electrons["temperature"]));
-  Field3D Pe = IS_SET_NOBOUNDARY(electrons["pressure"])
-    ? toFieldAligned(getNoBoundary<Field3D>(electrons["pressure"]))
-    : Te * Ne;
+  BoundarySlice Ne(Ne_field);
+  BoundarySlice Te(Te_field);
+  BoundarySlice Pe(Pe_field);
 
   // Ratio of specific heats
   const BoutReal electron_adiabatic =
@@ -111,102 +114,95 @@ void SheathBoundaryInsulating::transform(Options &state) {
       IS_SET(electrons["AA"]) ? get<BoutReal>(electrons["AA"]) : SI::Me / SI::Mp;
 
   // This is for applying boundary conditions
-  Field3D Ve = IS_SET_NOBOUNDARY(electrons["velocity"])
-    ? toFieldAligned(getNoBoundary<Field3D>(electrons["velocity"]))
-    : zeroFrom(Ne);
-
-  Field3D NVe = IS_SET_NOBOUNDARY(electrons["momentum"])
-    ? toFieldAligned(getNoBoundary<Field3D>(electrons["momentum"]))
-    : zeroFrom(Ne);
+  const Field3D Ve_field = IS_SET_NOBOUNDARY(electrons["velocity"])
+    ? getNoBoundary<Field3D>(electrons["velocity"])
+    : zeroFrom(Ne_field);
+  BoundarySlice Ve(Ve_field);
 
-  Coordinates *coord = mesh->getCoordinates();
+  const Field3D NVe_field = IS_SET_NOBOUNDARY(electrons["momentum"])
+    ? getNoBoundary<Field3D>(electrons["momentum"])
+    : zeroFrom(Ne_field);
+  BoundarySlice NVe(NVe_field);
 
   //////////////////////////////////////////////////////////////////
   // Electrostatic potential
   // If phi is set, set free boundary condition
 
-  Field3D phi;
   if (IS_SET_NOBOUNDARY(state["fields"]["phi"])) {
-    phi = toFieldAligned(getNoBoundary<Field3D>(state["fields"]["phi"]));
+    const Field3D phi_field = getNoBoundary<Field3D>(state["fields"]["phi"]);
+    BoundarySlice phi(phi_field);
 
     // Free boundary potential linearly extrapolated
     if (lower_y) {
-      for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(Ne, r.ind, mesh->ystart, jz);
-          phi[i.ym()] = 2 * phi[i] - phi[i.yp()];
-        }
+      for (const auto& cell : wall.lower_target) {
+        auto i = cell.i;
+        phi[i.ym()] = 2 * phi[i] - phi[i.yp()];
       }
     }
     if (upper_y) {
-      for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(Ne, r.ind, mesh->yend, jz);
-          phi[i.yp()] = 2 * phi[i] - phi[i.ym()];
-        }
+      for (const auto& cell : wall.upper_target) {
+        auto i = cell.i;
+        phi[i.yp()] = 2 * phi[i] - phi[i.ym()];
       }
     }
     // Set the potential, including boundary conditions
-    phi = fromFieldAligned(phi);
-    setBoundary(state["fields"]["phi"], phi);
+    setBoundary(state["fields"]["phi"], phi.scatter(phi_field));
   }
 
   //////////////////////////////////////////////////////////////////
   // Electrons
 
   if (lower_y) {
-    for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-      for (int jz = 0; jz < mesh->LocalNz; jz++) {
-        auto i = indexAt(Ne, r.ind, mesh->ystart, jz);
-        auto ip = i.yp();
-        auto im = i.ym();
+    for (const auto& cell : wall.lower_target) {
+      auto i = cell.i;
+      auto ip = i.yp();
+      auto im = i.ym();
 
-        // Free gradient of log electron density and temperature
-        // Limited so that the values don't increase into the sheath
-        // This ensures that the guard cell values remain positive
-        // exp( 2*log(N[i]) - log(N[ip]) )
+      // Free gradient of log electron density and temperature
+      // Limited so that the values don't increase into the sheath
+      // This ensures that the guard cell values remain positive
+      // exp( 2*log(N[i]) - log(N[ip]) )
 
-        Ne[im] = limitFree(Ne[ip], Ne[i]);
-        Te[im] = limitFree(Te[ip], Te[i]);
-        Pe[im] = limitFree(Pe[ip], Pe[i]);
+      Ne[im] = limitFree(Ne[ip], Ne[i]);
+      Te[im] = limitFree(Te[ip], Te[i]);
+      Pe[im] = limitFree(Pe[ip], Pe[i]);
 
-        // Set zero flow through boundary
-        // This will be modified when iterating over the ions
+      // Set zero flow through boundary
+      // This will be modified when iterating over the ions
 
-        Ve[im] =  - Ve[i];
-        NVe[im] = - NVe[i];
-      }
+      Ve[im] =  - Ve[i];
+      NVe[im] = - NVe[i];
     }
   }
   if (upper_y) {
     // This is essentially the same as at the lower y boundary
     // except ystart -> yend, ip <-> im
     // 
-    for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-      for (int jz = 0; jz < mesh->LocalNz; jz++) {
-        auto i = indexAt(Ne, r.ind, mesh->yend, jz);
-        auto ip = i.yp();
-        auto im = i.ym();
+    for (const auto& cell : wall.upper_target) {
+      auto i = cell.i;
+      auto ip = i.yp();
+      auto im = i.ym();
 
-        Ne[ip] = limitFree(Ne[im], Ne[i]);
-        Te[ip] = limitFree(Te[im], Te[i]);
-        Pe[ip] = limitFree(Pe[im], Pe[i]);
+      Ne[ip] = limitFree(Ne[im], Ne[i]);
+      Te[ip] = limitFree(Te[im], Te[i]);
+      Pe[ip] = limitFree(Pe[im], Pe[i]);
 
-        Ve[ip] = - Ve[i];
-        NVe[ip] = - NVe[i];
-      }
+      Ve[ip] = - Ve[i];
+      NVe[ip] = - NVe[i];
     }
   }
 
   // Set electron density and temperature, now with boundary conditions
-  setBoundary(electrons["density"], fromFieldAligned(Ne));
-  setBoundary(electrons["temperature"], fromFieldAligned(Te));
-  setBoundary(electrons["pressure"], fromFieldAligned(Pe));
+  setBoundary(electrons["density"], Ne.scatter(Ne_field));
+  setBoundary(electrons["temperature"], Te.scatter(Te_field));
+  setBoundary(electrons["pressure"], Pe.scatter(Pe_field));
 
   //////////////////////////////////////////////////////////////////
   // Iterate through all ions
   // Sum the ion currents into the wall to calculate the electron flow
 
+  Coordinates* coord = mesh->getCoordinates();
+
   for (auto& kv : allspecies.getChildren()) {
     if (kv.first == "e") {
       continue; // Skip electrons
@@ -230,203 +226,217 @@ void SheathBoundaryInsulating::transform(Options &state) {
                                    : 5. / 3; // Ratio of specific heats (ideal gas)
 
     // Density and temperature boundary conditions will be imposed (free)
-    Field3D Ni = toFieldAligned(floor(getNoBoundary<Field3D>(species["density"]), 0.0));
-    Field3D Ti = toFieldAligned(getNoBoundary<Field3D>(species["temperature"]));
-    Field3D Pi = species.isSet("pressure")
-      ? toFieldAligned(getNoBoundary<Field3D>(species["pressure"]))
-      : Ni * Ti;
+    const Field3D Ni_field = floor(getNoBoundary<Field3D>(species["density"]), 0.0);
+    const Field3D Ti_field = getNoBoundary<Field3D>(species["temperature"]);
+    const Field3D Pi_field = species.isSet("pressure")
+      ? getNoBoundary<Field3D>(species["pressure"])
+      : Ni_field * Ti_field;
 
     // Get the velocity and momentum
     // These will be modified at the boundaries
     // and then put back into the state
-    Field3D Vi = species.isSet("velocity")
-      ? toFieldAligned(getNoBoundary<Field3D>(species["velocity"]))
-      : zeroFrom(Ni);
-    Field3D NVi = species.isSet("momentum")
-      ? toFieldAligned(getNoBoundary<Field3D>(species["momentum"]))
-      : Mi * Ni * Vi;
+    const Field3D Vi_field = species.isSet("velocity")
+      ? getNoBoundary<Field3D>(species["velocity"])
+      : zeroFrom(Ni_field);
+    const Field3D NVi_field = species.isSet("momentum")
+      ? getNoBoundary<Field3D>(species["momentum"])
+      : Mi * Ni_field * Vi_field;
 
     // Energy source will be modified in the domain
-    Field3D energy_source = species.isSet("energy_source")
-      ? toFieldAligned(getNonFinal<Field3D>(species["energy_source"]))
-      : zeroFrom(Ni);
+    const Field3D energy_source_field = species.isSet("energy_source")
+      ? getNonFinal<Field3D>(species["energy_source"])
+      : zeroFrom(Ni_field);
+
+    BoundarySlice Ni(Ni_field), Ti(Ti_field), Pi(Pi_field);
+    BoundarySlice Vi(Vi_field), NVi(NVi_field);
+    BoundarySlice energy_source(energy_source_field);
+
+    const Field3D energy_flow_field = species.isSet("energy_flow_ylow")
+      ? getNonFinal<Field3D>(species["energy_flow_ylow"])
+      : zeroFrom(Ni_field);
+    BoundarySlice energy_flow(energy_flow_field);
 
     if (lower_y) {
-      for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(Ne, r.ind, mesh->ystart, jz);
-          auto ip = i.yp();
-          auto im = i.ym();
-
-          // Free gradient of log electron density and temperature
-          // This ensures that the guard cell values remain positive
-          // exp( 2*log(N[i]) - log(N[ip]) )
-
-          Ni[im] = limitFree(Ni[ip], Ni[i]);
-          Ti[im] = limitFree(Ti[ip], Ti[i]);
-          Pi[im] = limitFree(Pi[ip], Pi[i]);
-
-          // Calculate sheath values at half-way points (cell edge)
-          const BoutReal nesheath = 0.5 * (Ne[im] + Ne[i]);
-          const BoutReal nisheath = 0.5 * (Ni[im] + Ni[i]);
-          const BoutReal tesheath = floor(0.5 * (Te[im] + Te[i]), 1e-5);  // electron temperature
-          const BoutReal tisheath = floor(0.5 * (Ti[im] + Ti[i]), 1e-5);  // ion temperature
-
-          // Ion sheath heat transmission coefficient
-          // Equation (22) in Tskhakaya 2005
-          // with 
-          //
-          // 1 / (1 + ∂_{ln n_e} ln s_i = s_i ∂_z n_e / ∂_z n_i
-          // (from comparing C_i^2 in eq. 9 with eq. 20
-          //
-          // 
-          BoutReal s_i = clip(nisheath / floor(nesheath, 1e-10), 0, 1); // Concentration
-          BoutReal grad_ne = Ne[i] - nesheath;
-          BoutReal grad_ni = Ni[i] - nisheath;
-
-          if (fabs(grad_ni) < 1e-3) {
-            grad_ni = grad_ne = 1e-3; // Remove kinetic correction term
-          }
-
-          // Ion speed into sheath
-          // Equation (9) in Tskhakaya 2005
-          //
-          BoutReal C_i_sq =
-              clip((adiabatic * tisheath + Zi * s_i * tesheath * grad_ne / grad_ni) / Mi,
-                   0, 100); // Limit for e.g. Ni zero gradient
-
-          // Ion sheath heat transmission coefficient
-          const BoutReal gamma_i = 2.5 + 0.5 * Mi * C_i_sq / tisheath;
-
-          const BoutReal visheath = - sqrt(C_i_sq); // Negative -> into sheath
-
-          // Set boundary conditions on flows
-          Vi[im] = 2. * visheath - Vi[i];
-          NVi[im] = 2. * Mi * nisheath * visheath - NVi[i];
-
-          // Add electron flow to balance current
-          Ve[im] += 2. * visheath * Zi;
-          NVe[im] += 2. * Me * nisheath * visheath; 
-
-          // Take into account the flow of energy due to fluid flow
-          // This is additional energy flux through the sheath
-          // Note: Here this is negative because visheath < 0
-          BoutReal q =
-              ((gamma_i - 1 - 1 / (adiabatic - 1)) * tisheath - 0.5 * Mi * C_i_sq)
-              * nisheath * visheath;
-          if (q > 0.0) {
-            q = 0.0;
-          }
-
-          // Multiply by cell area to get power
-          BoutReal flux = q * (coord->J[i] + coord->J[im])
-                          / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[im]));
-
-          // Divide by volume of cell to get energy loss rate (< 0)
-          BoutReal power = flux / (coord->dy[i] * coord->J[i]);
-	  ASSERT1(std::isfinite(power));
-          ASSERT2(power <= 0.0);
+      for (const auto& cell : wall.lower_target) {
+        auto i = cell.i;
+        auto ip = i.yp();
+        auto im = i.ym();
+
+        // Free gradient of log electron density and temperature
+        // This ensures that the guard cell values remain positive
+        // exp( 2*log(N[i]) - log(N[ip]) )
+
+        Ni[im] = limitFree(Ni[ip], Ni[i]);
+        Ti[im] = limitFree(Ti[ip], Ti[i]);
+        Pi[im] = limitFree(Pi[ip], Pi[i]);
+
+        // Calculate sheath values at half-way points (cell edge)
+        const BoutReal nesheath = 0.5 * (Ne[im] + Ne[i]);
+        const BoutReal nisheath = 0.5 * (Ni[im] + Ni[i]);
+        const BoutReal tesheath = floor(0.5 * (Te[im] + Te[i]), 1e-5);  // electron temperature
+        const BoutReal tisheath = floor(0.5 * (Ti[im] + Ti[i]), 1e-5);  // ion temperature
+
+        // Ion sheath heat transmission coefficient
+        // Equation (22) in Tskhakaya 2005
+        // with 
+        //
+        // 1 / (1 + ∂_{ln n_e} ln s_i = s_i ∂_z n_e / ∂_z n_i
+        // (from comparing C_i^2 in eq. 9 with eq. 20
+        //
+        // 
+        BoutReal s_i = clip(nisheath / floor(nesheath, 1e-10), 0, 1); // Concentration
+        BoutReal grad_ne = Ne[i] - nesheath;
+        BoutReal grad_ni = Ni[i] - nisheath;
+
+        if (fabs(grad_ni) < 1e-3) {
+          grad_ni = grad_ne = 1e-3; // Remove kinetic correction term
+        }
 
-          energy_source[i] += power;
+        // Ion speed into sheath
+        // Equation (9) in Tskhakaya 2005
+        //
+        BoutReal C_i_sq =
+            clip((adiabatic * tisheath + Zi * s_i * tesheath * grad_ne / grad_ni) / Mi,
+                 0, 100); // Limit for e.g. Ni zero gradient
+
+        // Ion sheath heat transmission coefficient
+        const BoutReal gamma_i = 2.5 + 0.5 * Mi * C_i_sq / tisheath;
+
+        const BoutReal visheath = - sqrt(C_i_sq); // Negative -> into sheath
+
+        // Set boundary conditions on flows
+        Vi[im] = 2. * visheath - Vi[i];
+        NVi[im] = 2. * Mi * nisheath * visheath - NVi[i];
+
+        // Add electron flow to balance current
+        Ve[im] += 2. * visheath * Zi;
+        NVe[im] += 2. * Me * nisheath * visheath; 
+
+        // Take into account the flow of energy due to fluid flow
+        // This is additional energy flux through the sheath
+        // Note: Here this is negative because visheath < 0
+        BoutReal q =
+            ((gamma_i - 1 - 1 / (adiabatic - 1)) * tisheath - 0.5 * Mi * C_i_sq)
+            * nisheath * visheath;
+        if (q > 0.0) {
+          q = 0.0;
         }
+
+        // Multiply by cell area to get power
+        BoutReal flux = q * cell.area;
+
+        // Divide by volume of cell to get energy loss rate (< 0)
+        BoutReal power = flux * cell.inv_volume;
+	  ASSERT1(std::isfinite(power));
+        ASSERT2(power <= 0.0);
+
+        energy_source[i] += power;
+
+        // Total heat flow through the lower face of cell i (< 0)
+        energy_flow[i] += gamma_i * tisheath * nisheath * visheath * cell.area
+                          * coord->dx[i] * coord->dz[i];
       }
     }
     if (upper_y) {
       // Note: This is essentially the same as the lower boundary,
       // but with directions reversed e.g. ystart -> yend, ip <-> im
       // 
-      for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(Ne, r.ind, mesh->yend, jz);
-          auto ip = i.yp();
-          auto im = i.ym();
-
-          // Free gradient of log electron density and temperature
-          // This ensures that the guard cell values remain positive
-          // exp( 2*log(N[i]) - log(N[ip]) )
-
-          Ni[ip] = limitFree(Ni[im], Ni[i]);
-          Ti[ip] = limitFree(Ti[im], Ti[i]);
-          Pi[ip] = limitFree(Pi[im], Pi[i]);
-
-          // Calculate sheath values at half-way points (cell edge)
-          const BoutReal nesheath = 0.5 * (Ne[ip] + Ne[i]);
-          const BoutReal nisheath = 0.5 * (Ni[ip] + Ni[i]);
-          const BoutReal tesheath = floor(0.5 * (Te[ip] + Te[i]), 1e-5);  // electron temperature
-          const BoutReal tisheath = floor(0.5 * (Ti[ip] + Ti[i]), 1e-5);  // ion temperature
-
-          // Ion sheath heat transmission coefficient
-          //
-          // 1 / (1 + ∂_{ln n_e} ln s_i = s_i * ∂n_e / (s_i * ∂n_e + ∂ n_i) 
-          BoutReal s_i = (nesheath > 1e-5) ? nisheath / nesheath : 0.0; // Concentration
-          BoutReal grad_ne = Ne[i] - nesheath;
-          BoutReal grad_ni = Ni[i] - nisheath;
-
-          if (fabs(grad_ni) < 1e-3) {
-            grad_ni = grad_ne = 1e-3; // Remove kinetic correction term
-          }
-
-          // Ion speed into sheath
-          // Equation (9) in Tskhakaya 2005
-          //
-          BoutReal C_i_sq =
-              clip((adiabatic * tisheath + Zi * s_i * tesheath * grad_ne / grad_ni) / Mi,
-                   0, 100); // Limit for e.g. Ni zero gradient
-
-          const BoutReal gamma_i = 2.5 + 0.5 * Mi * C_i_sq / tisheath; // + Δγ 
-
-          const BoutReal visheath = sqrt(C_i_sq); // Positive -> into sheath
-
-          // Set boundary conditions on flows
-          Vi[ip] = 2. * visheath - Vi[i];
-          NVi[ip] = 2. * Mi * nisheath * visheath - NVi[i];
-
-          // Add electron flow to balance current
-          Ve[ip] += 2. * visheath * Zi;
-          NVe[ip] += 2. * Me * nisheath * visheath; 
-
-          // Take into account the flow of energy due to fluid flow
-          // This is additional energy flux through the sheath
-          // Note: Here this is positive because visheath > 0
-          BoutReal q =
-              ((gamma_i - 1 - 1 / (adiabatic - 1)) * tisheath - 0.5 * C_i_sq * Mi)
-              * nisheath * visheath;
-
-          if (q < 0.0) {
-            q = 0.0;
-          }
-
-          // Multiply by cell area to get power
-          BoutReal flux = q * (coord->J[i] + coord->J[ip])
-                          / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[ip]));
-
-          // Divide by volume of cell to get energy loss rate (> 0)
-          BoutReal power = flux / (coord->dy[i] * coord->J[i]);
-          ASSERT1(std::isfinite(power));
-          ASSERT2(power >= 0.0);
-
-          energy_source[i] -= power; // Note: Sign negative because power > 0
+      for (const auto& cell : wall.upper_target) {
+        auto i = cell.i;
+        auto ip = i.yp();
+        auto im = i.ym();
+
+        // Free gradient of log electron density and temperature
+        // This ensures that the guard cell values remain positive
+        // exp( 2*log(N[i]) - log(N[ip]) )
+
+        Ni[ip] = limitFree(Ni[im], Ni[i]);
+        Ti[ip] = limitFree(Ti[im], Ti[i]);
+        Pi[ip] = limitFree(Pi[im], Pi[i]);
+
+        // Calculate sheath values at half-way points (cell edge)
+        const BoutReal nesheath = 0.5 * (Ne[ip] + Ne[i]);
+        const BoutReal nisheath = 0.5 * (Ni[ip] + Ni[i]);
+        const BoutReal tesheath = floor(0.5 * (Te[ip] + Te[i]), 1e-5);  // electron temperature
+        const BoutReal tisheath = floor(0.5 * (Ti[ip] + Ti[i]), 1e-5);  // ion temperature
+
+        // Ion sheath heat transmission coefficient
+        //
+        // 1 / (1 + ∂_{ln n_e} ln s_i = s_i * ∂n_e / (s_i * ∂n_e + ∂ n_i) 
+        BoutReal s_i = (nesheath > 1e-5) ? nisheath / nesheath : 0.0; // Concentration
+        BoutReal grad_ne = Ne[i] - nesheath;
+        BoutReal grad_ni = Ni[i] - nisheath;
+
+        if (fabs(grad_ni) < 1e-3) {
+          grad_ni = grad_ne = 1e-3; // Remove kinetic correction term
+        }
+
+        // Ion speed into sheath
+        // Equation (9) in Tskhakaya 2005
+        //
+        BoutReal C_i_sq =
+            clip((adiabatic * tisheath + Zi * s_i * tesheath * grad_ne / grad_ni) / Mi,
+                 0, 100); // Limit for e.g. Ni zero gradient
+
+        const BoutReal gamma_i = 2.5 + 0.5 * Mi * C_i_sq / tisheath; // + Δγ 
+
+        const BoutReal visheath = sqrt(C_i_sq); // Positive -> into sheath
+
+        // Set boundary conditions on flows
+        Vi[ip] = 2. * visheath - Vi[i];
+        NVi[ip] = 2. * Mi * nisheath * visheath - NVi[i];
+
+        // Add electron flow to balance current
+        Ve[ip] += 2. * visheath * Zi;
+        NVe[ip] += 2. * Me * nisheath * visheath; 
+
+        // Take into account the flow of energy due to fluid flow
+        // This is additional energy flux through the sheath
+        // Note: Here this is positive because visheath > 0
+        BoutReal q =
+            ((gamma_i - 1 - 1 / (adiabatic - 1)) * tisheath - 0.5 * C_i_sq * Mi)
+            * nisheath * visheath;
+
+        if (q < 0.0) {
+          q = 0.0;
         }
+
+        // Multiply by cell area to get power
+        BoutReal flux = q * cell.area;
+
+        // Divide by volume of cell to get energy loss rate (> 0)
+        BoutReal power = flux * cell.inv_volume;
+        ASSERT1(std::isfinite(power));
+        ASSERT2(power >= 0.0);
+
+        energy_source[i] -= power; // Note: Sign negative because power > 0
+
+        // Total heat flow through the upper face of cell i (> 0)
+        energy_flow[ip] += gamma_i * tisheath * nisheath * visheath * cell.area
+                           * coord->dx[i] * coord->dz[i];
       }
     }
 
     // Finished boundary conditions for this species
     // Put the modified fields back into the state.
-    setBoundary(species["density"], fromFieldAligned(Ni));
-    setBoundary(species["temperature"], fromFieldAligned(Ti));
-    setBoundary(species["pressure"], fromFieldAligned(Pi));
+    setBoundary(species["density"], Ni.scatter(Ni_field));
+    setBoundary(species["temperature"], Ti.scatter(Ti_field));
+    setBoundary(species["pressure"], Pi.scatter(Pi_field));
 
     if (species.isSet("velocity")) {
-      setBoundary(species["velocity"], fromFieldAligned(Vi));
+      setBoundary(species["velocity"], Vi.scatter(Vi_field));
     }
 
     if (species.isSet("momentum")) {
-      setBoundary(species["momentum"], fromFieldAligned(NVi));
+      setBoundary(species["momentum"], NVi.scatter(NVi_field));
     }
 
     // Additional loss of energy through sheath
     // Note: Already includes any previously set sources
-    set(species["energy_source"], fromFieldAligned(energy_source));
+    set(species["energy_source"], energy_source.scatter(energy_source_field));
+
+    // Heat flow through the sheath, including previously set flows
+    set(species["energy_flow_ylow"], energy_flow.scatter(energy_flow_field));
   }
 
   //////////////////////////////////////////////////////////////////
@@ -434,88 +444,102 @@ void SheathBoundaryInsulating::transform(Options &state) {
   // This time adding energy sink, having calculated flow
   //
 
-  Field3D electron_energy_source = electrons.isSet("energy_source")
-    ? toFieldAligned(getNonFinal<Field3D>(electrons["energy_source"]))
-    : zeroFrom(Ne);
+  const Field3D electron_energy_source_field = electrons.isSet("energy_source")
+    ? getNonFinal<Field3D>(electrons["energy_source"])
+    : zeroFrom(Ne_field);
+  BoundarySlice electron_energy_source(electron_energy_source_field);
+
+  // Heat flow through the sheath, at the Y cell faces
+  const Field3D electron_energy_flow_field = electrons.isSet("energy_flow_ylow")
+    ? getNonFinal<Field3D>(electrons["energy_flow_ylow"])
+    : zeroFrom(Ne_field);
+  BoundarySlice electron_energy_flow(electron_energy_flow_field);
 
   if (lower_y) {
-    for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-      for (int jz = 0; jz < mesh->LocalNz; jz++) {
-        auto i = indexAt(Ne, r.ind, mesh->ystart, jz);
-        auto ip = i.yp();
-        auto im = i.ym();
+    for (const auto& cell : wall.lower_target) {
+      auto i = cell.i;
+      auto ip = i.yp();
+      auto im = i.ym();
 
-        const BoutReal nesheath = 0.5 * (Ne[im] + Ne[i]);
-        const BoutReal tesheath = 0.5 * (Te[im] + Te[i]);  // electron temperature
-        // Electron velocity into sheath (< 0). Calculated from ion flow
-        const BoutReal vesheath = 0.5 * (Ve[im] + Ve[i]);
+      const BoutReal nesheath = 0.5 * (Ne[im] + Ne[i]);
+      const BoutReal tesheath = 0.5 * (Te[im] + Te[i]);  // electron temperature
+      // Electron velocity into sheath (< 0). Calculated from ion flow
+      const BoutReal vesheath = 0.5 * (Ve[im] + Ve[i]);
 
-        // Take into account the flow of energy due to fluid flow
-        // This is additional energy flux through the sheath
-        // Note: Here this is negative because vesheath < 0
-        BoutReal q = ((gamma_e - 1 - 1 / (electron_adiabatic - 1)) * tesheath
-                      - 0.5 * Me * SQ(vesheath))
-                     * nesheath * vesheath;
+      // Take into account the flow of energy due to fluid flow
+      // This is additional energy flux through the sheath
+      // Note: Here this is negative because vesheath < 0
+      BoutReal q = ((gamma_e - 1 - 1 / (electron_adiabatic - 1)) * tesheath
+                    - 0.5 * Me * SQ(vesheath))
+                   * nesheath * vesheath;
 
-        // Multiply by cell area to get power
-        BoutReal flux = q * (coord->J[i] + coord->J[im])
-                        / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[im]));
+      // Multiply by cell area to get power
+      BoutReal flux = q * cell.area;
 
-        // Divide by volume of cell to get energy loss rate (< 0)
-        BoutReal power = flux / (coord->dy[i] * coord->J[i]);
+      // Divide by volume of cell to get energy loss rate (< 0)
+      BoutReal power = flux * cell.inv_volume;
 
 #if CHECKLEVEL >= 1
-        if (!std::isfinite(power)) {
+      if (!std::isfinite(power)) {
 	  throw BoutException("Non-finite power at {} : Te {} Ne {} Ve {}", i, tesheath, nesheath, vesheath);
 	}
 #endif
 
-        electron_energy_source[i] += power;
-      }
+      electron_energy_source[i] += power;
+
+      // Total heat flow through the lower face of cell i (< 0)
+      electron_energy_flow[i] += gamma_e * tesheath * nesheath * vesheath * cell.area
+                                 * coord->dx[i] * coord->dz[i];
     }
   }
   if (upper_y) {
-    for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-      for (int jz = 0; jz < mesh->LocalNz; jz++) {
-        auto i = indexAt(Ne, r.ind, mesh->yend, jz);
-        auto ip = i.yp();
-        auto im = i.ym();
-
-        const BoutReal nesheath = 0.5 * (Ne[ip] + Ne[i]);
-        const BoutReal tesheath = 0.5 * (Te[ip] + Te[i]);  // electron temperature
-        const BoutReal vesheath = 0.5 * (Ve[im] + Ve[i]);  // From ion flow
-
-        // Take into account the flow of energy due to fluid flow
-        // This is additional energy flux through the sheath
-        // Note: Here this is positive because vesheath > 0
-        BoutReal q = ((gamma_e - 1 - 1 / (electron_adiabatic - 1)) * tesheath
-                      - 0.5 * Me * SQ(vesheath))
-                     * nesheath * vesheath;
-
-        // Multiply by cell area to get power
-        BoutReal flux = q * (coord->J[i] + coord->J[ip])
-                        / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[ip]));
-
-        // Divide by volume of cell to get energy loss rate (> 0)
-        BoutReal power = flux / (coord->dy[i] * coord->J[i]);
+    for (const auto& cell : wall.upper_target) {
+      auto i = cell.i;
+      auto ip = i.yp();
+      auto im = i.ym();
+
+      const BoutReal nesheath = 0.5 * (Ne[ip] + Ne[i]);
+      const BoutReal tesheath = 0.5 * (Te[ip] + Te[i]);  // electron temperature
+      const BoutReal vesheath = 0.5 * (Ve[im] + Ve[i]);  // From ion flow
+
+      // Take into account the flow of energy due to fluid flow
+      // This is additional energy flux through the sheath
+      // Note: Here this is positive because vesheath > 0
+      BoutReal q = ((gamma_e - 1 - 1 / (electron_adiabatic - 1)) * tesheath
+                    - 0.5 * Me * SQ(vesheath))
+                   * nesheath * vesheath;
+
+      // Multiply by cell area to get power
+      BoutReal flux = q * cell.area;
+
+      // Divide by volume of cell to get energy loss rate (> 0)
+      BoutReal power = flux * cell.inv_volume;
 #if CHECKLEVEL >= 1
 	if (!std::isfinite(power)) {
 	  throw BoutException("Non-finite power {} at {} : Te {} Ne {} Ve {} => q {}, flux {}",
-                              power, i, tesheath, nesheath, vesheath, q, flux);
-        }
-#endif
-        electron_energy_source[i] -= power;
+                            power, i, tesheath, nesheath, vesheath, q, flux);
       }
+#endif
+      electron_energy_source[i] -= power;
+
+      // Total heat flow through the upper face of cell i (> 0)
+      electron_energy_flow[ip] += gamma_e * tesheath * nesheath * vesheath * cell.area
+                                  * coord->dx[i] * coord->dz[i];
     }
   }
 
   // Set energy source (negative in cell next to sheath)
-  set(electrons["energy_source"], fromFieldAligned(electron_energy_source));
+  set(electrons["energy_source"],
+      electron_energy_source.scatter(electron_energy_source_field));
+
+  // Heat flow through the sheath, including previously set flows
+  set(electrons["energy_flow_ylow"],
+      electron_energy_flow.scatter(electron_energy_flow_field));
 
   if (IS_SET_NOBOUNDARY(electrons["velocity"])) {
-    setBoundary(electrons["velocity"], fromFieldAligned(Ve));
+    setBoundary(electrons["velocity"], Ve.scatter(Ve_field));
   }
   if (IS_SET_NOBOUNDARY(electrons["momentum"])) {
-    setBoundary(electrons["momentum"], fromFieldAligned(NVe));
+    setBoundary(electrons["momentum"], NVe.scatter(NVe_field));
   }
 }
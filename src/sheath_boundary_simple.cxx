@@ -1,6 +1,8 @@
 #include "../include/sheath_boundary_simple.hxx"
+#include "../include/boundary_slice.hxx"
 
 #include "bout/constants.hxx"
+#include "bout/coordinates.hxx"
 #include "bout/mesh.hxx"
 using bout::globals::mesh;
 
@@ -19,12 +21,6 @@ BoutReal floor(BoutReal value, BoutReal min) {
   return value;
 }
 
-Ind3D indexAt(const Field3D& f, int x, int y, int z) {
-  int ny = f.getNy();
-  int nz = f.getNz();
-  return Ind3D{(x * ny + y) * nz + z, ny, nz};
-}
-
 /// Limited free gradient of log of a quantity
 /// This ensures that the guard cell values remain positive
 /// while also ensuring that the quantity never increases
@@ -106,6 +102,8 @@ SheathBoundarySimple::SheathBoundarySimple(std::string name, Options& alloptions
                    / Tnorm;
   // Convert to field aligned coordinates
   wall_potential = toFieldAligned(wall_potential);
+
+  wall = WallBoundary(mesh);
 }
 
 void SheathBoundarySimple::transform(Options& state) {
@@ -115,35 +113,42 @@ void SheathBoundarySimple::transform(Options& state) {
   Options& electrons = allspecies["e"];
 
   // Need electron properties
+  const Field3D Ne_field = floor(GET_NOBOUNDARY(Field3D, electrons["density"]), 0.0);
+  const Field3D Te_field = GET_NOBOUNDARY(Field3D, electrons["temperature"]);
+  const Field3D Pe_field = IS_SET_NOBOUNDARY(electrons["pressure"])
+    ? getNoBoundary<Field3D>(electrons["pressure"])
+    : Te_field * Ne_field;
+
+  // Field-aligned values next to the boundaries
   // Not const because boundary conditions will be set
-  Field3D Ne = toFieldAligned(floor(GET_NOBOUNDARY(Field3D, electrons["density"]), 0.0));
-  Field3D Te = toFieldAligned(GET_NOBOUNDARY(Field3D, electrons["temperature"]));
-  Field3D Pe = IS_SET_NOBOUNDARY(electrons["pressure"])
-    ? toFieldAligned(getNoBoundary<Field3D>(electrons["pressure"]))
-    : Te * Ne;
+  BoundarySlice Ne(Ne_field);
+  BoundarySlice Te(Te_field);
+  BoundarySlice Pe(Pe_field);
 
   // Mass, normalised to proton mass
   const BoutReal Me =
       IS_SET(electrons["AA"]) ? get<BoutReal>(electrons["AA"]) : SI::Me / SI::Mp;
 
   // This is for applying boundary conditions
-  Field3D Ve = IS_SET_NOBOUNDARY(electrons["velocity"])
-    ? toFieldAligned(getNoBoundary<Field3D>(electrons["velocity"]))
-    : zeroFrom(Ne);
+  const Field3D Ve_field = IS_SET_NOBOUNDARY(electrons["velocity"])
+    ? getNoBoundary<Field3D>(electrons["velocity"])
+    : zeroFrom(Ne_field);
+  BoundarySlice Ve(Ve_field);
 
-  Field3D NVe = IS_SET_NOBOUNDARY(electrons["momentum"])
-    ? toFieldAligned(getNoBoundary<Field3D>(electrons["momentum"]))
-    : zeroFrom(Ne);
-
-  Coordinates* coord = mesh->getCoordinates();
+  const Field3D NVe_field = IS_SET_NOBOUNDARY(electrons["momentum"])
+    ? getNoBoundary<Field3D>(electrons["momentum"])
+    : zeroFrom(Ne_field);
+  BoundarySlice NVe(NVe_field);
 
   //////////////////////////////////////////////////////////////////
   // Electrostatic potential
   // If phi is set, use free boundary condition
   // If phi not set, calculate assuming zero current
-  Field3D phi;
+  Field3D phi_field;
+  BoundarySlice phi;
   if (IS_SET_NOBOUNDARY(state["fields"]["phi"])) {
-    phi = toFieldAligned(getNoBoundary<Field3D>(state["fields"]["phi"]));
+    phi_field = getNoBoundary<Field3D>(state["fields"]["phi"]);
+    phi = BoundarySlice(phi_field);
   } else {
     // Calculate potential phi assuming zero current
 
@@ -151,7 +156,9 @@ void SheathBoundarySimple::transform(Options& state) {
     //
     // To avoid looking up species for every grid point, this
     // loops over the boundaries once per species.
-    Field3D ion_sum = 0.0;
+    BoundarySlice ion_sum;
+    // Note: phi in the domain is not calculated
+    phi_field = zeroFrom(Ne_field);
 
     // Iterate through charged ion species
     for (auto& kv : allspecies.getChildren()) {
@@ -162,120 +169,110 @@ void SheathBoundarySimple::transform(Options& state) {
         continue; // Skip electrons and non-charged ions
       }
 
-      const Field3D Ni = getNoBoundary<Field3D>(species["density"]);
-      const Field3D Ti = getNoBoundary<Field3D>(species["temperature"]);
+      const BoundarySlice Ni(getNoBoundary<Field3D>(species["density"]));
+      const BoundarySlice Ti(getNoBoundary<Field3D>(species["temperature"]));
       const BoutReal Mi = getNoBoundary<BoutReal>(species["AA"]);
       const BoutReal Zi = getNoBoundary<BoutReal>(species["charge"]);
 
       if (lower_y) {
         // Sum values, put result in mesh->ystart
 
-        for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-          for (int jz = 0; jz < mesh->LocalNz; jz++) {
-            auto i = indexAt(Ni, r.ind, mesh->ystart, jz);
-            auto ip = i.yp();
+        for (const auto& cell : wall.lower_target) {
+          auto i = cell.i;
+          auto ip = i.yp();
 
-            // Free gradient of log density and temperature
-            // This ensures that the guard cell values remain positive
-            // exp( 2*log(N[i]) - log(N[ip]) )
+          // Free gradient of log density and temperature
+          // This ensures that the guard cell values remain positive
+          // exp( 2*log(N[i]) - log(N[ip]) )
 
-            const BoutReal Ni_im = limitFree(Ni[ip], Ni[i]);
-            const BoutReal Ti_im = limitFree(Ti[ip], Ti[i]);
-            const BoutReal Te_im = limitFree(Te[ip], Te[i]);
+          const BoutReal Ni_im = limitFree(Ni[ip], Ni[i]);
+          const BoutReal Ti_im = limitFree(Ti[ip], Ti[i]);
+          const BoutReal Te_im = limitFree(Te[ip], Te[i]);
 
-            // Calculate sheath values at half-way points (cell edge)
-            const BoutReal nisheath = 0.5 * (Ni_im + Ni[i]);
-            const BoutReal tesheath =
-                floor(0.5 * (Te_im + Te[i]), 1e-5); // electron temperature
-            const BoutReal tisheath =
-                floor(0.5 * (Ti_im + Ti[i]), 1e-5); // ion temperature
+          // Calculate sheath values at half-way points (cell edge)
+          const BoutReal nisheath = 0.5 * (Ni_im + Ni[i]);
+          const BoutReal tesheath =
+              floor(0.5 * (Te_im + Te[i]), 1e-5); // electron temperature
+          const BoutReal tisheath =
+              floor(0.5 * (Ti_im + Ti[i]), 1e-5); // ion temperature
 
-            // Sound speed squared
-            BoutReal C_i_sq = (sheath_ion_polytropic * tisheath + Zi * tesheath) / Mi;
+          // Sound speed squared
+          BoutReal C_i_sq = (sheath_ion_polytropic * tisheath + Zi * tesheath) / Mi;
 
-            ion_sum[i] += Zi * nisheath * sqrt(C_i_sq);
-          }
+          ion_sum[i] += Zi * nisheath * sqrt(C_i_sq);
         }
       }
 
       if (upper_y) {
         // Sum values, put results in mesh->yend
 
-        for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-          for (int jz = 0; jz < mesh->LocalNz; jz++) {
-            auto i = indexAt(Ni, r.ind, mesh->yend, jz);
-            auto im = i.ym();
+        for (const auto& cell : wall.upper_target) {
+          auto i = cell.i;
+          auto im = i.ym();
 
-            const BoutReal Ni_ip = limitFree(Ni[im], Ni[i]);
-            const BoutReal Ti_ip = limitFree(Ti[im], Ti[i]);
-            const BoutReal Te_ip = limitFree(Te[im], Te[i]);
+          const BoutReal Ni_ip = limitFree(Ni[im], Ni[i]);
+          const BoutReal Ti_ip = limitFree(Ti[im], Ti[i]);
+          const BoutReal Te_ip = limitFree(Te[im], Te[i]);
 
-            // Calculate sheath values at half-way points (cell edge)
-            const BoutReal nisheath = 0.5 * (Ni_ip + Ni[i]);
-            const BoutReal tesheath =
-                floor(0.5 * (Te_ip + Te[i]), 1e-5); // electron temperature
-            const BoutReal tisheath =
-                floor(0.5 * (Ti_ip + Ti[i]), 1e-5); // ion temperature
+          // Calculate sheath values at half-way points (cell edge)
+          const BoutReal nisheath = 0.5 * (Ni_ip + Ni[i]);
+          const BoutReal tesheath =
+              floor(0.5 * (Te_ip + Te[i]), 1e-5); // electron temperature
+          const BoutReal tisheath =
+              floor(0.5 * (Ti_ip + Ti[i]), 1e-5); // ion temperature
 
-            BoutReal C_i_sq = (sheath_ion_polytropic * tisheath + Zi * tesheath) / Mi;
+          BoutReal C_i_sq = (sheath_ion_polytropic * tisheath + Zi * tesheath) / Mi;
 
-            ion_sum[i] += Zi * nisheath * sqrt(C_i_sq);
-          }
+          ion_sum[i] += Zi * nisheath * sqrt(C_i_sq);
         }
       }
     }
 
-    phi.allocate();
-
     // ion_sum now contains the ion current, sum Z_i n_i C_i over all ion species
     // at mesh->ystart and mesh->yend indices
     if (lower_y) {
-      for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(phi, r.ind, mesh->ystart, jz);
-          auto ip = i.yp();
+      for (const auto& cell : wall.lower_target) {
+        auto i = cell.i;
+        auto ip = i.yp();
 
-          const BoutReal Ne_im = limitFree(Ne[ip], Ne[i]);
-          const BoutReal Te_im = limitFree(Te[ip], Te[i]);
+        const BoutReal Ne_im = limitFree(Ne[ip], Ne[i]);
+        const BoutReal Te_im = limitFree(Te[ip], Te[i]);
 
-          // Calculate sheath values at half-way points (cell edge)
-          const BoutReal nesheath = 0.5 * (Ne_im + Ne[i]);
-          const BoutReal tesheath = floor(0.5 * (Te_im + Te[i]), 1e-5);
+        // Calculate sheath values at half-way points (cell edge)
+        const BoutReal nesheath = 0.5 * (Ne_im + Ne[i]);
+        const BoutReal tesheath = floor(0.5 * (Te_im + Te[i]), 1e-5);
 
-          phi[i] =
-              tesheath
-              * log(sqrt(tesheath / (Me * TWOPI)) * (1. - Ge) * nesheath / ion_sum[i]);
+        phi[i] =
+            tesheath
+            * log(sqrt(tesheath / (Me * TWOPI)) * (1. - Ge) * nesheath / ion_sum[i]);
 
-          const BoutReal phi_wall = wall_potential[i];
-          phi[i] += phi_wall; // Add bias potential
+        const BoutReal phi_wall = wall_potential[i];
+        phi[i] += phi_wall; // Add bias potential
 
-          phi[i.yp()] = phi[i.ym()] = phi[i]; // Constant into sheath
-        }
+        phi[i.yp()] = phi[i.ym()] = phi[i]; // Constant into sheath
       }
     }
 
     if (upper_y) {
-      for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(phi, r.ind, mesh->yend, jz);
-          auto im = i.ym();
+      for (const auto& cell : wall.upper_target) {
+        auto i = cell.i;
+        auto im = i.ym();
 
-          const BoutReal Ne_ip = limitFree(Ne[im], Ne[i]);
-          const BoutReal Te_ip = limitFree(Te[im], Te[i]);
+        const BoutReal Ne_ip = limitFree(Ne[im], Ne[i]);
+        const BoutReal Te_ip = limitFree(Te[im], Te[i]);
 
-          // Calculate sheath values at half-way points (cell edge)
-          const BoutReal nesheath = 0.5 * (Ne_ip + Ne[i]);
-          const BoutReal tesheath = floor(0.5 * (Te_ip + Te[i]), 1e-5);
+        // Calculate sheath values at half-way points (cell edge)
+        const BoutReal nesheath = 0.5 * (Ne_ip + Ne[i]);
+        const BoutReal tesheath = floor(0.5 * (Te_ip + Te[i]), 1e-5);
 
-          phi[i] =
-              tesheath
-              * log(sqrt(tesheath / (Me * TWOPI)) * (1. - Ge) * nesheath / ion_sum[i]);
+        phi[i] =
+            tesheath
+            * log(sqrt(tesheath / (Me * TWOPI)) * (1. - Ge) * nesheath / ion_sum[i]);
 
-          const BoutReal phi_wall = wall_potential[i];
-          phi[i] += phi_wall; // Add bias potential
+        const BoutReal phi_wall = wall_potential[i];
+        phi[i] += phi_wall; // Add bias potential
 
-          phi[i.yp()] = phi[i.ym()] = phi[i];
-        }
+        phi[i.yp()] = phi[i.ym()] = phi[i];
       }
     }
   }
@@ -283,132 +280,148 @@ void SheathBoundarySimple::transform(Options& state) {
   //////////////////////////////////////////////////////////////////
   // Electrons
 
-  Field3D electron_energy_source = electrons.isSet("energy_source")
-    ? toFieldAligned(getNonFinal<Field3D>(electrons["energy_source"]))
-    : zeroFrom(Ne);
+  const Field3D electron_energy_source_field = electrons.isSet("energy_source")
+    ? getNonFinal<Field3D>(electrons["energy_source"])
+    : zeroFrom(Ne_field);
+  BoundarySlice electron_energy_source(electron_energy_source_field);
 
-  if (lower_y) {
-    for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-      for (int jz = 0; jz < mesh->LocalNz; jz++) {
-        auto i = indexAt(Ne, r.ind, mesh->ystart, jz);
-        auto ip = i.yp();
-        auto im = i.ym();
+  // Heat flow through the sheath, at the Y cell faces
+  const Field3D electron_energy_flow_field = electrons.isSet("energy_flow_ylow")
+    ? getNonFinal<Field3D>(electrons["energy_flow_ylow"])
+    : zeroFrom(Ne_field);
+  BoundarySlice electron_energy_flow(electron_energy_flow_field);
 
-        // Free gradient of log electron density and temperature
-        // Limited so that the values don't increase into the sheath
-        // This ensures that the guard cell values remain positive
-        // exp( 2*log(N[i]) - log(N[ip]) )
-
-        Ne[im] = limitFree(Ne[ip], Ne[i]);
-        Te[im] = limitFree(Te[ip], Te[i]);
-        Pe[im] = limitFree(Pe[ip], Pe[i]);
-
-        // Free boundary potential linearly extrapolated
-        phi[im] = 2 * phi[i] - phi[ip];
-
-        const BoutReal nesheath = 0.5 * (Ne[im] + Ne[i]);
-        const BoutReal tesheath = 0.5 * (Te[im] + Te[i]); // electron temperature
-        const BoutReal phi_wall = wall_potential[i];
-        const BoutReal phisheath =
-            floor(0.5 * (phi[im] + phi[i]), phi_wall); // Electron saturation at phi = phi_wall
+  Coordinates* coord = mesh->getCoordinates();
 
-        // Electron velocity into sheath (< 0)
-        BoutReal vesheath =
+  if (lower_y) {
+    for (const auto& cell : wall.lower_target) {
+      auto i = cell.i;
+      auto ip = i.yp();
+      auto im = i.ym();
+
+      // Free gradient of log electron density and temperature
+      // Limited so that the values don't increase into the sheath
+      // This ensures that the guard cell values remain positive
+      // exp( 2*log(N[i]) - log(N[ip]) )
+
+      Ne[im] = limitFree(Ne[ip], Ne[i]);
+      Te[im] = limitFree(Te[ip], Te[i]);
+      Pe[im] = limitFree(Pe[ip], Pe[i]);
+
+      // Free boundary potential linearly extrapolated
+      phi[im] = 2 * phi[i] - phi[ip];
+
+      const BoutReal nesheath = 0.5 * (Ne[im] + Ne[i]);
+      const BoutReal tesheath = 0.5 * (Te[im] + Te[i]); // electron temperature
+      const BoutReal phi_wall = wall_potential[i];
+      const BoutReal phisheath =
+          floor(0.5 * (phi[im] + phi[i]), phi_wall); // Electron saturation at phi = phi_wall
+
+      // Electron velocity into sheath (< 0)
+      BoutReal vesheath =
 	  -sqrt(tesheath / (TWOPI * Me)) * (1. - Ge) * exp(-(phisheath - phi_wall) / floor(tesheath, 1e-5));
 
-        Ve[im] = 2 * vesheath - Ve[i];
-        NVe[im] = 2 * Me * nesheath * vesheath - NVe[i];
+      Ve[im] = 2 * vesheath - Ve[i];
+      NVe[im] = 2 * Me * nesheath * vesheath - NVe[i];
 
-        // Take into account the flow of energy due to fluid flow
-        // This is additional energy flux through the sheath
-        // Note: Here this is negative because vesheath < 0
-        BoutReal q = ((gamma_e - 2.5) * tesheath
-                      - 0.5 * Me * SQ(vesheath))
-                     * nesheath * vesheath;
+      // Take into account the flow of energy due to fluid flow
+      // This is additional energy flux through the sheath
+      // Note: Here this is negative because vesheath < 0
+      BoutReal q = ((gamma_e - 2.5) * tesheath
+                    - 0.5 * Me * SQ(vesheath))
+                   * nesheath * vesheath;
 
-        // Multiply by cell area to get power
-        BoutReal flux = q * (coord->J[i] + coord->J[im])
-                        / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[im]));
+      // Multiply by cell area to get power
+      BoutReal flux = q * cell.area;
 
-        // Divide by volume of cell to get energy loss rate (< 0)
-        BoutReal power = flux / (coord->dy[i] * coord->J[i]);
+      // Divide by volume of cell to get energy loss rate (< 0)
+      BoutReal power = flux * cell.inv_volume;
 
-        electron_energy_source[i] += power;
-      }
+      electron_energy_source[i] += power;
+
+      // Total heat flow through the lower face of cell i (< 0)
+      electron_energy_flow[i] += gamma_e * tesheath * nesheath * vesheath * cell.area
+                                 * coord->dx[i] * coord->dz[i];
     }
   }
   if (upper_y) {
     // This is essentially the same as at the lower y boundary
     // except ystart -> yend, ip <-> im
     //
-    for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-      for (int jz = 0; jz < mesh->LocalNz; jz++) {
-        auto i = indexAt(Ne, r.ind, mesh->yend, jz);
-        auto ip = i.yp();
-        auto im = i.ym();
-
-        // Free gradient of log electron density and temperature
-        // This ensures that the guard cell values remain positive
-        // exp( 2*log(N[i]) - log(N[ip]) )
-
-        Ne[ip] = limitFree(Ne[im], Ne[i]);
-        Te[ip] = limitFree(Te[im], Te[i]);
-        Pe[ip] = limitFree(Pe[im], Pe[i]);
-
-        // Free boundary potential linearly extrapolated.
-        phi[ip] = 2 * phi[i] - phi[im];
-
-        const BoutReal nesheath = 0.5 * (Ne[ip] + Ne[i]);
-        const BoutReal tesheath = 0.5 * (Te[ip] + Te[i]); // electron temperature
-        const BoutReal phi_wall = wall_potential[i];
-        const BoutReal phisheath =
-            floor(0.5 * (phi[ip] + phi[i]), phi_wall); // Electron saturation at phi = phi_wall
-
-        // Electron velocity into sheath (> 0)
-        BoutReal vesheath =
+    for (const auto& cell : wall.upper_target) {
+      auto i = cell.i;
+      auto ip = i.yp();
+      auto im = i.ym();
+
+      // Free gradient of log electron density and temperature
+      // This ensures that the guard cell values remain positive
+      // exp( 2*log(N[i]) - log(N[ip]) )
+
+      Ne[ip] = limitFree(Ne[im], Ne[i]);
+      Te[ip] = limitFree(Te[im], Te[i]);
+      Pe[ip] = limitFree(Pe[im], Pe[i]);
+
+      // Free boundary potential linearly extrapolated.
+      phi[ip] = 2 * phi[i] - phi[im];
+
+      const BoutReal nesheath = 0.5 * (Ne[ip] + Ne[i]);
+      const BoutReal tesheath = 0.5 * (Te[ip] + Te[i]); // electron temperature
+      const BoutReal phi_wall = wall_potential[i];
+      const BoutReal phisheath =
+          floor(0.5 * (phi[ip] + phi[i]), phi_wall); // Electron saturation at phi = phi_wall
+
+      // Electron velocity into sheath (> 0)
+      BoutReal vesheath =
 	  sqrt(tesheath / (TWOPI * Me)) * (1. - Ge) * exp(-(phisheath - phi_wall) / floor(tesheath, 1e-5));
 
-        Ve[ip] = 2 * vesheath - Ve[i];
-        NVe[ip] = 2. * Me * nesheath * vesheath - NVe[i];
+      Ve[ip] = 2 * vesheath - Ve[i];
+      NVe[ip] = 2. * Me * nesheath * vesheath - NVe[i];
 
-        // Take into account the flow of energy due to fluid flow
-        // This is additional energy flux through the sheath
-        // Note: Here this is positive because vesheath > 0
-        BoutReal q = ((gamma_e - 2.5) * tesheath
-                      - 0.5 * Me * SQ(vesheath))
-                     * nesheath * vesheath;
+      // Take into account the flow of energy due to fluid flow
+      // This is additional energy flux through the sheath
+      // Note: Here this is positive because vesheath > 0
+      BoutReal q = ((gamma_e - 2.5) * tesheath
+                    - 0.5 * Me * SQ(vesheath))
+                   * nesheath * vesheath;
 
-        // Multiply by cell area to get power
-        BoutReal flux = q * (coord->J[i] + coord->J[ip])
-                        / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[ip]));
+      // Multiply by cell area to get power
+      BoutReal flux = q * cell.area;
 
-        // Divide by volume of cell to get energy loss rate (> 0)
-        BoutReal power = flux / (coord->dy[i] * coord->J[i]);
+      // Divide by volume of cell to get energy loss rate (> 0)
+      BoutReal power = flux * cell.inv_volume;
 
-        electron_energy_source[i] -= power;
-      }
+      electron_energy_source[i] -= power;
+
+      // Total heat flow through the upper face of cell i (> 0)
+      electron_energy_flow[ip] += gamma_e * tesheath * nesheath * vesheath * cell.area
+                                  * coord->dx[i] * coord->dz[i];
     }
   }
 
   // Set electron density and temperature, now with boundary conditions
-  setBoundary(electrons["density"], fromFieldAligned(Ne));
-  setBoundary(electrons["temperature"], fromFieldAligned(Te));
-  setBoundary(electrons["pressure"], fromFieldAligned(Pe));
+  setBoundary(electrons["density"], Ne.scatter(Ne_field));
+  setBoundary(electrons["temperature"], Te.scatter(Te_field));
+  setBoundary(electrons["pressure"], Pe.scatter(Pe_field));
 
   // Set energy source (negative in cell next to sheath)
   // Note: electron_energy_source includes any sources previously set in other components
-  set(electrons["energy_source"], fromFieldAligned(electron_energy_source));
+  set(electrons["energy_source"],
+      electron_energy_source.scatter(electron_energy_source_field));
+
+  // Heat flow through the sheath, including previously set flows
+  set(electrons["energy_flow_ylow"],
+      electron_energy_flow.scatter(electron_energy_flow_field));
 
   if (IS_SET_NOBOUNDARY(electrons["velocity"])) {
-    setBoundary(electrons["velocity"], fromFieldAligned(Ve));
+    setBoundary(electrons["velocity"], Ve.scatter(Ve_field));
   }
   if (IS_SET_NOBOUNDARY(electrons["momentum"])) {
-    setBoundary(electrons["momentum"], fromFieldAligned(NVe));
+    setBoundary(electrons["momentum"], NVe.scatter(NVe_field));
   }
 
   if (always_set_phi or (state.isSection("fields") and state["fields"].isSet("phi"))) {
     // Set the potential, including boundary conditions
-    setBoundary(state["fields"]["phi"], fromFieldAligned(phi));
+    setBoundary(state["fields"]["phi"], phi.scatter(phi_field));
   }
 
   //////////////////////////////////////////////////////////////////
@@ -431,156 +444,170 @@ void SheathBoundarySimple::transform(Options& state) {
     const BoutReal Mi = get<BoutReal>(species["AA"]);
 
     // Density and temperature boundary conditions will be imposed (free)
-    Field3D Ni = toFieldAligned(floor(getNoBoundary<Field3D>(species["density"]), 0.0));
-    Field3D Ti = toFieldAligned(getNoBoundary<Field3D>(species["temperature"]));
-    Field3D Pi = species.isSet("pressure")
-      ? toFieldAligned(getNoBoundary<Field3D>(species["pressure"]))
-      : Ni * Ti;
+    const Field3D Ni_field = floor(getNoBoundary<Field3D>(species["density"]), 0.0);
+    const Field3D Ti_field = getNoBoundary<Field3D>(species["temperature"]);
+    const Field3D Pi_field = species.isSet("pressure")
+      ? getNoBoundary<Field3D>(species["pressure"])
+      : Ni_field * Ti_field;
 
     // Get the velocity and momentum
     // These will be modified at the boundaries
     // and then put back into the state
-    Field3D Vi = species.isSet("velocity")
-      ? toFieldAligned(getNoBoundary<Field3D>(species["velocity"]))
-      : zeroFrom(Ni);
-    Field3D NVi = species.isSet("momentum")
-      ? toFieldAligned(getNoBoundary<Field3D>(species["momentum"]))
-      : Mi * Ni * Vi;
+    const Field3D Vi_field = species.isSet("velocity")
+      ? getNoBoundary<Field3D>(species["velocity"])
+      : zeroFrom(Ni_field);
+    const Field3D NVi_field = species.isSet("momentum")
+      ? getNoBoundary<Field3D>(species["momentum"])
+      : Mi * Ni_field * Vi_field;
 
     // Energy source will be modified in the domain
-    Field3D energy_source = species.isSet("energy_source")
-      ? toFieldAligned(getNonFinal<Field3D>(species["energy_source"]))
-      : zeroFrom(Ni);
+    const Field3D energy_source_field = species.isSet("energy_source")
+      ? getNonFinal<Field3D>(species["energy_source"])
+      : zeroFrom(Ni_field);
+
+    BoundarySlice Ni(Ni_field), Ti(Ti_field), Pi(Pi_field);
+    BoundarySlice Vi(Vi_field), NVi(NVi_field);
+    BoundarySlice energy_source(energy_source_field);
+
+    const Field3D energy_flow_field = species.isSet("energy_flow_ylow")
+      ? getNonFinal<Field3D>(species["energy_flow_ylow"])
+      : zeroFrom(Ni_field);
+    BoundarySlice energy_flow(energy_flow_field);
 
     if (lower_y) {
-      for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(Ne, r.ind, mesh->ystart, jz);
-          auto ip = i.yp();
-          auto im = i.ym();
+      for (const auto& cell : wall.lower_target) {
+        auto i = cell.i;
+        auto ip = i.yp();
+        auto im = i.ym();
 
-          // Free gradient of log electron density and temperature
-          // This ensures that the guard cell values remain positive
-          // exp( 2*log(N[i]) - log(N[ip]) )
+        // Free gradient of log electron density and temperature
+        // This ensures that the guard cell values remain positive
+        // exp( 2*log(N[i]) - log(N[ip]) )
 
-          Ni[im] = limitFree(Ni[ip], Ni[i]);
-          Ti[im] = limitFree(Ti[ip], Ti[i]);
-          Pi[im] = limitFree(Pi[ip], Pi[i]);
+        Ni[im] = limitFree(Ni[ip], Ni[i]);
+        Ti[im] = limitFree(Ti[ip], Ti[i]);
+        Pi[im] = limitFree(Pi[ip], Pi[i]);
 
-          // Calculate sheath values at half-way points (cell edge)
-          const BoutReal nesheath = 0.5 * (Ne[im] + Ne[i]);
-          const BoutReal nisheath = 0.5 * (Ni[im] + Ni[i]);
-          const BoutReal tesheath =
-              floor(0.5 * (Te[im] + Te[i]), 1e-5); // electron temperature
-          const BoutReal tisheath =
-              floor(0.5 * (Ti[im] + Ti[i]), 1e-5); // ion temperature
+        // Calculate sheath values at half-way points (cell edge)
+        const BoutReal nesheath = 0.5 * (Ne[im] + Ne[i]);
+        const BoutReal nisheath = 0.5 * (Ni[im] + Ni[i]);
+        const BoutReal tesheath =
+            floor(0.5 * (Te[im] + Te[i]), 1e-5); // electron temperature
+        const BoutReal tisheath =
+            floor(0.5 * (Ti[im] + Ti[i]), 1e-5); // ion temperature
 
-          // Ion speed into sheath
-          BoutReal C_i_sq = (sheath_ion_polytropic * tisheath + Zi * tesheath) / Mi;
+        // Ion speed into sheath
+        BoutReal C_i_sq = (sheath_ion_polytropic * tisheath + Zi * tesheath) / Mi;
 
-          BoutReal visheath = -sqrt(C_i_sq); // Negative -> into sheath
+        BoutReal visheath = -sqrt(C_i_sq); // Negative -> into sheath
 
-          if (Vi[i] < visheath) {
-            visheath = Vi[i];
-          }
+        if (Vi[i] < visheath) {
+          visheath = Vi[i];
+        }
+
+        // Set boundary conditions on flows
+        Vi[im] = 2. * visheath - Vi[i];
+        NVi[im] = 2. * Mi * nisheath * visheath - NVi[i];
 
-          // Set boundary conditions on flows
-          Vi[im] = 2. * visheath - Vi[i];
-          NVi[im] = 2. * Mi * nisheath * visheath - NVi[i];
+        // Take into account the flow of energy due to fluid flow
+        // This is additional energy flux through the sheath
+        // Note: Here this is negative because visheath < 0
+        BoutReal q =
+            ((gamma_i - 2.5) * tisheath - 0.5 * Mi * C_i_sq)
+            * nisheath * visheath;
 
-          // Take into account the flow of energy due to fluid flow
-          // This is additional energy flux through the sheath
-          // Note: Here this is negative because visheath < 0
-          BoutReal q =
-              ((gamma_i - 2.5) * tisheath - 0.5 * Mi * C_i_sq)
-              * nisheath * visheath;
+        // Multiply by cell area to get power
+        BoutReal flux = q * cell.area;
 
-          // Multiply by cell area to get power
-          BoutReal flux = q * (coord->J[i] + coord->J[im])
-                          / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[im]));
+        // Divide by volume of cell to get energy loss rate (< 0)
+        BoutReal power = flux * cell.inv_volume;
 
-          // Divide by volume of cell to get energy loss rate (< 0)
-          BoutReal power = flux / (coord->dy[i] * coord->J[i]);
+        energy_source[i] += power;
 
-          energy_source[i] += power;
-        }
+        // Total heat flow through the lower face of cell i (< 0)
+        energy_flow[i] += gamma_i * tisheath * nisheath * visheath * cell.area
+                          * coord->dx[i] * coord->dz[i];
       }
     }
     if (upper_y) {
       // Note: This is essentially the same as the lower boundary,
       // but with directions reversed e.g. ystart -> yend, ip <-> im
       //
-      for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
-        for (int jz = 0; jz < mesh->LocalNz; jz++) {
-          auto i = indexAt(Ne, r.ind, mesh->yend, jz);
-          auto ip = i.yp();
-          auto im = i.ym();
+      for (const auto& cell : wall.upper_target) {
+        auto i = cell.i;
+        auto ip = i.yp();
+        auto im = i.ym();
 
-          // Free gradient of log electron density and temperature
-          // This ensures that the guard cell values remain positive
-          // exp( 2*log(N[i]) - log(N[ip]) )
+        // Free gradient of log electron density and temperature
+        // This ensures that the guard cell values remain positive
+        // exp( 2*log(N[i]) - log(N[ip]) )
 
-          Ni[ip] = limitFree(Ni[im], Ni[i]);
-          Ti[ip] = limitFree(Ti[im], Ti[i]);
-          Pi[ip] = limitFree(Pi[im], Pi[i]);
+        Ni[ip] = limitFree(Ni[im], Ni[i]);
+        Ti[ip] = limitFree(Ti[im], Ti[i]);
+        Pi[ip] = limitFree(Pi[im], Pi[i]);
 
-          // Calculate sheath values at half-way points (cell edge)
-          const BoutReal nesheath = 0.5 * (Ne[ip] + Ne[i]);
-          const BoutReal nisheath = 0.5 * (Ni[ip] + Ni[i]);
-          const BoutReal tesheath =
-              floor(0.5 * (Te[ip] + Te[i]), 1e-5); // electron temperature
-          const BoutReal tisheath =
-              floor(0.5 * (Ti[ip] + Ti[i]), 1e-5); // ion temperature
+        // Calculate sheath values at half-way points (cell edge)
+        const BoutReal nesheath = 0.5 * (Ne[ip] + Ne[i]);
+        const BoutReal nisheath = 0.5 * (Ni[ip] + Ni[i]);
+        const BoutReal tesheath =
+            floor(0.5 * (Te[ip] + Te[i]), 1e-5); // electron temperature
+        const BoutReal tisheath =
+            floor(0.5 * (Ti[ip] + Ti[i]), 1e-5); // ion temperature
 
-          // Ion speed into sheath
-          BoutReal C_i_sq = (sheath_ion_polytropic * tisheath + Zi * tesheath) / Mi;
+        // Ion speed into sheath
+        BoutReal C_i_sq = (sheath_ion_polytropic * tisheath + Zi * tesheath) / Mi;
+
+        BoutReal visheath = sqrt(C_i_sq); // Positive -> into sheath
 
-          BoutReal visheath = sqrt(C_i_sq); // Positive -> into sheath
+        if (Vi[i] > visheath) {
+          visheath = Vi[i];
+        }
 
-          if (Vi[i] > visheath) {
-            visheath = Vi[i];
-          }
+        // Set boundary conditions on flows
+        Vi[ip] = 2. * visheath - Vi[i];
+        NVi[ip] = 2. * Mi * nisheath * visheath - NVi[i];
 
-          // Set boundary conditions on flows
-          Vi[ip] = 2. * visheath - Vi[i];
-          NVi[ip] = 2. * Mi * nisheath * visheath - NVi[i];
+        // Take into account the flow of energy due to fluid flow
+        // This is additional energy flux through the sheath
+        // Note: Here this is positive because visheath > 0
+        BoutReal q =
+            ((gamma_i - 2.5) * tisheath - 0.5 * C_i_sq * Mi)
+            * nisheath * visheath;
 
-          // Take into account the flow of energy due to fluid flow
-          // This is additional energy flux through the sheath
-          // Note: Here this is positive because visheath > 0
-          BoutReal q =
-              ((gamma_i - 2.5) * tisheath - 0.5 * C_i_sq * Mi)
-              * nisheath * visheath;
+        // Multiply by cell area to get power
+        BoutReal flux = q * cell.area;
 
-          // Multiply by cell area to get power
-          BoutReal flux = q * (coord->J[i] + coord->J[ip])
-                          / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[ip]));
+        // Divide by volume of cell to get energy loss rate (> 0)
+        BoutReal power = flux * cell.inv_volume;
+        ASSERT2(std::isfinite(power));
 
-          // Divide by volume of cell to get energy loss rate (> 0)
-          BoutReal power = flux / (coord->dy[i] * coord->J[i]);
-          ASSERT2(std::isfinite(power));
+        energy_source[i] -= power; // Note: Sign negative because power > 0
 
-          energy_source[i] -= power; // Note: Sign negative because power > 0
-        }
+        // Total heat flow through the upper face of cell i (> 0)
+        energy_flow[ip] += gamma_i * tisheath * nisheath * visheath * cell.area
+                           * coord->dx[i] * coord->dz[i];
       }
     }
 
     // Finished boundary conditions for this species
     // Put the modified fields back into the state.
-    setBoundary(species["density"], fromFieldAligned(Ni));
-    setBoundary(species["temperature"], fromFieldAligned(Ti));
-    setBoundary(species["pressure"], fromFieldAligned(Pi));
+    setBoundary(species["density"], Ni.scatter(Ni_field));
+    setBoundary(species["temperature"], Ti.scatter(Ti_field));
+    setBoundary(species["pressure"], Pi.scatter(Pi_field));
 
     if (species.isSet("velocity")) {
-      setBoundary(species["velocity"], fromFieldAligned(Vi));
+      setBoundary(species["velocity"], Vi.scatter(Vi_field));
     }
 
     if (species.isSet("momentum")) {
-      setBoundary(species["momentum"], fromFieldAligned(NVi));
+      setBoundary(species["momentum"], NVi.scatter(NVi_field));
     }
 
     // Additional loss of energy through sheath
     // Note: energy_source already includes previously set values
-    set(species["energy_source"], fromFieldAligned(energy_source));
+    set(species["energy_source"], energy_source.scatter(energy_source_field));
+
+    // Heat flow through the sheath, including previously set flows
+    set(species["energy_flow_ylow"], energy_flow.scatter(energy_flow_field));
   }
 }
@@ -4,6 +4,20 @@
 #include <bout/bout.hxx>
 using bout::globals::mesh;
 
+namespace {
+/// Replace the parallel cell lengths in the coordinates, restoring
+/// the original values when going out of scope
+struct SwapDy {
+  SwapDy(Coordinates* coord, const Field2D& dy) : coord(coord), dy_orig(coord->dy) {
+    coord->dy = dy;
+  }
+  ~SwapDy() { coord->dy = dy_orig; }
+
+  Coordinates* coord;
+  Field2D dy_orig;
+};
+} // namespace
+
 void SNBConduction::transform(Options& state) {
   auto units = state["units"];
   const auto rho_s0 = get<BoutReal>(units["meters"]);
@@ -16,20 +30,31 @@ void SNBConduction::transform(Options& state) {
   const Field3D Te = GET_VALUE(Field3D, electrons["temperature"]) * Tnorm; // eV
   const Field3D Ne = GET_VALUE(Field3D, electrons["density"]) * Nnorm;     // In m^-3
 
-  // SNB non-local heat flux. Also returns the Spitzer-Harm value for comparison
-  // Note: Te in eV, Ne in Nnorm
-  Field2D dy_orig = mesh->getCoordinates()->dy;
-  mesh->getCoordinates()->dy *= rho_s0; // Convert distances to m
+  Coordinates* coord = mesh->getCoordinates();
+  if (rho_s0 != dy_SI_rho_s0) {
+    // Parallel cell lengths in metres. These are reused between calls
+    // rather than being recalculated every time.
+    dy_SI = coord->dy * rho_s0;
+    dy_SI_rho_s0 = rho_s0;
+  }
 
-  // Inputs in eV and m^-3
-  Div_Q_SNB = snb.divHeatFlux(Te, Ne, &Div_Q_SH);
+  // The Spitzer-Harm value is only needed for output
+  const bool diagnose_now = diagnose and isOutputStep(state);
 
-  // Restore the metric tensor
-  mesh->getCoordinates()->dy = dy_orig;
+  {
+    // Use distances in m while calculating the SNB heat flux
+    SwapDy swap(coord, dy_SI);
+
+    // SNB non-local heat flux. Also returns the Spitzer-Harm value for comparison
+    // Inputs in eV and m^-3
+    Div_Q_SNB = snb.divHeatFlux(Te, Ne, diagnose_now ? &Div_Q_SH : nullptr);
+  }
 
   // Normalise from eV/m^3/s
   Div_Q_SNB /= Tnorm * Nnorm * Omega_ci;
-  Div_Q_SH /= Tnorm * Nnorm * Omega_ci;
+  if (diagnose_now) {
+    Div_Q_SH /= Tnorm * Nnorm * Omega_ci;
+  }
 
   // Divergence of heat flux appears with a minus sign in energy source:
   //
@@ -5,6 +5,7 @@
 #include <bout/constants.hxx>
 #include <bout/fv_ops.hxx>
 #include <bout/invert/laplacexy.hxx>
+#include <bout/invert_pardiv.hxx>
 #include <bout/derivs.hxx>
 #include <bout/difops.hxx>
 #include <bout/invert_laplace.hxx>
@@ -51,7 +52,8 @@ BoutReal limitFree(BoutReal fm, BoutReal fc) {
 }
 }
 
-Vorticity::Vorticity(std::string name, Options& alloptions, Solver* solver) {
+Vorticity::Vorticity(std::string name, Options& alloptions, Solver* solver)
+    : name(name) {
   AUTO_TRACE();
 
   solver->add(Vort, "Vort");
@@ -125,6 +127,10 @@ Vorticity::Vorticity(std::string name, Options& alloptions, Solver* solver) {
                         .doc("Parallel dissipation of potential [Recommended]")
                         .withDefault<bool>(true);
 
+  phi_warm_start = options["phi_warm_start"]
+                       .doc("Use the previous solution as initial guess for phi solve?")
+                       .withDefault<bool>(true);
+
   phi_boundary_relax = options["phi_boundary_relax"]
                            .doc("Relax x boundaries of phi towards Neumann?")
                            .withDefault<bool>(false);
@@ -137,6 +143,10 @@ Vorticity::Vorticity(std::string name, Options& alloptions, Solver* solver) {
 	  .doc("Damp vorticity at the core boundary?")
 	  .withDefault<bool>(false);
 
+  enable_precon = options["precondition"]
+                      .doc("Enable preconditioner? (Note: solver may not use it)")
+                      .withDefault<bool>(false);
+
   // Add phi to restart files so that the value in the boundaries
   // is restored on restart. This is done even when phi is not evolving,
   // so that phi can be saved and re-loaded
@@ -414,10 +424,22 @@ void Vorticity::transform(Options& state) {
     }
   }
 
+  if (phi_warm_start and phi_plus_pi_last.isAllocated()) {
+    // Iterative solvers use the domain values as the initial guess.
+    // Start from the previous solution of phi + Pi_hat rather than
+    // the previous phi plus the new Pi_hat.
+    // The boundary values set above are kept.
+    BOUT_FOR(i, phi_plus_pi.getRegion("RGN_NOBNDRY")) {
+      phi_plus_pi[i] = phi_plus_pi_last[i];
+    }
+  }
+
   // Calculate potential
   if (split_n0) {
     ////////////////////////////////////////////
     // Split into axisymmetric and non-axisymmetric components
+    // The initial guess for each solver is the corresponding
+    // component of phi_plus_pi
     Field2D Vort2D = DC(Vort); // n=0 component
     Field2D phi_plus_pi_2d = DC(phi_plus_pi);
     phi_plus_pi -= phi_plus_pi_2d;
@@ -425,13 +447,14 @@ void Vorticity::transform(Options& state) {
     phi_plus_pi_2d = laplacexy->solve(Vort2D, phi_plus_pi_2d);
 
     // Solve non-axisymmetric part using X-Z solver
-    phi = phi_plus_pi_2d
-          + phiSolver->solve((Vort - Vort2D) * (Bsq / average_atomic_mass), phi_plus_pi)
-          - Pi_hat;
+    phi_plus_pi_last =
+        phi_plus_pi_2d
+        + phiSolver->solve((Vort - Vort2D) * (Bsq / average_atomic_mass), phi_plus_pi);
 
   } else {
-    phi = phiSolver->solve(Vort * (Bsq / average_atomic_mass), phi_plus_pi) - Pi_hat;
+    phi_plus_pi_last = phiSolver->solve(Vort * (Bsq / average_atomic_mass), phi_plus_pi);
   }
+  phi = phi_plus_pi_last - Pi_hat;
 
   // Ensure that potential is set in the communication guard cells
   mesh->communicate(phi);
@@ -735,6 +758,77 @@ void Vorticity::finally(const Options& state) {
   }
 }
 
+void Vorticity::precon(const Options& state, BoutReal gamma) {
+  if (!(enable_precon and (vort_dissipation or phi_dissipation or phi_sheath_dissipation))) {
+    return; // Disabled
+  }
+
+  if (!parallel_inv) {
+    // Initialise parallel inversion class
+    parallel_inv = InvertParDiv::create();
+    parallel_inv->setCoefA(1.0);
+  }
+
+  auto* coord = mesh->getCoordinates();
+
+  // The phi solve is approximated by phi ~ -(B^2 / A) Vort / k_perp^2
+  // with k_perp the largest wavenumber resolved on the grid. These are
+  // the structures that the dissipation terms are intended to damp.
+  const Field2D kperp_sq = coord->g11 * SQ(PI / coord->dx) + coord->g33 * SQ(PI / coord->dz);
+  const Field2D phi_factor = Bsq / (average_atomic_mass * kperp_sq);
+
+  Field3D scale = 1.0;
+  if (state.isSet("scale_timederivs")) {
+    scale = get<Field3D>(state["scale_timederivs"]);
+  }
+
+  if (vort_dissipation or phi_dissipation) {
+    // The Lax flux in FV::Div_par acts like a parallel diffusion with
+    // coefficient 0.5 * sound_speed * parallel cell length
+    const Field3D sound_speed = get<Field3D>(state["sound_speed"]);
+    Field3D coef = 0.5 * sound_speed * coord->dy * sqrt(coord->g_22);
+    if (vort_dissipation and phi_dissipation) {
+      coef *= 1.0 + phi_factor;
+    } else if (phi_dissipation) {
+      coef *= phi_factor;
+    }
+
+    // Set the coefficient in Div_par( B * Grad_par )
+    parallel_inv->setCoefB(-gamma * coef * scale);
+    Field3D dVort = ddt(Vort);
+    dVort.applyBoundary("neumann");
+    ddt(Vort) = parallel_inv->solve(dVort);
+  }
+
+  if (phi_sheath_dissipation) {
+    // Sheath dissipation is local, so invert it cell by cell where it is active
+    auto phi_fa = toFieldAligned(phi);
+    auto dVort_fa = toFieldAligned(ddt(Vort));
+    auto scale_fa = toFieldAligned(scale);
+    for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
+      for (int jz = 0; jz < mesh->LocalNz; jz++) {
+        auto i = indexAt(phi_fa, r.ind, mesh->ystart, jz);
+        if (phi_fa[i] + phi_fa[i.ym()] < 0.0) {
+          dVort_fa[i] /= 1.0 + gamma * scale_fa[i] * phi_factor(r.ind, mesh->ystart);
+        }
+      }
+    }
+    for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
+      for (int jz = 0; jz < mesh->LocalNz; jz++) {
+        auto i = indexAt(phi_fa, r.ind, mesh->yend, jz);
+        if (phi_fa[i] + phi_fa[i.yp()] < 0.0) {
+          dVort_fa[i] /= 1.0 + gamma * scale_fa[i] * phi_factor(r.ind, mesh->yend);
+        }
+      }
+    }
+    ddt(Vort) = fromFieldAligned(dVort_fa);
+  }
+}
+
+void Vorticity::timeDerivs(Options& ddts) {
+  ddts["Vort"] = ddt(Vort);
+}
+
 void Vorticity::outputVars(Options& state) {
   AUTO_TRACE();
   // Normalisations
@@ -782,3 +876,43 @@ void Vorticity::outputVars(Options& state) {
     }
   }
 }
+
+void Vorticity::saveState(Options& restart) {
+  AUTO_TRACE();
+
+  // Copy, since the boundary cells of phi are modified in place
+  set_with_attrs(restart["phi"], copy(phi),
+                 {{"long_name", "plasma potential"},
+                  {"source", "vorticity"}});
+
+  Options& state = restart["state"][name];
+  if (phi_boundary_relax) {
+    set_with_attrs(state["phi_boundary_last_update"], phi_boundary_last_update,
+                   {{"long_name", "Time of last potential boundary relaxation"},
+                    {"source", "vorticity"}});
+  }
+
+  if (phi_warm_start and phi_plus_pi_last.isAllocated()) {
+    set_with_attrs(state["phi_plus_pi_last"], phi_plus_pi_last,
+                   {{"long_name", "Previous potential solution including ion pressure"},
+                    {"source", "vorticity"}});
+  }
+}
+
+void Vorticity::loadState(const Options& restart) {
+  AUTO_TRACE();
+
+  if (restart.isSet("phi")) {
+    phi = restart["phi"].as<Field3D>();
+  }
+  if (!(restart.isSection("state") and restart["state"].isSection(name))) {
+    return; // Older restart file, or interpolated from a different mesh
+  }
+  const Options& state = restart["state"][name];
+  if (state.isSet("phi_boundary_last_update")) {
+    phi_boundary_last_update = state["phi_boundary_last_update"].as<BoutReal>();
+  }
+  if (phi_warm_start and state.isSet("phi_plus_pi_last")) {
+    phi_plus_pi_last = state["phi_plus_pi_last"].as<Field3D>();
+  }
+}
@@ -0,0 +1,78 @@
+#include "../include/wall_boundary.hxx"
+
+#include <bout/coordinates.hxx>
+#include <bout/mesh.hxx>
+
+namespace {
+/// Target (Y) boundary cell
+WallCell targetCell(Coordinates* coord, const Ind3D& i, int direction) {
+  const Ind3D guard = (direction > 0) ? i.yp() : i.ym();
+  const Ind3D inner = (direction > 0) ? i.ym() : i.yp();
+
+  return {i, guard, inner, direction,
+          (coord->J[i] + coord->J[guard])
+              / (sqrt(coord->g_22[i]) + sqrt(coord->g_22[guard])),
+          1. / (coord->J[i] * coord->dy[i]),
+          false};
+}
+
+/// Radial (X) wall cell
+WallCell wallCell(Coordinates* coord, const Ind3D& i, int direction, bool pump) {
+  const Ind3D guard = (direction > 0) ? i.xp() : i.xm();
+  const Ind3D inner = (direction > 0) ? i.xm() : i.xp();
+
+  // Converts dy to poloidal length: dl = dy * sqrt(g22) = dy * h_theta
+  const BoutReal dpol = 0.5 * (coord->dy[i] + coord->dy[guard])
+                        / (0.5 * (sqrt(coord->g22[i]) + sqrt(coord->g22[guard])));
+
+  // Converts dz to toroidal length:  = dz*sqrt(g_33) = dz * R = 2piR
+  const BoutReal dtor = 0.5 * (coord->dz[i] + coord->dz[guard]) * 0.5
+                        * (sqrt(coord->g_33[i]) + sqrt(coord->g_33[guard]));
+
+  return {i, guard, inner, direction,
+          dpol * dtor, // [m^2]
+          1. / (coord->J[i] * coord->dx[i] * coord->dy[i] * coord->dz[i]),
+          pump};
+}
+} // namespace
+
+WallBoundary::WallBoundary(Mesh* mesh) : WallBoundary(mesh, Field2D(0.0, mesh)) {}
+
+WallBoundary::WallBoundary(Mesh* mesh, const Field2D& is_pump) {
+  Coordinates* coord = mesh->getCoordinates();
+  const int ny = mesh->LocalNy;
+  const int nz = mesh->LocalNz;
+  auto indexAt = [&](int x, int y, int z) { return Ind3D{(x * ny + y) * nz + z, ny, nz}; };
+
+  for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
+    for (int jz = 0; jz < nz; jz++) {
+      lower_target.push_back(targetCell(coord, indexAt(r.ind, mesh->ystart, jz), -1));
+    }
+  }
+
+  for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
+    for (int jz = 0; jz < nz; jz++) {
+      upper_target.push_back(targetCell(coord, indexAt(r.ind, mesh->yend, jz), 1));
+    }
+  }
+
+  if (mesh->lastX()) {
+    // Only the processor which has the SOL edge
+    for (int iy = 0; iy < ny; iy++) {
+      for (int iz = 0; iz < nz; iz++) {
+        sol.push_back(wallCell(coord, indexAt(mesh->xend, iy, iz), 1,
+                               is_pump(mesh->xend, iy) == 1.0));
+      }
+    }
+  }
+
+  if (mesh->firstX() and !mesh->periodicY(mesh->xstart)) {
+    // Inner edge and not periodic, i.e. PFR
+    for (int iy = 0; iy < ny; iy++) {
+      for (int iz = 0; iz < nz; iz++) {
+        pfr.push_back(wallCell(coord, indexAt(mesh->xstart, iy, iz), -1,
+                               is_pump(mesh->xstart, iy) == 1.0));
+      }
+    }
+  }
+}
@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh
+
+#include "../../include/async_writer.hxx"
+
+#include <bout/options_netcdf.hxx>
+
+#include <filesystem>
+#include <string>
+#include <unistd.h> // For getpid
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+// Reuse the "standard" fixture for FakeMesh
+using AsyncWriterTest = FakeMeshFixture;
+
+TEST_F(AsyncWriterTest, DeepCopyField) {
+  Field3D f{1.0, mesh};
+
+  Options options;
+  options["section"]["f"] = f;
+  options["section"]["f"].attributes["time_dimension"] = "t";
+  options["value"] = 3;
+
+  Options result = deepCopy(options);
+
+  // Changing the original field doesn't change the copy
+  f = 2.0;
+
+  const Field3D g = result["section"]["f"].as<Field3D>();
+  BOUT_FOR_SERIAL(i, g.getRegion("RGN_ALL")) {
+    ASSERT_DOUBLE_EQ(g[i], 1.0);
+  }
+  ASSERT_EQ(result["section"]["f"].attributes["time_dimension"].as<std::string>(), "t");
+  ASSERT_EQ(result["value"].as<int>(), 3);
+}
+
+namespace {
+/// A file in the temporary directory, removed when destroyed
+struct TemporaryFile {
+  TemporaryFile() : name((std::filesystem::temp_directory_path()
+                          / ("hermes_test_async_writer_" + std::to_string(getpid()) + ".nc"))
+                             .string()) {}
+  ~TemporaryFile() { std::filesystem::remove(name); }
+  std::string name;
+};
+
+/// Output with time-dependent and constant values
+Options snapshot(int index) {
+  Options options;
+  options["t_array"] = static_cast<BoutReal>(index);
+  options["t_array"].attributes["time_dimension"] = "t";
+  options["value"] = 3;
+  return options;
+}
+} // namespace
+
+TEST_F(AsyncWriterTest, WriteMoreThanQueue) {
+  TemporaryFile file;
+  constexpr int nsnapshots = 5;
+  {
+    AsyncWriter writer(file.name, false, 2);
+    // More snapshots than max_queue, so push() waits for space
+    for (int i = 0; i < nsnapshots; ++i) {
+      writer.push(snapshot(i));
+    }
+    writer.wait();
+  }
+
+  Options data = bout::OptionsNetCDF(file.name).read();
+  const auto times = data["t_array"].as<Array<BoutReal>>();
+  ASSERT_EQ(times.size(), nsnapshots);
+  for (int i = 0; i < nsnapshots; ++i) {
+    EXPECT_DOUBLE_EQ(times[i], i);
+  }
+  EXPECT_EQ(data["value"].as<int>(), 3);
+}
+
+TEST_F(AsyncWriterTest, DestructorWritesQueue) {
+  TemporaryFile file;
+  {
+    AsyncWriter writer(file.name, false, 4);
+    writer.push(snapshot(0));
+    writer.push(snapshot(1));
+    // No wait()
+  }
+
+  Options data = bout::OptionsNetCDF(file.name).read();
+  ASSERT_EQ(data["t_array"].as<Array<BoutReal>>().size(), 2);
+}
+
+TEST_F(AsyncWriterTest, Append) {
+  TemporaryFile file;
+  {
+    AsyncWriter writer(file.name, false, 1);
+    writer.push(snapshot(0));
+  }
+  {
+    AsyncWriter writer(file.name, true, 1);
+    writer.push(snapshot(1));
+  }
+
+  Options data = bout::OptionsNetCDF(file.name).read();
+  const auto times = data["t_array"].as<Array<BoutReal>>();
+  ASSERT_EQ(times.size(), 2);
+  EXPECT_DOUBLE_EQ(times[1], 1.0);
+}
+
+TEST_F(AsyncWriterTest, RethrowError) {
+  // Directory doesn't exist, so the file can't be created
+  AsyncWriter writer("/nonexistent_hermes_test_directory/output.nc", false, 1);
+  writer.push(snapshot(0));
+  EXPECT_ANY_THROW(writer.wait());
+
+  // The error is only thrown once
+  EXPECT_NO_THROW(writer.wait());
+}
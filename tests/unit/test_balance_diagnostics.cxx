@@ -0,0 +1,104 @@
+
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh
+
+#include "../../include/balance_diagnostics.hxx"
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+// Mesh with targets, and SOL and PFR walls
+using BalanceDiagnosticsTest = OpenYFakeMeshFixture;
+
+TEST_F(BalanceDiagnosticsTest, CreateComponent) {
+  Options options;
+  BalanceDiagnostics component("balance", options, nullptr);
+}
+
+TEST_F(BalanceDiagnosticsTest, SourcesAndTargetFlows) {
+  Options options;
+  options["balance"]["species"] = "d+";
+  BalanceDiagnostics component("balance", options, nullptr);
+
+  Options state;
+  state["species"]["d+"]["density_source"] = Field3D(1.0);
+  state["species"]["d+"]["energy_source"] = Field3D(2.0);
+  state["species"]["d+"]["density"] = Field3D(2.0);
+  state["species"]["d+"]["velocity"] = Field3D(3.0);
+  state["species"]["d+"]["energy_flow_ylow"] = Field3D(4.0);
+  // Not in the species list
+  state["species"]["e"]["density_source"] = Field3D(1.0);
+
+  component.transform(state);
+
+  Options output;
+  output["Nnorm"] = 1.0;
+  output["Tnorm"] = 1.0;
+  output["Omega_ci"] = 1.0;
+  output["rho_s0"] = 1.0;
+  component.outputVars(output);
+
+  // All metrics are 1, so cell volumes and target areas are 1
+  const BoutReal ncells = (mesh->xend - mesh->xstart + 1)
+                          * (mesh->yend - mesh->ystart + 1) * mesh->LocalNz;
+  EXPECT_DOUBLE_EQ(output["Sd+_int"].as<BoutReal>(), ncells);
+  EXPECT_DOUBLE_EQ(output["Ed+_int"].as<BoutReal>(), 2 * ncells);
+  EXPECT_FALSE(output.isSet("Se_int"));
+
+  // Cells next to each boundary. SOL and PFR exclude the Y guard cells
+  const WallBoundary wall(mesh);
+  const BoutReal nlower = wall.lower_target.size();
+  const BoutReal nupper = wall.upper_target.size();
+  const BoutReal nwall = (mesh->yend - mesh->ystart + 1) * mesh->LocalNz;
+  EXPECT_GT(nlower, 0);
+  EXPECT_DOUBLE_EQ(output["Sd+_lower_target_int"].as<BoutReal>(), nlower);
+  EXPECT_DOUBLE_EQ(output["Sd+_upper_target_int"].as<BoutReal>(), nupper);
+  EXPECT_DOUBLE_EQ(output["Sd+_sol_int"].as<BoutReal>(), nwall);
+  EXPECT_DOUBLE_EQ(output["Sd+_pfr_int"].as<BoutReal>(), nwall);
+  EXPECT_DOUBLE_EQ(output["Ed+_pfr_int"].as<BoutReal>(), 2 * nwall);
+
+  // Flow N * V = 6 in the positive Y direction is into the upper
+  // target and out of the lower target
+  EXPECT_DOUBLE_EQ(output["Fd+_lower_target"].as<BoutReal>(), -6 * nlower);
+  EXPECT_DOUBLE_EQ(output["Fd+_upper_target"].as<BoutReal>(), 6 * nupper);
+
+  // Energy flow in the positive Y direction
+  EXPECT_DOUBLE_EQ(output["Qd+_lower_target"].as<BoutReal>(), -4 * nlower);
+  EXPECT_DOUBLE_EQ(output["Qd+_upper_target"].as<BoutReal>(), 4 * nupper);
+
+  // No radial flows set
+  EXPECT_FALSE(output.isSet("Fd+_sol"));
+}
+
+TEST_F(BalanceDiagnosticsTest, WallFlows) {
+  Options options;
+  BalanceDiagnostics component("balance", options, nullptr);
+
+  Options state;
+  state["species"]["d"]["particle_flow_xlow"] = Field3D(1.0);
+  state["species"]["d"]["energy_flow_xlow"] = Field3D(2.0);
+
+  component.transform(state);
+
+  Options output;
+  output["Nnorm"] = 1.0;
+  output["Tnorm"] = 1.0;
+  output["Omega_ci"] = 1.0;
+  output["rho_s0"] = 1.0;
+  component.outputVars(output);
+
+  // Flows in the positive X direction: Into the SOL wall, out of the PFR wall
+  const BoutReal nwall = (mesh->yend - mesh->ystart + 1) * mesh->LocalNz;
+  EXPECT_DOUBLE_EQ(output["Fd_sol"].as<BoutReal>(), nwall);
+  EXPECT_DOUBLE_EQ(output["Fd_pfr"].as<BoutReal>(), -nwall);
+  EXPECT_DOUBLE_EQ(output["Qd_sol"].as<BoutReal>(), 2 * nwall);
+  EXPECT_DOUBLE_EQ(output["Qd_pfr"].as<BoutReal>(), -2 * nwall);
+}
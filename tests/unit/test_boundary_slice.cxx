@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh
+
+#include "../../include/boundary_slice.hxx"
+#include "../../include/hermes_utils.hxx" // For indexAt
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+#include <bout/field_factory.hxx>  // For generating functions
+
+// Reuse the "standard" fixture for FakeMesh
+using BoundarySliceTest = FakeMeshFixture;
+
+TEST_F(BoundarySliceTest, ScatterUnchanged) {
+  Options options;
+  Field3D f = FieldFactory::get()->create3D("1 + x + y + z", &options, mesh);
+
+  BoundarySlice slice(f);
+  Field3D result = slice.scatter(f);
+
+  BOUT_FOR_SERIAL(i, result.getRegion("RGN_ALL")) {
+    ASSERT_DOUBLE_EQ(f[i], result[i]);
+  }
+}
+
+TEST_F(BoundarySliceTest, ReadBoundaryValues) {
+  Options options;
+  Field3D f = FieldFactory::get()->create3D("1 + x + y + z", &options, mesh);
+
+  const BoundarySlice slice(f);
+
+  for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
+    for (int jz = 0; jz < mesh->LocalNz; jz++) {
+      for (int y = mesh->ystart - 1; y <= mesh->ystart + 1; y++) {
+        ASSERT_DOUBLE_EQ(f(r.ind, y, jz), slice[indexAt(f, r.ind, y, jz)]);
+      }
+    }
+  }
+}
+
+TEST_F(BoundarySliceTest, SetGuardCells) {
+  Options options;
+  Field3D f = FieldFactory::get()->create3D("1 + x + y + z", &options, mesh);
+
+  BoundarySlice slice(f);
+  for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
+    for (int jz = 0; jz < mesh->LocalNz; jz++) {
+      slice[indexAt(f, r.ind, mesh->yend + 1, jz)] = -2.0;
+    }
+  }
+  Field3D result = slice.scatter(f);
+
+  BOUT_FOR_SERIAL(i, result.getRegion("RGN_ALL")) {
+    if ((i.y() == mesh->yend + 1) and (i.x() >= mesh->xstart) and (i.x() <= mesh->xend)) {
+      ASSERT_DOUBLE_EQ(-2.0, result[i]);
+    } else {
+      ASSERT_DOUBLE_EQ(f[i], result[i]);
+    }
+  }
+}
@@ -164,3 +164,78 @@ TEST_F(CollisionsTest, TnormDependence) {
   ASSERT_FLOAT_EQ(get<Field3D>(state["species"]["d+"]["collision_frequency"])(0,0,0),
                   get<Field3D>(state2["species"]["d+"]["collision_frequency"])(0,0,0));
 }
+
+TEST_F(CollisionsTest, MomentumEnergyConservation) {
+  Options options {{"units", {{"eV", 1.0},
+                              {"meters", 1.0},
+                              {"seconds", 1.0},
+                              {"inv_meters_cubed", 1.0}}},
+                   {"test", {{"frictional_heating", false}}}};
+
+  Collisions component("test", options, nullptr);
+
+  Options state {{"species", {{"d+", {{"density", 2e19},
+                                      {"temperature", 20},
+                                      {"velocity", 1.0},
+                                      {"charge", 1},
+                                      {"AA", 2}}},
+                              {"he+", {{"density", 1e19},
+                                       {"temperature", 5},
+                                       {"velocity", -1.0},
+                                       {"charge", 1},
+                                       {"AA", 4}}}}}};
+
+  component.transform(state);
+
+  // Momentum and energy exchanged between species sum to zero
+  Field3D mom_d = get<Field3D>(state["species"]["d+"]["momentum_source"]);
+  Field3D mom_he = get<Field3D>(state["species"]["he+"]["momentum_source"]);
+  Field3D energy_d = get<Field3D>(state["species"]["d+"]["energy_source"]);
+  Field3D energy_he = get<Field3D>(state["species"]["he+"]["energy_source"]);
+
+  ASSERT_LT(mom_d(0, 0, 0), 0.0);  // Slowed down
+  ASSERT_LT(energy_d(0, 0, 0), 0.0); // Hotter species cools
+  ASSERT_NEAR(mom_d(0, 0, 0) + mom_he(0, 0, 0), 0.0, 1e-10 * std::abs(mom_d(0, 0, 0)));
+  ASSERT_NEAR(energy_d(0, 0, 0) + energy_he(0, 0, 0), 0.0,
+              1e-10 * std::abs(energy_d(0, 0, 0)));
+}
+
+TEST_F(CollisionsTest, PairwiseRates) {
+  Options options {{"units", {{"eV", 1.0},
+                              {"meters", 1.0},
+                              {"seconds", 1.0},
+                              {"inv_meters_cubed", 1.0}}},
+                   {"test", {{"pairwise_rates", "d+:d"}}}};
+
+  Collisions component("test", options, nullptr);
+
+  Options state {{"species", {{"d+", {{"density", 2e19},
+                                      {"temperature", 20},
+                                      {"charge", 1},
+                                      {"AA", 2}}},
+                              {"d", {{"density", 1e18},
+                                     {"temperature", 3},
+                                     {"AA", 2}}}}}};
+
+  component.transform(state);
+
+  // Only the requested pair is set
+  ASSERT_TRUE(state["species"]["d+"]["collision_frequencies"].isSet("d"));
+  ASSERT_FALSE(state["species"]["d"].isSection("collision_frequencies"));
+
+  // Total frequency also includes d+ - d+ collisions
+  const BoutReal nu_pair =
+      get<Field3D>(state["species"]["d+"]["collision_frequencies"]["d"])(0, 0, 0);
+  ASSERT_GT(nu_pair, 0.0);
+  ASSERT_LT(nu_pair, get<Field3D>(state["species"]["d+"]["collision_frequency"])(0, 0, 0));
+}
+
+TEST_F(CollisionsTest, MalformedPairwiseRates) {
+  Options options {{"units", {{"eV", 1.0},
+                              {"meters", 1.0},
+                              {"seconds", 1.0},
+                              {"inv_meters_cubed", 1.0}}},
+                   {"test", {{"pairwise_rates", "d+"}}}};
+
+  ASSERT_THROW(Collisions component("test", options, nullptr), BoutException);
+}
@@ -139,3 +139,15 @@ TEST(ComponentTest, SetAfterIsSetFinal) {
   ASSERT_THROW(set<int>(option["test"], 3), BoutException);
 }
 #endif
+
+TEST(ComponentTest, IsOutputStep) {
+  Options state;
+  // Diagnostics are calculated if not set
+  ASSERT_TRUE(isOutputStep(state));
+
+  set(state["output_step"], false);
+  ASSERT_FALSE(isOutputStep(state));
+
+  state["output_step"].force(true);
+  ASSERT_TRUE(isOutputStep(state));
+}
@@ -1,7 +1,19 @@
 #include "gtest/gtest.h"
 
+#include "test_extras.hxx" // FakeMesh
+
 #include "../../include/component_scheduler.hxx"
 
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
 namespace {
 struct TestComponent : public Component {
   TestComponent(const std::string&, Options&, Solver *) {}
@@ -20,10 +32,170 @@ struct TestMultiply : public Component {
   }
 };
 
+/// Density of each TestCoupled species, so time derivatives can be checked
+std::map<std::string, Field3D*> coupled_density;
+
+/// Evolves the density of one species. Species "a" is converted
+/// to species "b" at a rate proportional to the density of "a"
+struct TestCoupled : public Component {
+  TestCoupled(const std::string& name, Options&, Solver *) : name(name) {
+    density = 0.0;
+    coupled_density[name] = &density;
+  }
+
+  void transform(Options &state) override {
+    if (name == "a") {
+      Options& allspecies = state["species"];
+      addPreconCoupling(allspecies["a"], "density_source", "a", Field3D(-2.0));
+      addPreconCoupling(allspecies["b"], "density_source", "a", Field3D(2.0));
+    }
+  }
+
+  void finally(const Options &) override {
+    ddt(density) = (name == "a") ? 1.0 : 3.0;
+  }
+
+  void preconVariables(const Options&, std::vector<PreconVariable>& variables) override {
+    variables.push_back({name, "density_source", &ddt(density), 1.0, 1.0});
+  }
+
+  std::string name;
+  Field3D density;
+};
+
+/// Sets "value" to the time
+struct TestSetTime : public Component {
+  TestSetTime(const std::string&, Options&, Solver *) {}
+  void transform(Options &state) override {
+    set(state["value"], getNonFinal<BoutReal>(state["time"]));
+  }
+};
+
+/// Adds to "value", counting the number of calls
+int slow_add_calls = 0;
+struct TestSlowAdd : public Component {
+  TestSlowAdd(const std::string&, Options&, Solver *) {}
+  void transform(Options &state) override {
+    ++slow_add_calls;
+    add(state["value"], 2.0);
+    set(state["other"], 3.0);
+  }
+};
+
+/// Sets the potential in a new "fields" section
+struct TestSlowPhi : public Component {
+  TestSlowPhi(const std::string&, Options&, Solver *) {}
+  void transform(Options &state) override {
+    set(state["fields"]["phi"], getNonFinal<BoutReal>(state["time"]));
+  }
+};
+
+/// Time derivative of the TestSlowEvolve variable
+Field3D* slow_evolve_ddt = nullptr;
+
+/// Calculates a rate in transform, which sets the time derivative in finally
+struct TestSlowEvolve : public Component {
+  TestSlowEvolve(const std::string&, Options&, Solver *) {
+    value = 0.0;
+    slow_evolve_ddt = &ddt(value);
+  }
+  void transform(Options &state) override {
+    set(state["rate"], 1.0 + getNonFinal<BoutReal>(state["time"]));
+  }
+  void finally(const Options &state) override {
+    ddt(value) = get<BoutReal>(state["rate"]);
+  }
+  Field3D value;
+};
+
+/// Sets a source and a temperature which depend on time
+struct TestFastFields : public Component {
+  TestFastFields(const std::string&, Options&, Solver *) {}
+  void transform(Options &state) override {
+    const auto time = getNonFinal<BoutReal>(state["time"]);
+    set(state["density_source"], Field3D(time));
+    set(state["temperature"], Field3D(time));
+  }
+};
+
+/// Modifies fields in place, as e.g. Recycling and NeutralBoundary do:
+/// Adds to a source, and overwrites one temperature boundary cell
+struct TestInPlace : public Component {
+  TestInPlace(const std::string&, Options&, Solver *) {}
+  void transform(Options &state) override {
+    Field3D source = getNonFinal<Field3D>(state["density_source"]);
+    BOUT_FOR(i, source.getRegion("RGN_ALL")) {
+      source[i] += 1.0; // Shares data with the state
+    }
+    Field3D temperature = getNonFinal<Field3D>(state["temperature"]);
+    temperature(0, 0, 0) = 10.0;
+  }
+};
+
+/// Records the time and "value" of the last accepted timestep
+BoutReal accepted_time = -1.0;
+BoutReal accepted_value = -1.0;
+struct TestAccepted : public Component {
+  TestAccepted(const std::string&, Options&, Solver *) {}
+  void transform(Options &) override {}
+  void timestepAccepted(const Options &state) override {
+    accepted_time = state["time"].as<BoutReal>();
+    accepted_value = state["value"].as<BoutReal>();
+  }
+};
+
+/// Counts the number of evaluations, saved in restart files
+struct TestCounter : public Component {
+  TestCounter(const std::string& name, Options&, Solver *) : name(name) {}
+  void transform(Options &) override { ++count; }
+  void saveState(Options &restart) override { restart["state"][name]["count"] = count; }
+  void loadState(const Options &restart) override {
+    count = restart["state"][name]["count"].as<int>();
+  }
+  std::string name;
+  int count{0};
+};
+
+/// Integrates 1 over time, like a feedback controller's error integral
+struct TestIntegrator : public Component {
+  TestIntegrator(const std::string& name, Options&, Solver *) : name(name) {}
+  void transform(Options &state) override {
+    const auto time = getNonFinal<BoutReal>(state["time"]);
+    if (lasttime >= 0.0 and time > lasttime) { // Since time can decrease
+      integral += time - lasttime;
+    }
+    lasttime = time;
+  }
+  void saveState(Options &restart) override {
+    restart["state"][name]["integral"] = integral;
+    restart["state"][name]["lasttime"] = lasttime;
+  }
+  void loadState(const Options &restart) override {
+    integral = restart["state"][name]["integral"].as<BoutReal>();
+    lasttime = restart["state"][name]["lasttime"].as<BoutReal>();
+  }
+  std::string name;
+  BoutReal integral{0.0};
+  BoutReal lasttime{-1.0};
+};
+
 RegisterComponent<TestComponent> registertestcomponent("testcomponent");
 RegisterComponent<TestMultiply> registertestcomponent2("multiply");
+RegisterComponent<TestCoupled> registertestcomponent3("coupled");
+RegisterComponent<TestSetTime> registertestcomponent4("settime");
+RegisterComponent<TestSlowAdd> registertestcomponent5("slowadd");
+RegisterComponent<TestCounter> registertestcomponent6("counter");
+RegisterComponent<TestSlowPhi> registertestcomponent7("slowphi");
+RegisterComponent<TestIntegrator> registertestcomponent8("integrator");
+RegisterComponent<TestSlowEvolve> registertestcomponent9("slowevolve");
+RegisterComponent<TestAccepted> registertestcomponent10("accepted");
+RegisterComponent<TestFastFields> registertestcomponent11("fastfields");
+RegisterComponent<TestInPlace> registertestcomponent12("inplace");
 } // namespace
 
+using SchedulerPreconTest = FakeMeshFixture;
+using SchedulerSlowTest = FakeMeshFixture;
+
 TEST(SchedulerTest, OneComponent) {
   Options options;
   options["components"] = "testcomponent";
@@ -59,3 +231,269 @@ TEST(SchedulerTest, SubComponents) {
   ASSERT_TRUE(options["answer"] == 42 * 2);
 }
 
+TEST(SchedulerTest, HasComponentType) {
+  Options options;
+  options["components"] = "species, testcomponent";
+  options["species"]["type"] = "multiply";
+
+  auto scheduler = ComponentScheduler::create(options, options, nullptr);
+
+  // Types are recorded, not component names
+  EXPECT_TRUE(scheduler->hasComponentType("multiply"));
+  EXPECT_TRUE(scheduler->hasComponentType("testcomponent"));
+  EXPECT_FALSE(scheduler->hasComponentType("species"));
+}
+
+TEST(SchedulerTest, SlowComponents) {
+  Options options;
+  options["components"] = "settime, slowadd";
+  options["slow_components"] = "slowadd";
+  options["slow_timestep"] = 1.0;
+  auto scheduler = ComponentScheduler::create(options, options, nullptr);
+
+  slow_add_calls = 0;
+  for (const BoutReal time : {0.0, 0.5, 1.5, 1.0}) {
+    Options state;
+    state["time"] = time;
+    scheduler->transform(state);
+
+    // Changes from the slow component are applied even when not evaluated
+    EXPECT_DOUBLE_EQ(state["value"].as<BoutReal>(), time + 2.0);
+    EXPECT_DOUBLE_EQ(state["other"].as<BoutReal>(), 3.0);
+  }
+  // Evaluated at t = 0, 1.5 and 1.0 (time went backwards)
+  EXPECT_EQ(slow_add_calls, 3);
+}
+
+TEST(SchedulerTest, SlowComponentsNewSection) {
+  Options options;
+  options["components"] = "slowphi";
+  options["slow_components"] = "slowphi";
+  options["slow_timestep"] = 1.0;
+  auto scheduler = ComponentScheduler::create(options, options, nullptr);
+
+  for (const BoutReal time : {0.0, 0.5}) {
+    Options state;
+    state["time"] = time;
+    scheduler->transform(state);
+
+    // Values in a section created by the slow component are replayed
+    ASSERT_TRUE(state["fields"].isSet("phi"));
+    EXPECT_DOUBLE_EQ(state["fields"]["phi"].as<BoutReal>(), 0.0);
+  }
+}
+
+TEST_F(SchedulerSlowTest, SlowTimeDerivsReset) {
+  Options options;
+  options["components"] = "slowevolve";
+  options["slow_components"] = "slowevolve";
+  options["slow_timestep"] = 1.0;
+  auto scheduler = ComponentScheduler::create(options, options, nullptr);
+
+  for (const BoutReal time : {0.0, 0.2, 0.4}) {
+    Options state;
+    state["time"] = time;
+    scheduler->transform(state);
+
+    // Only evaluated at t = 0, but the time derivative is set every call
+    for (const auto& i : slow_evolve_ddt->getRegion("RGN_NOBNDRY")) {
+      ASSERT_DOUBLE_EQ((*slow_evolve_ddt)[i], 1.0);
+    }
+    // Modified between calls, e.g. by a preconditioner
+    *slow_evolve_ddt = 5.0 + time;
+  }
+}
+
+TEST_F(SchedulerSlowTest, SlowInPlaceChanges) {
+  Options options;
+  options["components"] = "fastfields, inplace";
+  options["slow_components"] = "inplace";
+  options["slow_timestep"] = 1.0;
+  auto scheduler = ComponentScheduler::create(options, options, nullptr);
+
+  for (const BoutReal time : {0.0, 0.5}) {
+    Options state;
+    state["time"] = time;
+    scheduler->transform(state);
+
+    // Evaluated only at t = 0. The source increment is added again, and the
+    // overwritten boundary cell is set again, not incremented
+    const Field3D source = state["density_source"].as<Field3D>();
+    const Field3D temperature = state["temperature"].as<Field3D>();
+    BOUT_FOR_SERIAL(i, source.getRegion("RGN_ALL")) {
+      ASSERT_DOUBLE_EQ(source[i], time + 1.0);
+    }
+    ASSERT_DOUBLE_EQ(temperature(0, 0, 0), 10.0);
+    ASSERT_DOUBLE_EQ(temperature(1, 1, 1), time);
+  }
+}
+
+TEST(SchedulerTest, TimestepAccepted) {
+  Options options;
+  options["components"] = "accepted";
+  auto scheduler = ComponentScheduler::create(options, options, nullptr);
+
+  accepted_time = -1.0;
+  accepted_value = -1.0;
+
+  // Evaluates the model with the solution at time, marked by value
+  auto evaluate = [&](BoutReal time, BoutReal value) {
+    Options state;
+    state["time"] = time;
+    state["value"] = value;
+    scheduler->transform(state);
+  };
+
+  // Trial state, e.g. the last stage of a Runge-Kutta step, then the
+  // step is accepted
+  evaluate(2.0, 1.0);
+  scheduler->timestepAccepted(2.0);
+  EXPECT_DOUBLE_EQ(accepted_time, -1.0);
+
+  // First stage of the next step uses the accepted solution
+  evaluate(2.0, 5.0);
+  EXPECT_DOUBLE_EQ(accepted_time, 2.0);
+  EXPECT_DOUBLE_EQ(accepted_value, 5.0);
+
+  // Only once for each accepted step
+  evaluate(2.0, 6.0);
+  EXPECT_DOUBLE_EQ(accepted_value, 5.0);
+
+  // Steps which are not evaluated are skipped
+  scheduler->timestepAccepted(3.0);
+  scheduler->timestepAccepted(4.0);
+  evaluate(4.0, 8.0);
+  EXPECT_DOUBLE_EQ(accepted_time, 4.0);
+  EXPECT_DOUBLE_EQ(accepted_value, 8.0);
+}
+
+TEST(SchedulerTest, TimestepAcceptedCvode) {
+  Options options;
+  options["components"] = "accepted";
+  auto scheduler = ComponentScheduler::create(options, options, nullptr);
+
+  accepted_time = -1.0;
+  accepted_value = -1.0;
+
+  auto evaluate = [&](BoutReal time, BoutReal value) {
+    Options state;
+    state["time"] = time;
+    state["value"] = value;
+    scheduler->transform(state);
+  };
+
+  // CVODE call order: The step to t_n = 2 is accepted, then the model is
+  // evaluated at the predicted time t_n + h, and the output at tout < t_n
+  // is interpolated
+  evaluate(2.0, 1.0);
+  scheduler->timestepAccepted(2.0);
+  evaluate(2.5, 2.0);
+  evaluate(1.5, 3.0);
+
+  // None of these evaluations is the accepted solution
+  EXPECT_DOUBLE_EQ(accepted_time, -1.0);
+
+  // A later evaluation at t_n is not the accepted solution either
+  evaluate(2.0, 4.0);
+  EXPECT_DOUBLE_EQ(accepted_time, -1.0);
+}
+
+TEST(SchedulerTest, OutputStepNoSideEffects) {
+  Options options;
+  options["components"] = "integrator";
+  auto scheduler = ComponentScheduler::create(options, options, nullptr);
+
+  for (const BoutReal time : {0.0, 1.0, 2.0}) {
+    Options state;
+    state["time"] = time;
+    scheduler->transform(state);
+  }
+
+  // Evaluate for output at a time behind the last evaluation
+  Options output_state;
+  output_state["time"] = 1.5;
+  output_state["output_step"] = true;
+  scheduler->transform(output_state);
+  Options output;
+  scheduler->outputVars(output);
+
+  Options state;
+  state["time"] = 3.0;
+  scheduler->transform(state);
+
+  // The integral is not changed by the output evaluation
+  Options restart;
+  scheduler->saveState(restart);
+  EXPECT_DOUBLE_EQ(restart["state"]["integrator"]["integral"].as<BoutReal>(), 3.0);
+  EXPECT_DOUBLE_EQ(restart["state"]["integrator"]["lasttime"].as<BoutReal>(), 3.0);
+}
+
+TEST(SchedulerTest, SaveLoadState) {
+  Options options;
+  options["components"] = "c1, c2";
+  options["c1"]["type"] = "counter";
+  options["c2"]["type"] = "counter";
+  auto scheduler = ComponentScheduler::create(options, options, nullptr);
+
+  for (int i = 0; i < 3; ++i) {
+    Options state;
+    scheduler->transform(state);
+  }
+  Options restart;
+  scheduler->saveState(restart);
+  ASSERT_EQ(restart["state"]["c1"]["count"].as<int>(), 3);
+  ASSERT_EQ(restart["state"]["c2"]["count"].as<int>(), 3);
+
+  // A new scheduler continues from the saved state
+  auto restarted = ComponentScheduler::create(options, options, nullptr);
+  restarted->loadState(restart);
+  Options state;
+  restarted->transform(state);
+
+  Options restart2;
+  restarted->saveState(restart2);
+  ASSERT_EQ(restart2["state"]["c1"]["count"].as<int>(), 4);
+}
+
+TEST_F(SchedulerPreconTest, BlockPrecon) {
+  Options options;
+  options["components"] = "a, b";
+  options["a"]["type"] = "coupled";
+  options["b"]["type"] = "coupled";
+  options["block_precon"] = true;
+
+  auto scheduler = ComponentScheduler::create(options, options, nullptr);
+
+  Options state;
+  scheduler->transform(state);
+
+  // Solve (I - gamma J) x = ddt with J = [[-2, 0], [2, 0]]
+  scheduler->precon(state, 0.5);
+
+  const Field3D& ddt_a = ddt(*coupled_density["a"]);
+  const Field3D& ddt_b = ddt(*coupled_density["b"]);
+  for (const auto& i : ddt_a.getRegion("RGN_NOBNDRY")) {
+    ASSERT_DOUBLE_EQ(ddt_a[i], 0.5);
+    ASSERT_DOUBLE_EQ(ddt_b[i], 3.5);
+  }
+}
+
+TEST_F(SchedulerPreconTest, BlockPreconDisabled) {
+  Options options;
+  options["components"] = "a, b";
+  options["a"]["type"] = "coupled";
+  options["b"]["type"] = "coupled";
+
+  auto scheduler = ComponentScheduler::create(options, options, nullptr);
+
+  Options state;
+  scheduler->transform(state);
+  scheduler->precon(state, 0.5);
+
+  const Field3D& ddt_a = ddt(*coupled_density["a"]);
+  const Field3D& ddt_b = ddt(*coupled_density["b"]);
+  for (const auto& i : ddt_a.getRegion("RGN_NOBNDRY")) {
+    ASSERT_DOUBLE_EQ(ddt_a[i], 1.0);
+    ASSERT_DOUBLE_EQ(ddt_b[i], 3.0);
+  }
+}
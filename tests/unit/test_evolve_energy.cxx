@@ -0,0 +1,102 @@
+
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh, FakeSolver
+
+#include "../../include/evolve_energy.hxx"
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+// Parallel inversion needs Y boundaries
+using EvolveEnergyTest = OpenYFakeMeshFixture;
+
+namespace {
+/// Check that (I - gamma * D * Grad2_par) result = rhs away from Y boundaries,
+/// for a uniform diffusivity D and unit metrics
+void checkPrecon(const Field3D& result, const Field3D& rhs, BoutReal gamma,
+                 BoutReal diffusivity) {
+  const int y = mesh->ystart + 1;
+  for (int x = mesh->xstart; x <= mesh->xend; x++) {
+    for (int z = 0; z < mesh->LocalNz; z++) {
+      const BoutReal residual =
+          result(x, y, z)
+          - gamma * diffusivity
+                * (result(x, y + 1, z) - 2 * result(x, y, z) + result(x, y - 1, z))
+          - rhs(x, y, z);
+      EXPECT_NEAR(residual, 0.0, 1e-10);
+    }
+  }
+}
+
+/// Time derivative varying along Y
+Field3D yProfile() {
+  Field3D result{0.0};
+  for (int x = 0; x < mesh->LocalNx; x++) {
+    for (int y = 0; y < mesh->LocalNy; y++) {
+      for (int z = 0; z < mesh->LocalNz; z++) {
+        result(x, y, z) = SQ(y);
+      }
+    }
+  }
+  return result;
+}
+} // namespace
+
+// Both paths in one test, because the parallel inversion is created
+// on first use and then kept
+TEST_F(EvolveEnergyTest, Precon) {
+  FakeSolver solver;
+  Options& options = Options::root();
+  options["units"]["inv_meters_cubed"] = 1e19;
+  options["units"]["eV"] = 1.0;
+  options["units"]["seconds"] = 1e-6;
+  options["hermes"]["restarting"] = false;
+  options["i"]["precondition"] = true;
+  options["d"]["precondition"] = true;
+  options["d"]["evolve_log"] = true;
+  options["Ed"]["function"] = 1.5;
+
+  EvolveEnergy evolve_E("i", options, &solver);
+  EvolveEnergy evolve_logE("d", options, &solver);
+
+  // E = Cv * P with P = N = T = 1 and Cv = 3/2
+  const BoutReal Cv = 1.5;
+  solver.variable("Ei") = Cv;
+  solver.variable("logEd") = log(Cv);
+
+  Options state;
+  for (const std::string name : {"i", "d"}) {
+    state["species"][name]["density"] = Field3D(1.0);
+    state["species"][name]["velocity"] = Field3D(0.0);
+    state["species"][name]["AA"] = 1.0;
+    state["species"][name]["collision_frequency"] = Field3D(1.0);
+  }
+  evolve_E.transform(state);
+  evolve_logE.transform(state);
+  // Sets the conduction coefficient kappa_par = 3.9 * P * tau / AA
+  evolve_E.finally(state);
+  evolve_logE.finally(state);
+
+  // Conduction acts on T = E / (Cv * N)
+  const BoutReal diffusivity = 3.9 / Cv;
+  const BoutReal gamma = 0.2;
+
+  solver.timeDeriv("Ei") = yProfile();
+  const Field3D rhs_E = copy(solver.timeDeriv("Ei"));
+  evolve_E.precon(state, gamma);
+  checkPrecon(solver.timeDeriv("Ei"), rhs_E, gamma, diffusivity);
+
+  // ddt(logE) = ddt(E) / E
+  solver.timeDeriv("logEd") = yProfile() / Cv;
+  const Field3D rhs_logE = copy(solver.timeDeriv("logEd")) * Cv;
+  evolve_logE.precon(state, gamma);
+  checkPrecon(solver.timeDeriv("logEd") * Cv, rhs_logE, gamma, diffusivity);
+}
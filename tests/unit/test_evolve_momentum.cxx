@@ -0,0 +1,84 @@
+
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh, FakeSolver
+
+#include "../../include/evolve_momentum.hxx"
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+// Parallel inversion needs Y boundaries
+using EvolveMomentumTest = OpenYFakeMeshFixture;
+
+TEST_F(EvolveMomentumTest, PreconDisabledByDefault) {
+  FakeSolver solver;
+  Options options;
+  options["units"]["eV"] = 1.0;
+
+  EvolveMomentum component("i", options, &solver);
+
+  Field3D& ddt_NV = solver.timeDeriv("NVi");
+  ddt_NV = 1.0;
+
+  Options state;
+  component.precon(state, 0.1); // Doesn't use the state
+
+  for (const auto& i : ddt_NV.getRegion("RGN_NOBNDRY")) {
+    ASSERT_DOUBLE_EQ(ddt_NV[i], 1.0);
+  }
+}
+
+TEST_F(EvolveMomentumTest, Precon) {
+  FakeSolver solver;
+  Options options;
+  options["units"]["eV"] = 1.0;
+  options["i"]["precondition"] = true;
+
+  EvolveMomentum component("i", options, &solver);
+
+  const BoutReal wave_speed = 0.5;
+  Options state;
+  state["species"]["i"]["AA"] = 2.0;
+  state["species"]["i"]["density"] = Field3D(1.0);
+  state["fastest_wave"] = Field3D(wave_speed);
+
+  // Time derivative varying along Y
+  Field3D& ddt_NV = solver.timeDeriv("NVi");
+  ddt_NV = 0.0;
+  for (int x = 0; x < mesh->LocalNx; x++) {
+    for (int y = 0; y < mesh->LocalNy; y++) {
+      for (int z = 0; z < mesh->LocalNz; z++) {
+        ddt_NV(x, y, z) = SQ(y);
+      }
+    }
+  }
+  const Field3D rhs = copy(ddt_NV);
+
+  const BoutReal gamma = 0.3;
+  component.precon(state, gamma);
+  const Field3D& result = solver.timeDeriv("NVi");
+
+  // Numerical dissipation and sound wave. Metrics are all 1
+  const BoutReal diffusivity = (0.5 + gamma * wave_speed) * wave_speed;
+
+  // Check (I - gamma J) result = ddt away from the Y boundaries
+  const int y = mesh->ystart + 1;
+  for (int x = mesh->xstart; x <= mesh->xend; x++) {
+    for (int z = 0; z < mesh->LocalNz; z++) {
+      const BoutReal residual =
+          result(x, y, z)
+          - gamma * diffusivity
+                * (result(x, y + 1, z) - 2 * result(x, y, z) + result(x, y - 1, z))
+          - rhs(x, y, z);
+      EXPECT_NEAR(residual, 0.0, 1e-10);
+    }
+  }
+}
@@ -15,6 +15,7 @@
 #include "bout/mesh.hxx"
 #include "bout/mpi_wrapper.hxx"
 #include "bout/operatorstencil.hxx"
+#include "bout/solver.hxx"
 
 static constexpr BoutReal BoutRealTolerance{1e-15};
 // FFTs have a slightly looser tolerance than other functions
@@ -533,4 +534,69 @@ public:
   std::shared_ptr<Coordinates> test_coords_staggered{nullptr};
 };
 
+/// FakeMesh which is not periodic in Y: The inner X edge is a private
+/// flux region, and parallel solves have Y boundaries
+class OpenYFakeMesh : public FakeMesh {
+public:
+  using FakeMesh::FakeMesh;
+  bool periodicY(int UNUSED(jx)) const override { return false; }
+  bool periodicY(int UNUSED(jx), BoutReal& ts) const override {
+    ts = 0.0;
+    return false;
+  }
+};
+
+/// Replaces the global mesh of FakeMeshFixture with an OpenYFakeMesh,
+/// with more X points so that xstart and xend are different
+class OpenYFakeMeshFixture : public FakeMeshFixture {
+public:
+  OpenYFakeMeshFixture() {
+    WithQuietOutput quiet_info{output_info};
+
+    delete bout::globals::mesh;
+    bout::globals::mesh = new OpenYFakeMesh(nx_open, ny, nz);
+    bout::globals::mesh->createDefaultRegions();
+    static_cast<FakeMesh*>(bout::globals::mesh)->setCoordinates(nullptr);
+    open_coords = std::make_shared<Coordinates>(
+        bout::globals::mesh, Field2D{1.0}, Field2D{1.0}, Field2D{1.0}, Field2D{1.0},
+        Field2D{1.0}, Field2D{1.0}, Field2D{1.0}, Field2D{1.0}, Field2D{0.0},
+        Field2D{0.0}, Field2D{0.0}, Field2D{1.0}, Field2D{1.0}, Field2D{1.0},
+        Field2D{0.0}, Field2D{0.0}, Field2D{0.0}, Field2D{0.0}, Field2D{0.0});
+    open_coords->setParallelTransform(
+        bout::utils::make_unique<ParallelTransformIdentity>(*bout::globals::mesh));
+    static_cast<FakeMesh*>(bout::globals::mesh)->setCoordinates(open_coords);
+    static_cast<FakeMesh*>(bout::globals::mesh)
+        ->setGridDataSource(new FakeGridDataSource());
+    static_cast<FakeMesh*>(bout::globals::mesh)->createBoundaryRegions();
+  }
+
+  static constexpr int nx_open = 5;
+
+  std::shared_ptr<Coordinates> open_coords{nullptr};
+};
+
+/// Solver which only stores the evolving variables, so that components
+/// can be created and their time derivatives modified in tests
+class FakeSolver : public Solver {
+public:
+  FakeSolver() : Solver(nullptr) {}
+
+  int run() override { return 0; }
+
+  /// The evolving Field3D variable called \p name
+  Field3D& variable(const std::string& name) { return *find(name).var; }
+  /// The time derivative of the evolving Field3D variable \p name
+  Field3D& timeDeriv(const std::string& name) { return *find(name).F_var; }
+
+private:
+  VarStr<Field3D>& find(const std::string& name) {
+    for (auto& f : f3d) {
+      if (f.name == name) {
+        return f;
+      }
+    }
+    throw BoutException("FakeSolver: No evolving variable '{}'", name);
+  }
+};
+
 #endif //  TEST_EXTRAS_H__
@@ -0,0 +1,48 @@
+
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh
+
+#include "../../include/fixed_fraction_radiation.hxx"
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+TEST(FixedFractionRadiationTest, HornerPolynomial) {
+  // 1 + 2x + 3x^2
+  std::array<BoutReal, 3> coefs = {1.0, 2.0, 3.0};
+  ASSERT_DOUBLE_EQ(hornerPolynomial(coefs, 0.0), 1.0);
+  ASSERT_DOUBLE_EQ(hornerPolynomial(coefs, 2.0), 17.0);
+}
+
+TEST(FixedFractionRadiationTest, ConstantOutsideFit) {
+  Neon_adas neon;
+  ASSERT_DOUBLE_EQ(neon.curve(0.5), neon.curve(1.0));
+  ASSERT_DOUBLE_EQ(neon.curve(2e3), neon.curve(1e4));
+}
+
+template <typename CoolingCurve>
+void checkTable() {
+  CoolingCurve cooling;
+  CoolingCurveTable<CoolingCurve> table(cooling, 2000);
+
+  for (BoutReal Te = 0.5; Te < 5000; Te *= 1.1) {
+    const BoutReal expected = cooling.curve(Te);
+    EXPECT_NEAR(table.curve(Te), expected, 1e-3 * expected) << "Te = " << Te;
+  }
+}
+
+TEST(FixedFractionRadiationTest, TableMatchesCurve) {
+  checkTable<HutchinsonCarbon>();
+  checkTable<Carbon_adas>();
+  checkTable<Nitrogen_adas>();
+  checkTable<Neon_adas>();
+  checkTable<Argon_adas>();
+}
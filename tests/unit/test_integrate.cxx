@@ -5,6 +5,8 @@
 
 #include "test_extras.hxx" // FakeMesh
 
+#include <bout/field_factory.hxx>  // For generating functions
+
 /// Global mesh
 namespace bout{
 namespace globals{
@@ -37,3 +39,39 @@ TEST_F(CellAverageTest, ConstantField) {
   ASSERT_TRUE(areFieldsCompatible(field, result));
   ASSERT_TRUE(IsFieldEqual(result, 2.0, "RGN_NOBNDRY"));
 }
+
+TEST_F(CellAverageTest, MultipleOutputs) {
+  Field3D field{1.0};
+  auto result = cellAverageMultiple(
+      [](BoutReal val) {
+        return std::array<BoutReal, 2>{val * 2.0, 3.0};
+      },
+      field.getRegion("RGN_NOBNDRY"))(field);
+
+  ASSERT_TRUE(result[0].isAllocated());
+  ASSERT_TRUE(result[1].isAllocated());
+  ASSERT_TRUE(areFieldsCompatible(field, result[0]));
+  ASSERT_TRUE(IsFieldEqual(result[0], 2.0, "RGN_NOBNDRY"));
+  ASSERT_TRUE(IsFieldEqual(result[1], 3.0, "RGN_NOBNDRY"));
+}
+
+TEST_F(CellAverageTest, MultipleMatchesSingle) {
+  Options options;
+  Field3D field = FieldFactory::get()->create3D("1 + y + sin(z)", &options, mesh);
+  Field3D field2 = FieldFactory::get()->create3D("2 - x + cos(y)", &options, mesh);
+
+  auto func1 = [](BoutReal a, BoutReal b) { return a * b; };
+  auto func2 = [](BoutReal a, BoutReal b) { return exp(a - b); };
+
+  Field3D result1 = cellAverage(func1, field.getRegion("RGN_NOBNDRY"))(field, field2);
+  Field3D result2 = cellAverage(func2, field.getRegion("RGN_NOBNDRY"))(field, field2);
+
+  auto result = cellAverageMultiple(
+      [&](BoutReal a, BoutReal b) {
+        return std::array<BoutReal, 2>{func1(a, b), func2(a, b)};
+      },
+      field.getRegion("RGN_NOBNDRY"))(field, field2);
+
+  ASSERT_TRUE(IsFieldEqual(result[0], result1, "RGN_NOBNDRY"));
+  ASSERT_TRUE(IsFieldEqual(result[1], result2, "RGN_NOBNDRY"));
+}
@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh
+
+#include "../../include/laplacian_coefficient.hxx"
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+// Reuse the "standard" fixture for FakeMesh
+using LaplacianCoefficientTest = FakeMeshFixture;
+
+TEST_F(LaplacianCoefficientTest, UpdateIfChanged) {
+  LaplacianCoefficient<Field3D> coef; // Default tolerance 0
+
+  ASSERT_TRUE(coef.update(Field3D{1.0})); // First value is always set
+  ASSERT_FALSE(coef.update(Field3D{1.0})); // Same values, different field
+
+  Field3D changed{1.0};
+  changed(mesh->xstart, mesh->ystart, 0) = 1.0 + 1e-12;
+  ASSERT_TRUE(coef.update(changed));
+  ASSERT_DOUBLE_EQ(coef.value()(mesh->xstart, mesh->ystart, 0), 1.0 + 1e-12);
+
+  // Changes in the boundary cells are detected
+  Field3D boundary = copy(changed);
+  boundary(0, mesh->ystart, 0) = 3.0;
+  ASSERT_TRUE(coef.update(boundary));
+  ASSERT_DOUBLE_EQ(coef.value()(0, mesh->ystart, 0), 3.0);
+}
+
+TEST_F(LaplacianCoefficientTest, StoresCopy) {
+  LaplacianCoefficient<Field2D> coef;
+  Field2D value{2.0};
+  ASSERT_TRUE(coef.update(value));
+
+  // Modifying the field in place is detected
+  value(mesh->xstart, mesh->ystart) = 4.0;
+  ASSERT_TRUE(coef.update(value));
+  ASSERT_DOUBLE_EQ(coef.value()(mesh->xstart, mesh->ystart), 4.0);
+}
+
+TEST_F(LaplacianCoefficientTest, Tolerance) {
+  LaplacianCoefficient<Field3D> coef{0.1};
+
+  ASSERT_TRUE(coef.update(Field3D{1.0}));
+  ASSERT_FALSE(coef.update(Field3D{1.05})); // Below tolerance: keep previous
+  ASSERT_DOUBLE_EQ(coef.value()(mesh->xstart, mesh->ystart, 0), 1.0);
+
+  ASSERT_TRUE(coef.update(Field3D{1.2}));
+  ASSERT_DOUBLE_EQ(coef.value()(mesh->xstart, mesh->ystart, 0), 1.2);
+
+  // Large changes in boundary cells are detected
+  Field3D boundary{1.2};
+  boundary(0, mesh->ystart, 0) = 2.0;
+  ASSERT_TRUE(coef.update(boundary));
+}
+
+TEST_F(LaplacianCoefficientTest, AlwaysUpdate) {
+  LaplacianCoefficient<Field3D> coef{-1.0};
+
+  ASSERT_TRUE(coef.update(Field3D{1.0}));
+  ASSERT_TRUE(coef.update(Field3D{1.0}));
+}
@@ -0,0 +1,80 @@
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh
+
+#include "../../include/output_precision.hxx"
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+#include <bout/field_factory.hxx>  // For generating functions
+
+#include <cmath>
+
+// Reuse the "standard" fixture for FakeMesh
+using OutputPrecisionTest = FakeMeshFixture;
+
+TEST(OutputPrecision, MantissaBits) {
+  ASSERT_EQ(mantissaBits(0.0), 52);
+  ASSERT_EQ(mantissaBits(0.25), 1);
+  ASSERT_EQ(mantissaBits(1e-3), 9);
+}
+
+TEST(OutputPrecision, RoundMantissaError) {
+  for (BoutReal value : {1.0, -3.14159, 1.234e-20, 6.02e23, 0.1}) {
+    for (int bits : {1, 5, 10, 23}) {
+      const BoutReal rounded = roundMantissa(value, bits);
+      ASSERT_LE(std::abs(rounded - value), std::abs(value) * std::pow(2., -(bits + 1)));
+    }
+  }
+}
+
+TEST(OutputPrecision, RoundMantissaExact) {
+  // Values which can be represented exactly are unchanged
+  ASSERT_DOUBLE_EQ(roundMantissa(1.5, 1), 1.5);
+  ASSERT_DOUBLE_EQ(roundMantissa(0.0, 4), 0.0);
+  ASSERT_DOUBLE_EQ(roundMantissa(-2.0, 4), -2.0);
+}
+
+TEST_F(OutputPrecisionTest, DoesNotModifySimulation) {
+  Options options;
+  Field3D f = FieldFactory::get()->create3D("0.1 + x + y + z", &options, mesh);
+  const Field3D original = copy(f);
+
+  Options output;
+  output["f"] = f;
+  output["f"].attributes["time_dimension"] = "t";
+
+  reduceOutputPrecision(output, 1e-3);
+
+  const Field3D result = output["f"].as<Field3D>();
+  BOUT_FOR_SERIAL(i, f.getRegion("RGN_ALL")) {
+    ASSERT_DOUBLE_EQ(f[i], original[i]);
+    ASSERT_NEAR(result[i], f[i], 1e-3 * std::abs(f[i]));
+  }
+  ASSERT_DOUBLE_EQ(output["f"].attributes["relative_error"].as<BoutReal>(), 1e-3);
+}
+
+TEST_F(OutputPrecisionTest, Float64Attribute) {
+  Options options;
+  Field3D f = FieldFactory::get()->create3D("0.1 + x + y + z", &options, mesh);
+
+  Options output;
+  output["f"] = f;
+  output["f"].attributes["time_dimension"] = "t";
+  output["f"].attributes["precision"] = "float64";
+
+  reduceOutputPrecision(output, 1e-3);
+
+  const Field3D result = output["f"].as<Field3D>();
+  BOUT_FOR_SERIAL(i, f.getRegion("RGN_ALL")) {
+    ASSERT_DOUBLE_EQ(result[i], f[i]);
+  }
+}
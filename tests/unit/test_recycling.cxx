@@ -4,6 +4,7 @@
 #include "test_extras.hxx" // FakeMesh
 
 #include "../../include/recycling.hxx"
+#include "../../include/hermes_utils.hxx" // For indexAt
 
 /// Global mesh
 namespace bout{
@@ -28,3 +29,84 @@ TEST_F(RecyclingTest, CreateComponent) {
   Recycling component("recycling", options, nullptr);
 }
 
+
+TEST_F(RecyclingTest, SolRecycleMultiplierAndEnergy) {
+  Options options;
+  options["units"]["eV"] = 1.0; // Normalisation temperature
+  options["recycling"]["species"] = "d+";
+  options["d+"]["recycle_as"] = "d";
+  options["d+"]["sol_recycle"] = true;
+  options["d+"]["sol_recycle_multiplier"] = 0.5;
+  options["d+"]["sol_recycle_energy"] = 4.0;
+  // PFR settings should not be used at the SOL edge
+  options["d+"]["pfr_recycle_multiplier"] = 0.2;
+  options["d+"]["pfr_recycle_energy"] = 7.0;
+
+  Recycling component("recycling", options, nullptr);
+
+  Options state;
+  state["species"]["d+"]["density"] = Field3D{1.0, mesh};
+  state["species"]["d+"]["velocity"] = Field3D{0.0, mesh};
+  state["species"]["d+"]["particle_flow_xlow"] = Field3D{2.0, mesh}; // Out of the SOL edge
+  state["species"]["d"]["density"] = Field3D{1.0, mesh};
+  state["species"]["d"]["pressure"] = Field3D{1.0, mesh};
+  state["species"]["d"]["temperature"] = Field3D{1.0, mesh};
+  state["species"]["d"]["AA"] = 2.0;
+
+  component.transform(state);
+
+  const Field3D density_source = state["species"]["d"]["density_source"].as<Field3D>();
+  const Field3D energy_source = state["species"]["d"]["energy_source"].as<Field3D>();
+
+  WallBoundary wall(mesh);
+  ASSERT_FALSE(wall.sol.empty());
+  for (const auto& cell : wall.sol) {
+    const BoutReal source = 0.5 * 2.0 * cell.inv_volume;
+    ASSERT_DOUBLE_EQ(source, density_source[cell.i]);
+    ASSERT_DOUBLE_EQ(4.0 * source, energy_source[cell.i]);
+  }
+}
+
+// Mesh with a private flux region
+using RecyclingPfrTest = OpenYFakeMeshFixture;
+
+TEST_F(RecyclingPfrTest, PfrSourcesInPfrCells) {
+  Options options;
+  options["units"]["eV"] = 1.0; // Normalisation temperature
+  options["recycling"]["species"] = "d+";
+  options["d+"]["recycle_as"] = "d";
+  options["d+"]["pfr_recycle"] = true;
+  options["d+"]["pfr_recycle_multiplier"] = 0.5;
+  options["d+"]["pfr_recycle_energy"] = 4.0;
+
+  Recycling component("recycling", options, nullptr);
+
+  Options state;
+  state["species"]["d+"]["density"] = Field3D{1.0, mesh};
+  state["species"]["d+"]["velocity"] = Field3D{0.0, mesh};
+  // Flow in the negative X direction, out of the PFR edge
+  state["species"]["d+"]["particle_flow_xlow"] = Field3D{-2.0, mesh};
+  state["species"]["d"]["density"] = Field3D{1.0, mesh};
+  state["species"]["d"]["pressure"] = Field3D{1.0, mesh};
+  state["species"]["d"]["temperature"] = Field3D{1.0, mesh};
+  state["species"]["d"]["AA"] = 2.0;
+
+  component.transform(state);
+
+  const Field3D density_source = state["species"]["d"]["density_source"].as<Field3D>();
+  const Field3D energy_source = state["species"]["d"]["energy_source"].as<Field3D>();
+
+  WallBoundary wall(mesh);
+  ASSERT_FALSE(wall.pfr.empty());
+  ASSERT_NE(mesh->xstart, mesh->xend);
+  for (const auto& cell : wall.pfr) {
+    ASSERT_EQ(mesh->xstart, cell.i.x());
+    const BoutReal source = 0.5 * 2.0 * cell.inv_volume;
+    ASSERT_DOUBLE_EQ(source, density_source[cell.i]);
+    ASSERT_DOUBLE_EQ(4.0 * source, energy_source[cell.i]);
+
+    // Nothing is added at the other (SOL) edge
+    const auto i_xend = indexAt(density_source, mesh->xend, cell.i.y(), cell.i.z());
+    ASSERT_DOUBLE_EQ(0.0, density_source[i_xend]);
+  }
+}
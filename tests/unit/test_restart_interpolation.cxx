@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh
+
+#include "../../include/restart_interpolation.hxx"
+#include "../../include/upstream_density_feedback.hxx"
+
+#include <bout/boutexception.hxx>
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+TEST(RestartInterpolation, SameGrid) {
+  const std::vector<int> bounds{0, 2, 10, 12};
+  for (int i = 0; i < 12; ++i) {
+    const auto w = interpolationWeights(i, bounds, bounds);
+    ASSERT_EQ(i, w.lower);
+    ASSERT_DOUBLE_EQ(0.0, w.weight);
+  }
+}
+
+TEST(RestartInterpolation, Refine) {
+  // Doubling the resolution of a single segment
+  const auto w = interpolationWeights(3, {0, 8}, {0, 4});
+  // Cell centre 3.5 on the new grid is at 1.75 on the old grid
+  ASSERT_EQ(1, w.lower);
+  ASSERT_EQ(2, w.upper);
+  ASSERT_DOUBLE_EQ(0.25, w.weight);
+}
+
+TEST(RestartInterpolation, SegmentEdges) {
+  // Cells are only taken from the corresponding segment
+  const std::vector<int> new_bounds{0, 2, 12, 14};
+  const std::vector<int> old_bounds{0, 2, 6, 8};
+
+  // First cell in the middle segment is at the edge of the old segment
+  auto w = interpolationWeights(2, new_bounds, old_bounds);
+  ASSERT_EQ(2, w.lower);
+  ASSERT_DOUBLE_EQ(0.0, w.weight);
+
+  // Last cell in the middle segment
+  w = interpolationWeights(11, new_bounds, old_bounds);
+  ASSERT_EQ(5, w.lower);
+  ASSERT_EQ(5, w.upper);
+
+  // Guard cells map to guard cells
+  w = interpolationWeights(13, new_bounds, old_bounds);
+  ASSERT_EQ(7, w.lower);
+  ASSERT_GE(w.upper, 6);
+}
+
+TEST(RestartInterpolation, ClampIndex) {
+  // Y boundary cells are outside the grid
+  const auto w = interpolationWeights(-1, {0, 8}, {0, 4});
+  ASSERT_EQ(0, w.lower);
+  ASSERT_DOUBLE_EQ(0.0, w.weight);
+}
+
+TEST(RestartInterpolation, EmptySegment) {
+  ASSERT_THROW(interpolationWeights(3, {0, 2, 4}, {0, 2, 2}), BoutException);
+}
+
+using RestartInterpolationStateTest = FakeMeshFixture;
+
+TEST_F(RestartInterpolationStateTest, OnlyFields) {
+  Options interpolated;
+  interpolated["phi"] = Field3D(2.0);
+  interpolated["tt"] = 100.0;
+  interpolated["state"]["d+"]["density_error_integral"] = 3.0;
+  interpolated["state"]["d+"]["density_error_lasttime"] = 100.0;
+  interpolated["state"]["d+"]["density_error_last"] = 0.5;
+
+  const Options state = interpolatedState(interpolated);
+  ASSERT_TRUE(state.isSet("phi"));
+  ASSERT_FALSE(state.isSet("tt"));
+  ASSERT_FALSE(state.isSection("state"));
+
+  // A feedback controller loading this state starts again from time zero
+  Options options = {{"units", {{"inv_meters_cubed", 1.0}, {"seconds", 1.0}}},
+                     {"d+", {{"density_upstream", 1.0}}}};
+  UpstreamDensityFeedback component("d+", options, nullptr);
+  component.loadState(state);
+
+  Options restart;
+  component.saveState(restart);
+  ASSERT_DOUBLE_EQ(restart["state"]["d+"]["density_error_integral"].as<BoutReal>(), 0.0);
+  ASSERT_LT(restart["state"]["d+"]["density_error_lasttime"].as<BoutReal>(), 0.0);
+}
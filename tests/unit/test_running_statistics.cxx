@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh
+
+#include "../../include/running_statistics.hxx"
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+#include <cmath>
+
+// Reuse the "standard" fixture for FakeMesh
+using RunningStatisticsTest = FakeMeshFixture;
+
+TEST_F(RunningStatisticsTest, MeanVariance) {
+  Moments<Field3D> stats(4);
+  for (BoutReal value : {1.0, 2.0, 3.0, 4.0}) {
+    stats.add(Field3D(value));
+  }
+  ASSERT_EQ(stats.samples(), 4);
+
+  const Field3D mean = stats.mean();
+  const Field3D variance = stats.variance();
+  const Field3D skewness = stats.skewness();
+  const Field3D kurtosis = stats.kurtosis();
+  BOUT_FOR_SERIAL(i, mean.getRegion("RGN_ALL")) {
+    ASSERT_DOUBLE_EQ(mean[i], 2.5);
+    ASSERT_DOUBLE_EQ(variance[i], 5. / 3);
+    ASSERT_NEAR(skewness[i], 0.0, 1e-14);
+    ASSERT_DOUBLE_EQ(kurtosis[i], -1.36);
+  }
+}
+
+TEST_F(RunningStatisticsTest, Skewness) {
+  Moments<Field2D> stats(3);
+  for (BoutReal value : {1.0, 2.0, 6.0}) {
+    stats.add(Field2D(value));
+  }
+  const Field2D skewness = stats.skewness();
+  BOUT_FOR_SERIAL(i, skewness.getRegion("RGN_ALL")) {
+    ASSERT_DOUBLE_EQ(skewness[i], std::sqrt(3.) * 18. / std::pow(14., 1.5));
+  }
+}
+
+TEST_F(RunningStatisticsTest, Reset) {
+  Moments<Field3D> stats;
+  stats.add(Field3D(1.0));
+  stats.add(Field3D(3.0));
+  stats.reset();
+  ASSERT_EQ(stats.samples(), 0);
+
+  stats.add(Field3D(5.0));
+  const Field3D mean = stats.mean();
+  const Field3D variance = stats.variance();
+  BOUT_FOR_SERIAL(i, mean.getRegion("RGN_ALL")) {
+    ASSERT_DOUBLE_EQ(mean[i], 5.0);
+    ASSERT_DOUBLE_EQ(variance[i], 0.0);
+  }
+}
+
+TEST_F(RunningStatisticsTest, RequireSampleInterval) {
+  Options options = {{"solver", {{"type", "rk4"}, {"monitor_timestep", true}}},
+                     {"stats", {{"variables", "value"}, {"sample_interval", 0.0}}}};
+
+  ASSERT_THROW(RunningStatistics component("stats", options, nullptr), BoutException);
+}
+
+TEST_F(RunningStatisticsTest, RequireMonitorTimestep) {
+  Options options = {{"stats", {{"variables", "value"}, {"sample_interval", 0.1}}}};
+
+  ASSERT_THROW(RunningStatistics component("stats", options, nullptr), BoutException);
+}
+
+TEST_F(RunningStatisticsTest, ImplicitSolver) {
+  // Accepted states are not available with implicit solvers, or the default CVODE
+  Options cvode = {{"solver", {{"type", "cvode"}, {"monitor_timestep", true}}},
+                   {"stats", {{"variables", "value"}, {"sample_interval", 0.1}}}};
+  ASSERT_THROW(RunningStatistics("stats", cvode, nullptr), BoutException);
+
+  Options default_solver = {{"solver", {{"monitor_timestep", true}}},
+                            {"stats", {{"variables", "value"}, {"sample_interval", 0.1}}}};
+  ASSERT_THROW(RunningStatistics("stats", default_solver, nullptr), BoutException);
+}
+
+TEST_F(RunningStatisticsTest, OnlyAcceptedSteps) {
+  Options options = {{"solver", {{"type", "rk4"}, {"monitor_timestep", true}}},
+                     {"stats", {{"variables", "value"}, {"sample_interval", 0.1}}}};
+  RunningStatistics component("stats", options, nullptr);
+
+  // Evaluations which are not accepted are not sampled
+  for (const BoutReal time : {0.0, 0.1, 0.2}) {
+    Options state;
+    state["time"] = time;
+    state["value"] = Field3D(time);
+    component.transform(state);
+  }
+  Options state;
+  state["time"] = 0.15;
+  state["value"] = Field3D(1.0);
+  component.timestepAccepted(state);
+
+  Options output;
+  component.outputVars(output);
+  ASSERT_EQ(output["value_samples"].as<int>(), 1);
+  const Field3D mean = output["value_mean"].as<Field3D>();
+  BOUT_FOR_SERIAL(i, mean.getRegion("RGN_ALL")) {
+    ASSERT_DOUBLE_EQ(mean[i], 1.0);
+  }
+}
+
+TEST_F(RunningStatisticsTest, SampleFixedTimes) {
+  Options options = {{"solver", {{"type", "rk4"}, {"monitor_timestep", true}}},
+                     {"stats", {{"variables", "value"}, {"sample_interval", 0.1}}}};
+  RunningStatistics component("stats", options, nullptr);
+
+  // Only the first accepted step after each multiple of sample_interval is sampled
+  for (const BoutReal time : {0.0, 0.05, 0.12, 0.15, 0.31}) {
+    Options state;
+    state["time"] = time;
+    state["value"] = Field3D(time);
+    component.transform(state);
+    component.timestepAccepted(state);
+  }
+
+  Options output;
+  component.outputVars(output);
+  ASSERT_EQ(output["value_samples"].as<int>(), 3);
+  const Field3D mean = output["value_mean"].as<Field3D>();
+  BOUT_FOR_SERIAL(i, mean.getRegion("RGN_ALL")) {
+    ASSERT_DOUBLE_EQ(mean[i], (0.0 + 0.12 + 0.31) / 3);
+  }
+}
+
+TEST_F(RunningStatisticsTest, OutputWithoutSamples) {
+  Options options = {{"solver", {{"type", "rk4"}, {"monitor_timestep", true}}},
+                     {"stats", {{"variables", "value"}, {"sample_interval", 0.1}}}};
+  RunningStatistics component("stats", options, nullptr);
+
+  // All outputs are written, even without samples
+  Options output;
+  component.outputVars(output);
+  ASSERT_EQ(output["value_samples"].as<int>(), 0);
+  ASSERT_TRUE(output.isSet("value_var"));
+  const Field3D mean = output["value_mean"].as<Field3D>();
+  BOUT_FOR_SERIAL(i, mean.getRegion("RGN_ALL")) {
+    ASSERT_TRUE(std::isnan(mean[i]));
+  }
+}
@@ -102,3 +102,137 @@ TEST_F(SheathBoundaryTest, CalculatePotential) {
     }
   }
 }
+
+TEST_F(SheathBoundaryTest, SinAlphaBothTargets) {
+  Options options{{"test", {{"always_set_phi", true}, {"sin_alpha", 0.5}}}};
+  options["units"]["eV"] = 1.0; // Voltage normalisation
+
+  SheathBoundary component("test", options, nullptr);
+
+  Field3D N = FieldFactory::get()->create3D("1 + y", &options, mesh);
+  BoutReal Te = 2.0;
+  BoutReal Ti = 3.0;
+  BoutReal Zi = 1.1;
+  BoutReal si = 0.5;
+
+  Options state{{"species",
+                 {// Electrons
+                  {"e", {{"density", N}, {"temperature", Te}, {"velocity", 0.0}}},
+                  // Ion species
+                  {"h",
+                   {{"density", si * N},
+                    {"temperature", Ti},
+                    {"AA", 1.0},
+                    {"charge", Zi},
+                    {"velocity", 0.0}}}}}};
+
+  component.transform(state);
+
+  // Ion flux into the sheath is reduced by sin_alpha at both targets
+  const BoutReal adiabatic = 5./3;
+  BoutReal Vzi = 0.5 * sqrt(adiabatic * Ti + Zi * Te);
+  BoutReal phi_ref = Te * log(sqrt(Te * SI::Mp / SI::Me / TWOPI) / (si * Zi * Vzi));
+
+  Field3D phi = state["fields"]["phi"];
+
+  for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
+    for (int jz = 0; jz < mesh->LocalNz; jz++) {
+      ASSERT_DOUBLE_EQ(phi_ref, phi(r.ind, mesh->ystart, jz));
+    }
+  }
+  for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
+    for (int jz = 0; jz < mesh->LocalNz; jz++) {
+      ASSERT_DOUBLE_EQ(phi_ref, phi(r.ind, mesh->yend, jz));
+    }
+  }
+}
+
+TEST_F(SheathBoundaryTest, IonConcentrationLimitedBothTargets) {
+  Options options;
+  options["units"]["eV"] = 1.0; // Voltage normalisation
+
+  SheathBoundary component("test", options, nullptr);
+
+  BoutReal Te = 2.0;
+  BoutReal Ti = 3.0;
+  BoutReal Zi = 1.1;
+
+  // Ion density greater than electron density
+  Options state{{"species",
+                 {// Electrons
+                  {"e", {{"density", 1.0}, {"temperature", Te}, {"velocity", 0.0}}},
+                  // Ion species
+                  {"h",
+                   {{"density", 2.0},
+                    {"temperature", Ti},
+                    {"AA", 1.0},
+                    {"charge", Zi},
+                    {"velocity", 0.0}}}}}};
+
+  component.transform(state);
+
+  // Ion concentration at the sheath entrance is limited to 1
+  const BoutReal adiabatic = 5./3;
+  const BoutReal visheath = sqrt(adiabatic * Ti + Zi * Te);
+
+  Field3D Vi = state["species"]["h"]["velocity"];
+
+  for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
+    for (int jz = 0; jz < mesh->LocalNz; jz++) {
+      ASSERT_DOUBLE_EQ(-visheath, 0.5 * (Vi(r.ind, mesh->ystart, jz)
+                                         + Vi(r.ind, mesh->ystart - 1, jz)));
+    }
+  }
+  for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
+    for (int jz = 0; jz < mesh->LocalNz; jz++) {
+      ASSERT_DOUBLE_EQ(visheath, 0.5 * (Vi(r.ind, mesh->yend, jz)
+                                        + Vi(r.ind, mesh->yend + 1, jz)));
+    }
+  }
+}
+
+TEST_F(SheathBoundaryTest, IonHeatFlowBothTargets) {
+  Options options;
+  options["units"]["eV"] = 1.0; // Voltage normalisation
+
+  SheathBoundary component("test", options, nullptr);
+
+  BoutReal Te = 2.0;
+  BoutReal Ti = 3.0;
+  BoutReal Zi = 1.1;
+
+  Options state{{"species",
+                 {// Electrons
+                  {"e", {{"density", 1.0}, {"temperature", Te}, {"velocity", 0.0}}},
+                  // Ion species
+                  {"h",
+                   {{"density", 2.0},
+                    {"temperature", Ti},
+                    {"AA", 1.0},
+                    {"charge", Zi},
+                    {"velocity", 0.0}}}}}};
+
+  component.transform(state);
+
+  // Uniform density, so the kinetic correction is removed
+  // and the ion concentration is limited to 1
+  const BoutReal adiabatic = 5./3;
+  const BoutReal C_i_sq = adiabatic * Ti + Zi * Te;
+  const BoutReal gamma_i = 2.5 + 0.5 * C_i_sq / Ti;
+
+  // Heat flow at the Y cell faces. All metrics are 1
+  const BoutReal flow = gamma_i * Ti * 2.0 * sqrt(C_i_sq);
+
+  Field3D Q = state["species"]["h"]["energy_flow_ylow"];
+
+  for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
+    for (int jz = 0; jz < mesh->LocalNz; jz++) {
+      ASSERT_DOUBLE_EQ(-flow, Q(r.ind, mesh->ystart, jz));
+    }
+  }
+  for (RangeIterator r = mesh->iterateBndryUpperY(); !r.isDone(); r++) {
+    for (int jz = 0; jz < mesh->LocalNz; jz++) {
+      ASSERT_DOUBLE_EQ(flow, Q(r.ind, mesh->yend + 1, jz));
+    }
+  }
+}
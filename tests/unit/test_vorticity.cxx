@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh, FakeSolver
+
+#include "../../include/vorticity.hxx"
+
+#include <bout/constants.hxx>
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+// Reuse the "standard" fixture for FakeMesh
+using VorticityTest = FakeMeshFixture;
+
+TEST_F(VorticityTest, PreconSheathDissipation) {
+  FakeSolver solver;
+  Options& options = Options::root();
+  options["mesh"]["paralleltransform"]["type"] = "identity";
+  options["units"]["seconds"] = 1e-6;
+  options["units"]["Tesla"] = 1.0;
+  options["units"]["meters"] = 1.0;
+  options["vorticity"]["diamagnetic"] = false; // No curvature in the mesh
+  options["vorticity"]["phi_dissipation"] = false;
+  options["vorticity"]["phi_sheath_dissipation"] = true;
+  options["vorticity"]["precondition"] = true;
+
+  Vorticity component("vorticity", options, &solver);
+
+  // Potential negative at the sheath in even Z indices
+  Field3D phi{1.0};
+  for (int x = 0; x < mesh->LocalNx; x++) {
+    for (int y = 0; y < mesh->LocalNy; y++) {
+      for (int z = 0; z < mesh->LocalNz; z += 2) {
+        phi(x, y, z) = -1.0;
+      }
+    }
+  }
+  Options restart;
+  restart["phi"] = phi;
+  component.loadState(restart);
+
+  Field3D rhs{0.0};
+  for (int x = 0; x < mesh->LocalNx; x++) {
+    for (int y = 0; y < mesh->LocalNy; y++) {
+      for (int z = 0; z < mesh->LocalNz; z++) {
+        rhs(x, y, z) = 1.0 + x + 2 * y + 3 * z;
+      }
+    }
+  }
+  solver.timeDeriv("Vort") = copy(rhs);
+
+  const BoutReal gamma = 0.3;
+  Options state;
+  component.precon(state, gamma);
+
+  // phi ~ -(B^2 / A) Vort / k_perp^2 with B = 1, A = 2 and unit metrics,
+  // so k_perp^2 = 2 pi^2
+  const BoutReal phi_factor = 1.0 / (2.0 * 2 * SQ(PI));
+
+  const Field3D& result = solver.timeDeriv("Vort");
+  for (int x = mesh->xstart; x <= mesh->xend; x++) {
+    for (int y = mesh->ystart; y <= mesh->yend; y++) {
+      for (int z = 0; z < mesh->LocalNz; z++) {
+        const bool sheath = ((y == mesh->ystart) or (y == mesh->yend)) and (z % 2 == 0);
+        if (sheath) {
+          // Inverse of the local sheath dissipation
+          EXPECT_DOUBLE_EQ((1.0 + gamma * phi_factor) * result(x, y, z), rhs(x, y, z));
+        } else {
+          EXPECT_DOUBLE_EQ(result(x, y, z), rhs(x, y, z));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx" // FakeMesh
+
+#include "../../include/wall_boundary.hxx"
+#include "../../include/hermes_utils.hxx" // For indexAt
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+// Reuse the "standard" fixture for FakeMesh
+using WallBoundaryTest = FakeMeshFixture;
+
+TEST_F(WallBoundaryTest, TargetCells) {
+  WallBoundary wall(mesh);
+  Coordinates* coord = mesh->getCoordinates();
+  Field3D f{0.0, mesh};
+
+  std::size_t n = 0;
+  for (RangeIterator r = mesh->iterateBndryLowerY(); !r.isDone(); r++) {
+    for (int jz = 0; jz < mesh->LocalNz; jz++) {
+      ASSERT_LT(n, wall.lower_target.size());
+      const auto& cell = wall.lower_target[n++];
+
+      ASSERT_EQ(indexAt(f, r.ind, mesh->ystart, jz), cell.i);
+      ASSERT_EQ(indexAt(f, r.ind, mesh->ystart - 1, jz), cell.guard);
+      ASSERT_EQ(indexAt(f, r.ind, mesh->ystart + 1, jz), cell.inner);
+      ASSERT_EQ(-1, cell.direction);
+      ASSERT_DOUBLE_EQ((coord->J(r.ind, mesh->ystart) + coord->J(r.ind, mesh->ystart - 1))
+                           / (sqrt(coord->g_22(r.ind, mesh->ystart))
+                              + sqrt(coord->g_22(r.ind, mesh->ystart - 1))),
+                       cell.area);
+      ASSERT_DOUBLE_EQ(1. / (coord->J(r.ind, mesh->ystart) * coord->dy(r.ind, mesh->ystart)),
+                       cell.inv_volume);
+      ASSERT_FALSE(cell.pump);
+    }
+  }
+  ASSERT_EQ(n, wall.lower_target.size());
+
+  for (const auto& cell : wall.upper_target) {
+    ASSERT_EQ(mesh->yend, cell.i.y());
+    ASSERT_EQ(cell.i.yp(), cell.guard);
+    ASSERT_EQ(1, cell.direction);
+  }
+}
+
+TEST_F(WallBoundaryTest, PumpCells) {
+  Field2D is_pump{0.0, mesh};
+  is_pump(mesh->xend, mesh->ystart) = 1.0;
+
+  WallBoundary wall(mesh, is_pump);
+
+  if (!mesh->lastX()) {
+    ASSERT_TRUE(wall.sol.empty());
+    return;
+  }
+  ASSERT_EQ(static_cast<std::size_t>(mesh->LocalNy * mesh->LocalNz), wall.sol.size());
+  for (const auto& cell : wall.sol) {
+    ASSERT_EQ(mesh->xend, cell.i.x());
+    ASSERT_EQ(cell.i.xp(), cell.guard);
+    ASSERT_EQ(cell.i.xm(), cell.inner);
+    ASSERT_EQ(1, cell.direction);
+    ASSERT_EQ(cell.i.y() == mesh->ystart, cell.pump);
+  }
+}